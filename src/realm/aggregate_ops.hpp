@@ -101,6 +101,15 @@ public:
         return false;
     }
 
+    // Returns true if the result of 'other' replaced the current result
+    bool combine(const MinMaxAggregateOperator& other)
+    {
+        if (other.m_result) {
+            return accumulate(*other.m_result);
+        }
+        return false;
+    }
+
     bool is_null() const
     {
         return !m_result;
@@ -178,6 +187,17 @@ public:
         return false;
     }
 
+    void combine(const Sum& other)
+    {
+        if constexpr (std::is_integral_v<ResultType> && std::is_signed_v<ResultType>) {
+            m_result = std::make_unsigned_t<ResultType>(m_result) + std::make_unsigned_t<ResultType>(other.m_result);
+        }
+        else {
+            m_result += other.m_result;
+        }
+        m_count += other.m_count;
+    }
+
     bool is_null() const
     {
         return false;
@@ -541,11 +541,74 @@ void Array::do_ensure_minimum_width(int_fast64_t value)
     }
 }
 
+bool Array::reduce_width() noexcept
+{
+    REALM_ASSERT_DEBUG(!is_read_only() && !m_has_refs);
+    if (get_wtype_from_header(get_header()) != wtype_Bits)
+        return false;
+
+    size_t width = 0;
+    for (size_t i = 0; i < m_size && width < m_width; ++i)
+        width = std::max(width, bit_width(get(i)));
+    if (width >= m_width)
+        return false;
+
+    // Elements are narrowed in place from the front. Element i is written at or
+    // before the position it is read from, so no unread element is overwritten.
+    Getter old_getter = m_getter;
+    set_width_in_header(width, get_header());
+    update_width_cache_from_header();
+    for (size_t i = 0; i < m_size; ++i) {
+        int64_t v = (this->*old_getter)(i);
+        (this->*(m_vtable->setter))(i, v);
+    }
+    return true;
+}
+
 int64_t Array::sum(size_t start, size_t end) const
 {
     REALM_TEMPEX(return sum, m_width, (start, end));
 }
 
+size_t Array::find_first_in_range(int64_t from, int64_t to, size_t begin, size_t end) const
+{
+    REALM_ASSERT_EX(begin <= end && end <= m_size, begin, end, m_size);
+    if (begin == end || from > to || m_ubound < from || m_lbound > to)
+        return realm::not_found;
+    // Every value that can be stored at this width is in the range
+    if (from <= m_lbound && m_ubound <= to)
+        return begin;
+    REALM_TEMPEX(return find_first_in_range, m_width, (from, to, begin, end));
+}
+
+template <size_t w>
+size_t Array::find_first_in_range(int64_t from, int64_t to, size_t begin, size_t end) const
+{
+    // from <= v <= to is the same as v - from <= to - from when computed unsigned, which
+    // turns the range check into a single comparison per element
+    const uint64_t offset = uint64_t(from);
+    const uint64_t range = uint64_t(to) - offset;
+    auto in_range = [&](size_t ndx) {
+        return uint64_t(get<w>(ndx)) - offset <= range;
+    };
+
+    // Check blocks of elements without branching on each of them, which lets the compiler
+    // vectorize the loop for the byte aligned widths
+    constexpr size_t block_size = 16;
+    for (; begin + block_size <= end; begin += block_size) {
+        bool any = false;
+        for (size_t i = 0; i < block_size; ++i)
+            any |= in_range(begin + i);
+        if (any)
+            break;
+    }
+    for (; begin < end; ++begin) {
+        if (in_range(begin))
+            return begin;
+    }
+    return realm::not_found;
+}
+
 template <size_t w>
 int64_t Array::sum(size_t start, size_t end) const
 {
@@ -265,6 +265,13 @@ public:
     /// specified value.
     void ensure_minimum_width(int_fast64_t value);
 
+    /// Re-pack the elements at the smallest width which can represent all of
+    /// them. The width of an array never decreases as elements are modified or
+    /// removed, so this reclaims the space left behind by values that needed a
+    /// wider representation. Must only be called on a writable array without
+    /// refs. Returns true if the width was reduced.
+    bool reduce_width() noexcept;
+
     /// Add \a diff to the element at the specified index.
     void adjust(size_t ndx, int_fast64_t diff);
 
@@ -381,6 +388,10 @@ public:
 
     size_t find_first(int64_t value, size_t begin = 0, size_t end = size_t(-1)) const;
 
+    /// Find the first element in [begin, end) whose value is in the closed
+    /// range [from, to]. Returns realm::not_found if there is none.
+    size_t find_first_in_range(int64_t from, int64_t to, size_t begin, size_t end) const;
+
     // Wrappers for backwards compatibility and for simple use without
     // setting up state initialization etc
     template <class cond>
@@ -479,6 +490,9 @@ private:
     template <size_t w>
     int64_t sum(size_t start, size_t end) const;
 
+    template <size_t w>
+    size_t find_first_in_range(int64_t from, int64_t to, size_t begin, size_t end) const;
+
 protected:
     /// It is an error to specify a non-zero value unless the width
     /// type is wtype_Bits. It is also an error to specify a non-zero
@@ -31,15 +31,7 @@ Mixed ArrayInteger::get_any(size_t ndx) const
 
 size_t ArrayInteger::find_first_in_range(int64_t from, int64_t to, size_t start, size_t end) const
 {
-    if (m_ubound >= from && m_lbound <= to) {
-        while (start < end) {
-            auto val = get(start);
-            if (from <= val && val <= to)
-                return start;
-            start++;
-        }
-    }
-    return realm::not_found;
+    return Array::find_first_in_range(from, to, start, end);
 }
 
 Mixed ArrayIntNull::get_any(size_t ndx) const
@@ -192,12 +184,14 @@ size_t ArrayIntNull::find_first(value_type value, size_t begin, size_t end) cons
 
 size_t ArrayIntNull::find_first_in_range(int64_t from, int64_t to, size_t start, size_t end) const
 {
-    if (m_ubound >= from && m_lbound <= to) {
-        for (size_t i = start; i < end; i++) {
-            auto val = get(i);
-            if (val && *val >= from && *val <= to)
-                return i;
-        }
+    // The elements are stored after the null value, which may itself be in the range
+    const int64_t null = null_value();
+    for (size_t ndx = start + 1; ndx < end + 1; ++ndx) {
+        ndx = Array::find_first_in_range(from, to, ndx, end + 1);
+        if (ndx == realm::not_found)
+            break;
+        if (Array::get(ndx) != null)
+            return ndx - 1;
     }
     return realm::not_found;
 }
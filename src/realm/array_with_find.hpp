@@ -48,6 +48,9 @@ Searching: The main finding function is:
 #include <emmintrin.h>             // SSE2
 #include <realm/realm_nmmintrin.h> // SSE42
 #endif
+#ifdef REALM_COMPILER_AVX
+#include <immintrin.h> // AVX2, only used in functions marked REALM_TARGET_AVX2
+#endif
 
 namespace realm {
 
@@ -131,6 +134,13 @@ public:
 
 #endif
 
+// AVX2 find for the four functions Equal/NotEqual/Less/Greater
+#ifdef REALM_COMPILER_AVX
+    template <class cond, size_t width>
+    REALM_TARGET_AVX2 bool find_avx2(int64_t value, const __m256i* data, size_t items, QueryStateBase* state,
+                                     size_t baseindex) const;
+#endif
+
     template <size_t width>
     inline bool test_zero(uint64_t value) const; // Tests value for 0-elements
 
@@ -324,6 +334,30 @@ bool ArrayWithFind::find_optimized(int64_t value, size_t start, size_t end, size
     // finder cannot handle this bitwidth
     REALM_ASSERT_3(m_array.m_width, !=, 0);
 
+#if defined(REALM_COMPILER_AVX)
+    // Use AVX2 if payload is at least one AVX chunk (256 bits) in size. Contrary to SSE, this also covers Less for
+    // 64-bit values.
+    constexpr bool avx2_cond = std::is_same_v<cond, Equal> || std::is_same_v<cond, NotEqual> ||
+                               std::is_same_v<cond, Greater> || std::is_same_v<cond, Less>;
+    if constexpr (avx2_cond && bitwidth >= 8) {
+        if (end - start2 >= sizeof(__m256i) && sseavx<2>()) {
+            // find_avx2() must start at 32-byte boundary, so search area before and after that with compare()
+            const __m256i* const a =
+                reinterpret_cast<__m256i*>(round_up(m_array.m_data + start2 * bitwidth / 8, sizeof(__m256i)));
+            const __m256i* const b =
+                reinterpret_cast<__m256i*>(round_down(m_array.m_data + end * bitwidth / 8, sizeof(__m256i)));
+            const size_t a_ndx = (reinterpret_cast<const char*>(a) - m_array.m_data) * 8 / bitwidth;
+            const size_t b_ndx = (reinterpret_cast<const char*>(b) - m_array.m_data) * 8 / bitwidth;
+
+            if (!compare<cond, bitwidth>(value, start2, a_ndx, baseindex, state))
+                return false;
+            if (b > a && !find_avx2<cond, bitwidth>(value, a, b - a, state, baseindex + a_ndx))
+                return false;
+            return compare<cond, bitwidth>(value, b_ndx, end, baseindex, state);
+        }
+    }
+#endif
+
 #if defined(REALM_COMPILER_SSE)
     // Only use SSE if payload is at least one SSE chunk (128 bits) in size. Also note taht SSE doesn't support
     // Less-than comparison for 64-bit values.
@@ -738,6 +772,76 @@ REALM_FORCEINLINE bool ArrayWithFind::find_sse_intern(__m128i* action_data, __m1
 }
 #endif // REALM_COMPILER_SSE
 
+#ifdef REALM_COMPILER_AVX
+// 'items' is the number of 32-byte AVX chunks in the aligned area starting at 'data'. Matches are reported relative
+// to the first element of the first chunk.
+template <class cond, size_t width>
+REALM_TARGET_AVX2 bool ArrayWithFind::find_avx2(int64_t value, const __m256i* data, size_t items,
+                                                QueryStateBase* state, size_t baseindex) const
+{
+    static_assert(width == 8 || width == 16 || width == 32 || width == 64);
+
+    __m256i search;
+    if constexpr (width == 8)
+        search = _mm256_set1_epi8(static_cast<char>(value));
+    else if constexpr (width == 16)
+        search = _mm256_set1_epi16(static_cast<short int>(value));
+    else if constexpr (width == 32)
+        search = _mm256_set1_epi32(static_cast<int>(value));
+    else
+        search = _mm256_set1_epi64x(value);
+
+    for (size_t i = 0; i < items; ++i) {
+        __m256i chunk = _mm256_load_si256(data + i);
+        __m256i compare_result;
+
+        if constexpr (std::is_same_v<cond, Equal> || std::is_same_v<cond, NotEqual>) {
+            if constexpr (width == 8)
+                compare_result = _mm256_cmpeq_epi8(chunk, search);
+            else if constexpr (width == 16)
+                compare_result = _mm256_cmpeq_epi16(chunk, search);
+            else if constexpr (width == 32)
+                compare_result = _mm256_cmpeq_epi32(chunk, search);
+            else
+                compare_result = _mm256_cmpeq_epi64(chunk, search);
+        }
+        else {
+            // There is only a signed greater-than comparison, so less-than is done by swapping the operands
+            constexpr bool gt = std::is_same_v<cond, Greater>;
+            __m256i lhs = gt ? chunk : search;
+            __m256i rhs = gt ? search : chunk;
+            if constexpr (width == 8)
+                compare_result = _mm256_cmpgt_epi8(lhs, rhs);
+            else if constexpr (width == 16)
+                compare_result = _mm256_cmpgt_epi16(lhs, rhs);
+            else if constexpr (width == 32)
+                compare_result = _mm256_cmpgt_epi32(lhs, rhs);
+            else
+                compare_result = _mm256_cmpgt_epi64(lhs, rhs);
+        }
+
+        // One bit per byte. 64 bits wide so that shifting past the last element below is well defined.
+        uint64_t resmask = uint32_t(_mm256_movemask_epi8(compare_result));
+
+        if constexpr (std::is_same_v<cond, NotEqual>)
+            resmask = ~resmask & 0xffffffffULL;
+
+        size_t s = i * sizeof(__m256i) * 8 / width;
+
+        while (resmask != 0) {
+            size_t idx = first_set_bit(uint32_t(resmask)) * 8 / width;
+            s += idx;
+            if (!state->match(s + baseindex))
+                return false;
+            resmask >>= (idx + 1) * width / 8;
+            ++s;
+        }
+    }
+
+    return true;
+}
+#endif // REALM_COMPILER_AVX
+
 template <class cond>
 bool ArrayWithFind::compare_leafs(const Array* foreign, size_t start, size_t end, size_t baseindex,
                                   QueryStateBase* state) const
@@ -1044,6 +1044,18 @@ void Cluster::upgrade_string_to_enum(ColKey col_key, ArrayString& keys)
     Array::destroy_deep(ref, m_alloc);
 }
 
+void Cluster::reduce_int_leaf_widths(const std::vector<ColKey>& col_keys)
+{
+    ArrayInteger leaf(m_alloc);
+    for (auto col_key : col_keys) {
+        REALM_ASSERT_DEBUG(col_key.get_type() == col_type_Int && !col_key.is_nullable() && !col_key.is_collection());
+        leaf.set_parent(this, col_key.get_index().val + s_first_col_index);
+        leaf.init_from_parent();
+        if (!leaf.is_read_only())
+            leaf.reduce_width();
+    }
+}
+
 void Cluster::init_leaf(ColKey col_key, ArrayPayload* leaf) const
 {
     auto col_ndx = col_key.get_index();
@@ -317,6 +317,9 @@ public:
 
     void init_leaf(ColKey col, ArrayPayload* leaf) const;
     void add_leaf(ColKey col, ref_type ref);
+    // Re-pack the leaves of the given integer columns which have been modified in the
+    // current transaction at the smallest width that fits their values.
+    void reduce_int_leaf_widths(const std::vector<ColKey>& col_keys);
 
     void verify() const;
     void dump_objects(int64_t key_offset, std::string lead) const override;
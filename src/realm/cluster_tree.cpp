@@ -72,7 +72,7 @@ public:
     }
 
     bool traverse(ClusterTree::TraverseFunction func, int64_t) const;
-    void update(ClusterTree::UpdateFunction func, int64_t);
+    void update(ClusterTree::UpdateFunction func, int64_t, bool only_writable = false);
 
     size_t node_size() const override
     {
@@ -708,12 +708,14 @@ bool ClusterNodeInner::traverse(ClusterTree::TraverseFunction func, int64_t key_
     return false;
 }
 
-void ClusterNodeInner::update(ClusterTree::UpdateFunction func, int64_t key_offset)
+void ClusterNodeInner::update(ClusterTree::UpdateFunction func, int64_t key_offset, bool only_writable)
 {
     auto sz = node_size();
 
     for (unsigned i = 0; i < sz; i++) {
         ref_type ref = _get_child_ref(i);
+        if (only_writable && m_alloc.is_read_only(ref))
+            continue;
         char* header = m_alloc.translate(ref);
         bool child_is_leaf = !Array::get_is_inner_bptree_node_from_header(header);
         MemRef mem(header, ref, m_alloc);
@@ -728,7 +730,7 @@ void ClusterNodeInner::update(ClusterTree::UpdateFunction func, int64_t key_offs
             ClusterNodeInner node(m_alloc, m_tree_top);
             node.init(mem);
             node.set_parent(this, i + s_first_node_index);
-            node.update(func, offs);
+            node.update(func, offs, only_writable);
         }
     }
 }
@@ -1040,6 +1042,20 @@ bool ClusterTree::traverse(TraverseFunction func) const
     }
 }
 
+bool ClusterTree::traverse(ObjKey begin, TraverseFromFunction func) const
+{
+    // Each leaf is looked up from the root, so a traversal can be resumed from
+    // any key without walking the leaves before it
+    Cluster leaf(0, get_alloc(), *this);
+    ClusterNode::IteratorState state(leaf);
+    while (get_leaf(begin, state)) {
+        if (func(&leaf, state.m_current_index) == IteratorControl::Stop)
+            return true;
+        begin = ObjKey(leaf.get_real_key(leaf.node_size() - 1).value + 1);
+    }
+    return false;
+}
+
 void ClusterTree::update(UpdateFunction func)
 {
     if (m_root->is_leaf()) {
@@ -1050,6 +1066,18 @@ void ClusterTree::update(UpdateFunction func)
     }
 }
 
+void ClusterTree::update_writable(UpdateFunction func)
+{
+    if (m_root->is_read_only())
+        return;
+    if (m_root->is_leaf()) {
+        func(static_cast<Cluster*>(m_root.get()));
+    }
+    else {
+        static_cast<ClusterNodeInner*>(m_root.get())->update(func, 0, true);
+    }
+}
+
 void ClusterTree::set_spec(ArrayPayload& arr, ColKey::Idx col_ndx) const
 {
     // Check for owner. This function may be called in context of DictionaryClusterTree
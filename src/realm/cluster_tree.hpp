@@ -31,6 +31,7 @@ class ClusterTree {
 public:
     class Iterator;
     using TraverseFunction = util::FunctionRef<IteratorControl(const Cluster*)>;
+    using TraverseFromFunction = util::FunctionRef<IteratorControl(const Cluster*, size_t)>;
     using UpdateFunction = util::FunctionRef<void(Cluster*)>;
     using ColIterateFunction = util::FunctionRef<IteratorControl(ColKey)>;
 
@@ -177,8 +178,14 @@ public:
     // Visit all leaves and call the supplied function. Stop when function returns IteratorControl::Stop.
     // Not allowed to modify the tree
     bool traverse(TraverseFunction func) const;
+    // Visit the leaves holding objects with a key not less than 'begin' in key order. The function is also given
+    // the index of the first such object in each leaf. Stop when function returns IteratorControl::Stop.
+    bool traverse(ObjKey begin, TraverseFromFunction func) const;
     // Visit all leaves and call the supplied function. The function can modify the leaf.
     void update(UpdateFunction func);
+    // Like update(), but only visit the leaves modified in the current write transaction.
+    // Subtrees still in the read-only part of the file cannot contain such leaves and are skipped.
+    void update_writable(UpdateFunction func);
 
     void set_spec(ArrayPayload& arr, ColKey::Idx col_ndx) const;
 
@@ -2491,7 +2491,7 @@ Replication::version_type DB::do_commit(Transaction& transaction, bool commit_to
         repl->finalize_commit();
     }
     else {
-        low_level_commit(new_version, transaction); // Throws
+        low_level_commit(new_version, transaction, commit_to_disk); // Throws
     }
 
     {
@@ -2546,6 +2546,10 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
     REALM_ASSERT(oldest_version <= new_version);
 
     GroupWriter out(transaction, Durability(info->durability), m_marker_observer.get()); // Throws
+    // With group commit the data is synced together with the file header once
+    // all queued writers have committed, see wait_for_group_commit()
+    if (!commit_to_disk && use_group_commit())
+        out.defer_sync();
     out.set_versions(new_version, top_refs, any_new_unreachables);
     out.prepare_evacuation();
     auto t1 = std::chrono::steady_clock::now();
@@ -2621,6 +2625,55 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
     }
 }
 
+bool DB::use_group_commit() const noexcept
+{
+    return m_group_commit && !m_commit_helper && Durability(m_info->durability) == Durability::Full;
+}
+
+void DB::wait_for_group_commit(Transaction& transaction, version_type version)
+{
+    std::unique_lock lock(m_group_commit_mutex);
+    while (m_durable_version < version) {
+        if (m_group_commit_in_progress) {
+            m_group_commit_cv.wait(lock);
+            continue;
+        }
+        // Become the leader and make the latest snapshot durable on behalf of
+        // everyone waiting. Taking the write mutex means that all writers which
+        // were queued ahead of us have committed by the time we sync. It also
+        // means that we block until then, and until any write transaction that
+        // is open in another thread or process ends.
+        m_group_commit_in_progress = true;
+        lock.unlock();
+        version_type durable_version;
+        try {
+            do_begin_write(); // Throws
+            auto end_write = util::make_scope_exit([&]() noexcept {
+                do_end_write();
+            });
+            ReadLockInfo read_lock = grab_read_lock(ReadLockInfo::Live, VersionID()); // Throws
+            ReadLockGuard g(*this, read_lock);
+            if (m_logger) {
+                m_logger->log(util::LogCategory::transaction, util::Logger::Level::trace,
+                              "Group commit of version %1 ref %2 to disk", read_lock.m_version, read_lock.m_top_ref);
+            }
+            GroupCommitter cm(transaction, Durability::Full, m_marker_observer.get());
+            cm.commit(read_lock.m_top_ref); // Throws
+            durable_version = read_lock.m_version;
+        }
+        catch (...) {
+            lock.lock();
+            m_group_commit_in_progress = false;
+            m_group_commit_cv.notify_all();
+            throw;
+        }
+        lock.lock();
+        m_group_commit_in_progress = false;
+        m_durable_version = std::max(m_durable_version, durable_version);
+        m_group_commit_cv.notify_all();
+    }
+}
+
 #ifdef REALM_DEBUG
 void DB::reserve(size_t size)
 {
@@ -2808,6 +2861,14 @@ inline DB::DB(Private, const DBOptions& options)
     if (options.enable_async_writes) {
         m_commit_helper = std::make_unique<AsyncCommitHelper>(this);
     }
+#if !defined(_WIN32) && !REALM_PLATFORM_APPLE
+    // Deferred syncs rely on a sync of the file also covering data written
+    // through memory mappings that were never synced themselves. POSIX
+    // fsync() does, but FlushFileBuffers does not guarantee it, and on Apple
+    // platforms GroupCommitter::commit() syncs the file with F_BARRIERFSYNC,
+    // which is not documented to do so.
+    m_group_commit = options.enable_group_commit;
+#endif
 }
 
 DBRef DB::create(const std::string& file, const DBOptions& options) NO_THREAD_SAFETY_ANALYSIS
@@ -508,6 +508,12 @@ private:
     util::InterprocessCondVar m_pick_next_writer;
     std::function<void(int, int)> m_upgrade_callback;
     std::unique_ptr<AsyncCommitHelper> m_commit_helper;
+    // Group commit, see DBOptions::enable_group_commit
+    bool m_group_commit = false;
+    std::mutex m_group_commit_mutex;
+    std::condition_variable m_group_commit_cv;
+    version_type m_durable_version = 0;
+    bool m_group_commit_in_progress = false;
     std::shared_ptr<util::Logger> m_logger;
     std::mutex m_commit_listener_mutex;
     std::vector<CommitListener*> m_commit_listeners;
@@ -603,6 +609,17 @@ private:
 
     void do_async_commits();
 
+    bool use_group_commit() const noexcept;
+    // Wait until the specified version (committed without syncing to disk)
+    // has been made durable, possibly by performing the sync on behalf of all
+    // writers waiting for it. Performing the sync requires the write mutex, so
+    // this blocks until the current holder of the write mutex, and everyone
+    // queued for it, has ended its write transaction. The caller must still
+    // hold the read lock it had before committing, which protects the last
+    // durable snapshot. Throws if the sync fails, after the version has been
+    // made visible.
+    void wait_for_group_commit(Transaction& transaction, version_type version) REQUIRES(!m_mutex);
+
     /// Upgrade file format and/or history schema
     void upgrade_file_format(bool allow_file_format_upgrade, int target_file_format_version,
                              int current_hist_schema_version, int target_hist_schema_version) REQUIRES(!m_mutex);
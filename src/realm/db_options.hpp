@@ -102,6 +102,28 @@ struct DBOptions {
     /// a performance impact.
     bool enable_async_writes = false;
 
+    /// If set, Transaction::commit() writes the new snapshot without syncing
+    /// it to disk, releases the write mutex and then waits until the snapshot
+    /// has been made durable. A single sync then covers the commits of all
+    /// writers in this process which were queued on the write mutex in the
+    /// meantime, which raises throughput when many threads commit small
+    /// transactions concurrently. Only has an effect with Durability::Full,
+    /// and is ignored when enable_async_writes is set, on Windows and on Apple
+    /// platforms.
+    ///
+    /// The sync is done while holding the write mutex, so commit() does not
+    /// return before every write transaction that was open or queued when it
+    /// released the write mutex, in any thread or process, has ended. A thread
+    /// must therefore not commit while holding up another thread that has a
+    /// write transaction open, as that deadlocks.
+    ///
+    /// If the sync fails, commit() throws, but the snapshot has already been
+    /// committed and is visible to other transactions. The transaction is then
+    /// left in the same state as after a successful commit, so
+    /// get_transact_stage() no longer returns DB::transact_Writing, unlike
+    /// when the commit itself failed.
+    bool enable_group_commit = false;
+
     /// If set, opening a file which is not a Realm file or cannot be decrypted
     /// will clear and reinitialize the file.
     bool clear_on_invalid_file = false;
@@ -70,7 +70,7 @@ private:
 class WriteWindowMgr::MapWindow {
 public:
     MapWindow(size_t alignment, util::File& f, ref_type start_ref, size_t initial_size,
-              util::WriteMarker* write_marker = nullptr);
+              util::WriteMarker* write_marker = nullptr, bool defer_sync = false);
     ~MapWindow();
 
     // translate a ref to a pointer
@@ -95,6 +95,7 @@ private:
     ref_type aligned_to_mmap_block(ref_type start_ref);
     size_t get_window_size(util::File& f, ref_type start_ref, size_t size);
     size_t m_alignment;
+    bool m_defer_sync;
 };
 
 // True if a requested block fall within a memory mapping.
@@ -149,15 +150,19 @@ bool WriteWindowMgr::MapWindow::extends_to_match(util::File& f, ref_type start_r
     if (aligned_ref != m_base_ref)
         return false;
     size_t window_size = get_window_size(f, start_ref, size);
-    m_map.sync();
+    if (m_defer_sync)
+        m_map.flush();
+    else
+        m_map.sync();
     m_map.unmap();
     m_map.map(f, File::access_ReadWrite, window_size, m_base_ref);
     return true;
 }
 
 WriteWindowMgr::MapWindow::MapWindow(size_t alignment, util::File& f, ref_type start_ref, size_t size,
-                                     util::WriteMarker* write_marker)
+                                     util::WriteMarker* write_marker, bool defer_sync)
     : m_alignment(alignment)
+    , m_defer_sync(defer_sync)
 {
     m_base_ref = aligned_to_mmap_block(start_ref);
     size_t window_size = get_window_size(f, start_ref, size);
@@ -172,7 +177,10 @@ WriteWindowMgr::MapWindow::MapWindow(size_t alignment, util::File& f, ref_type s
 
 WriteWindowMgr::MapWindow::~MapWindow()
 {
-    m_map.sync();
+    if (m_defer_sync)
+        m_map.flush();
+    else
+        m_map.sync();
     m_map.unmap();
 }
 
@@ -337,7 +345,10 @@ void WriteWindowMgr::sync_all_mappings()
     if (m_durability == Durability::Unsafe)
         return;
     for (const auto& window : m_map_windows) {
-        window->sync();
+        if (m_defer_sync)
+            window->flush();
+        else
+            window->sync();
     }
 }
 
@@ -360,8 +371,8 @@ WriteWindowMgr::MapWindow* WriteWindowMgr::get_window(ref_type start_ref, size_t
         m_map_windows.back()->flush();
         m_map_windows.pop_back();
     }
-    auto new_window =
-        std::make_unique<MapWindow>(m_window_alignment, m_alloc.get_file(), start_ref, size, m_write_marker);
+    auto new_window = std::make_unique<MapWindow>(m_window_alignment, m_alloc.get_file(), start_ref, size,
+                                                  m_write_marker, m_defer_sync);
     m_map_windows.insert(m_map_windows.begin(), std::move(new_window));
     return m_map_windows[0].get();
 }
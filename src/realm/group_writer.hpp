@@ -69,6 +69,13 @@ public:
     void sync_all_mappings();
     // Flush all cached memory mappings from private to shared cache.
     void flush_all_mappings();
+    // Only flush, never sync, the written mappings. The caller must ensure
+    // that the file is synced before the written data is referenced from
+    // the file header.
+    void defer_sync() noexcept
+    {
+        m_defer_sync = true;
+    }
     class MapWindow;
     // Get a suitable memory mapping for later access:
     // potentially adding it to the cache, potentially closing
@@ -88,6 +95,7 @@ protected:
     std::vector<std::unique_ptr<MapWindow>> m_map_windows;
     size_t m_window_alignment;
     util::WriteMarker* m_write_marker = nullptr;
+    bool m_defer_sync = false;
 };
 
 class GroupCommitter {
@@ -197,6 +205,11 @@ public:
         }
     }
     void sync_according_to_durability();
+    // Leave syncing the written data to a later GroupCommitter::commit()
+    void defer_sync() noexcept
+    {
+        m_window_mgr.defer_sync();
+    }
 
 private:
     friend class InMemoryWriter;
@@ -108,6 +108,11 @@ struct CollectionChangeSet {
 
     std::set<StableIndex> paths;
 
+    // This flag indicates that the changes of a commit made while the notification
+    // was suppressed (see NotificationToken::suppress_next()) are left out, so that
+    // this does not describe every change since the previous notification.
+    bool omits_suppressed_changes = false;
+
     bool empty() const noexcept
     {
         return deletions.empty() && insertions.empty() && modifications.empty() && modifications_new.empty() &&
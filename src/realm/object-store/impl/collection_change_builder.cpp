@@ -44,10 +44,14 @@ CollectionChangeBuilder::CollectionChangeBuilder(IndexSet deletions, IndexSet in
 
 void CollectionChangeBuilder::merge(CollectionChangeBuilder&& c)
 {
-    if (c.empty())
+    bool omitted_changes = omits_suppressed_changes || c.omits_suppressed_changes;
+    if (c.empty()) {
+        omits_suppressed_changes = omitted_changes;
         return;
+    }
     if (empty()) {
         *this = std::move(c);
+        omits_suppressed_changes = omitted_changes;
         return;
     }
 
@@ -149,6 +153,7 @@ void CollectionChangeBuilder::merge(CollectionChangeBuilder&& c)
         collection_root_was_deleted = true;
     }
     collection_was_cleared = c.collection_was_cleared;
+    omits_suppressed_changes = omitted_changes;
     c = {};
     verify();
 }
@@ -549,6 +554,75 @@ void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& cha
     }
 }
 
+// Calculates the insertions and deletions needed to reorder `rows` when no key
+// appears more than once. The rows which can stay where they are form the
+// longest increasing subsequence of their previous TV indices, which is found
+// in O(N log N) time with a Fenwick tree holding the best subsequence ending at
+// or before each previous TV index. Of two equally long subsequences, the one
+// with more unmodified rows is kept so that the modified rows are the ones
+// reported as having moved.
+void calculate_moves_unique(std::vector<RowInfo>& rows, CollectionChangeSet& changeset)
+{
+    auto by_prev_tv_index = [](auto& lft, auto& rgt) {
+        return lft.prev_tv_index < rgt.prev_tv_index;
+    };
+    // `rows` is sorted by tv_index, so if the previous indices are increasing
+    // as well nothing was reordered
+    if (std::is_sorted(begin(rows), end(rows), by_prev_tv_index))
+        return;
+
+    struct Subsequence {
+        size_t length;
+        size_t unmodified;
+        // The index in `rows` of the last row in this subsequence
+        size_t last;
+
+        bool operator<(const Subsequence& other) const
+        {
+            return std::tie(length, unmodified, last) < std::tie(other.length, other.unmodified, other.last);
+        }
+    };
+
+    auto [min_it, max_it] = std::minmax_element(begin(rows), end(rows), by_prev_tv_index);
+    size_t min_prev = min_it->prev_tv_index;
+    std::vector<Subsequence> tree(max_it->prev_tv_index - min_prev + 2, {0, 0, IndexSet::npos});
+    std::vector<size_t> predecessor(rows.size());
+
+    Subsequence best = {0, 0, IndexSet::npos};
+    for (size_t i = 0; i < rows.size(); ++i) {
+        size_t pos = rows[i].prev_tv_index - min_prev;
+        Subsequence prefix = {0, 0, IndexSet::npos};
+        for (size_t k = pos; k > 0; k &= k - 1) {
+            if (prefix < tree[k])
+                prefix = tree[k];
+        }
+        predecessor[i] = prefix.last;
+        bool modified = changeset.modifications.contains(rows[i].tv_index);
+        Subsequence current = {prefix.length + 1, prefix.unmodified + !modified, i};
+        for (size_t k = pos + 1; k < tree.size(); k += k & (~k + 1)) {
+            if (tree[k] < current)
+                tree[k] = current;
+        }
+        if (best < current)
+            best = current;
+    }
+
+    std::vector<bool> kept(rows.size());
+    for (size_t i = best.last; i != IndexSet::npos; i = predecessor[i])
+        kept[i] = true;
+
+    std::vector<size_t> deletions;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (!kept[i]) {
+            deletions.push_back(rows[i].prev_tv_index);
+            changeset.insertions.add(rows[i].tv_index);
+        }
+    }
+    std::sort(begin(deletions), end(deletions));
+    for (auto i : deletions)
+        changeset.deletions.add(i);
+}
+
 template <typename T>
 void verify_changeset(std::vector<T> const& prev_rows, std::vector<T> const& next_rows,
                       CollectionChangeBuilder const& changeset)
@@ -581,12 +655,16 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
     // Now that our old and new sets of rows are sorted by key, we can
     // iterate over them and either record old+new TV indices for rows present
     // in both, or mark them as inserted/deleted if they appear only in one
+    bool unique_keys = true;
     size_t i = 0, j = 0;
     while (i < old_rows.size() && j < new_rows.size()) {
         auto old_index = old_rows[i];
         auto& new_index = new_rows[j];
         if (old_index.key == new_index.key) {
             new_index.prev_tv_index = old_rows[i].tv_index;
+            if ((i > 0 && old_rows[i - 1].key == old_index.key) ||
+                (j > 0 && new_rows[j - 1].key == new_index.key))
+                unique_keys = false;
             ++i;
             ++j;
         }
@@ -622,7 +700,12 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
         }
     }
 
-    if (!in_table_order)
+    if (in_table_order)
+        return;
+    // Duplicates need the more general (and much slower) LCS calculation
+    if (unique_keys)
+        calculate_moves_unique(new_rows, ret);
+    else
         calculate_moves_sorted(new_rows, ret);
 }
 
@@ -646,11 +729,12 @@ void sort_row_info(std::vector<RowInfo>& info)
 }
 
 template <typename T>
-std::vector<RowInfo> build_row_info(const std::vector<T>& rows)
+std::vector<RowInfo> build_row_info(const std::vector<T>& rows, size_t begin = 0, size_t end = -1)
 {
+    end = std::min(end, rows.size());
     std::vector<RowInfo> info;
-    info.reserve(rows.size());
-    for (size_t i = 0; i < rows.size(); ++i)
+    info.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
         info.push_back({to_int64_t(rows[i]), IndexSet::npos, i});
     sort_row_info(info);
     return info;
@@ -663,12 +747,35 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_o
                                                            bool in_table_order)
 {
     CollectionChangeBuilder ret;
+
+    // Objects which are at the same position from the start or the end of both
+    // are neither inserted, deleted nor moved, so only the part in between has
+    // to be diffed. For results which are unchanged or only had objects added at
+    // the end this skips all of the sorting and matching below.
+    size_t common_size = std::min(prev_objs.size(), next_objs.size());
+    size_t prefix = 0;
+    while (prefix < common_size && prev_objs[prefix] == next_objs[prefix])
+        ++prefix;
+    size_t suffix = 0;
+    while (suffix < common_size - prefix &&
+           prev_objs[prev_objs.size() - suffix - 1] == next_objs[next_objs.size() - suffix - 1])
+        ++suffix;
+
+    for (size_t i = 0; i < prefix; ++i) {
+        if (key_did_change(next_objs[i]))
+            ret.modifications.add(i);
+    }
     ::calculate(
-        ret, build_row_info(prev_objs), build_row_info(next_objs),
+        ret, build_row_info(prev_objs, prefix, prev_objs.size() - suffix),
+        build_row_info(next_objs, prefix, next_objs.size() - suffix),
         [&key_did_change](int64_t key) {
             return key_did_change(ObjKey(key));
         },
         in_table_order);
+    for (size_t i = next_objs.size() - suffix; i < next_objs.size(); ++i) {
+        if (key_did_change(next_objs[i]))
+            ret.modifications.add(i);
+    }
     ret.verify();
     verify_changeset(prev_objs, next_objs, ret);
     return ret;
@@ -704,5 +811,6 @@ CollectionChangeSet CollectionChangeBuilder::finalize() &&
 
     return {std::move(deletions),     std::move(insertions), std::move(modifications_in_old),
             std::move(modifications), std::move(moves),      collection_root_was_deleted,
-            collection_was_cleared,   std::move(columns)};
+            collection_was_cleared,   std::move(columns),    {},
+            omits_suppressed_changes};
 }
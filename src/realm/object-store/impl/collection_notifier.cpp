@@ -462,6 +462,25 @@ void CollectionNotifier::attach_to(std::shared_ptr<Transaction> tr)
     reattach();
 }
 
+void CollectionNotifier::run_frozen(const std::shared_ptr<Transaction>& frozen)
+{
+    REALM_ASSERT(frozen->is_frozen());
+    REALM_ASSERT(frozen->get_version_of_current_transaction() == version());
+    std::shared_ptr<Transaction> transaction = frozen;
+    m_transaction.swap(transaction);
+    try {
+        reattach();
+        run();
+    }
+    catch (...) {
+        m_transaction.swap(transaction);
+        reattach();
+        throw;
+    }
+    m_transaction.swap(transaction);
+    reattach();
+}
+
 Transaction& CollectionNotifier::source_shared_group()
 {
     return Realm::Internal::get_transaction(*m_realm);
@@ -484,6 +503,7 @@ void CollectionNotifier::add_changes(CollectionChangeBuilder change)
             // skipped, so if we already have some changes something went wrong.
             REALM_ASSERT_DEBUG(callback.accumulated_changes.empty());
             callback.skip_next = false;
+            callback.accumulated_changes.omits_suppressed_changes = true;
         }
         else {
             // Only copy the changeset if there's more callbacks that need it
@@ -171,6 +171,19 @@ public:
     // precondition: RealmCoordinator::m_notifier_mutex is unlocked
     virtual void run() = 0;
 
+    // Same as run(), but reads from the given frozen copy of the notifier's
+    // Transaction, so that several notifiers can run concurrently. The
+    // notifier is attached to its own Transaction again before returning.
+    // precondition: RealmCoordinator::m_notifier_mutex is unlocked
+    void run_frozen(const std::shared_ptr<Transaction>& frozen);
+
+    // Called before run_frozen() while the notifier is still attached to its
+    // own Transaction. Content versions read through a frozen copy can't be
+    // compared with those read in earlier runs, so notifiers which compare
+    // them read them here instead.
+    // precondition: RealmCoordinator::m_notifier_mutex is unlocked
+    virtual void prepare_to_run_frozen() {}
+
     // precondition: RealmCoordinator::m_notifier_mutex is locked
     void prepare_handover() REQUIRES(!m_callback_mutex);
 
@@ -34,6 +34,73 @@ void sort_and_unique(T& container)
 }
 } // namespace
 
+std::unique_lock<std::mutex> DeepChangeCache::lock()
+{
+    if (!m_concurrent)
+        return {};
+    return std::unique_lock(m_mutex);
+}
+
+util::Optional<bool> DeepChangeCache::find_modified(TableKey table_key, ObjKey object_key, size_t max_links)
+{
+    auto guard = lock();
+    auto table_it = m_results.find(table_key);
+    if (table_it == m_results.end())
+        return util::none;
+    auto it = table_it->second.find(object_key);
+    if (it == table_it->second.end())
+        return util::none;
+    if (it->second.modified_within <= max_links)
+        return true;
+    if (it->second.unmodified_within >= max_links)
+        return false;
+    return util::none;
+}
+
+void DeepChangeCache::add_modified(TableKey table_key, ObjKey object_key, size_t links)
+{
+    auto guard = lock();
+    auto& result = m_results[table_key][object_key];
+    result.modified_within = std::min(result.modified_within, links);
+}
+
+void DeepChangeCache::add_not_modified(TableKey table_key, ObjKey object_key, size_t links)
+{
+    auto guard = lock();
+    auto& result = m_results[table_key][object_key];
+    result.unmodified_within = std::max(result.unmodified_within, links);
+}
+
+size_t DeepChangeCache::get_key_path_id(const KeyPath& key_path, size_t depth)
+{
+    auto guard = lock();
+    auto [it, inserted] =
+        m_key_path_ids.emplace(KeyPath(key_path.begin() + depth, key_path.end()), m_key_path_changed.size());
+    if (inserted)
+        m_key_path_changed.emplace_back();
+    return it->second;
+}
+
+util::Optional<bool> DeepChangeCache::find_key_path_changed(size_t key_path_id, TableKey table_key,
+                                                            ObjKey object_key)
+{
+    auto guard = lock();
+    auto& results = m_key_path_changed[key_path_id];
+    auto table_it = results.find(table_key);
+    if (table_it == results.end())
+        return util::none;
+    auto it = table_it->second.find(object_key);
+    if (it == table_it->second.end())
+        return util::none;
+    return it->second;
+}
+
+void DeepChangeCache::add_key_path_changed(size_t key_path_id, TableKey table_key, ObjKey object_key, bool changed)
+{
+    auto guard = lock();
+    m_key_path_changed[key_path_id][table_key][object_key] = changed;
+}
+
 void DeepChangeChecker::find_related_tables(std::vector<RelatedTable>& related_tables, Table const& table,
                                             const KeyPathArray& key_path_array)
 {
@@ -155,6 +222,10 @@ DeepChangeChecker::DeepChangeChecker(TransactionChangeInfo const& info, Table co
             }
         }
     }
+    // Without filtered columns the result of checking an object depends only
+    // on the changes and not on the notifier, so it can be shared
+    if (m_filtered_columns.empty())
+        m_shared_cache = info.deep_change_cache.get();
 }
 
 bool DeepChangeChecker::do_check_mixed_for_link(Group& group, TableRef& cached_linked_table, Mixed value,
@@ -327,18 +398,32 @@ bool DeepChangeChecker::check_row(Table const& table, ObjKey object_key, const s
         return false;
     }
 
-    // We may have already performed deep checking on this object and discovered
-    // that it is not possible to reach a modified object from it.
-    auto& not_modified = m_not_modified[table_key];
-    auto it = not_modified.find(object_key);
-    if (it != not_modified.end())
+    // We (or another notifier) may have already performed deep checking on
+    // this object and discovered whether it is possible to reach a modified
+    // object from it.
+    size_t max_links = m_current_path.size() - depth - 1;
+    if (m_shared_cache) {
+        if (auto modified = m_shared_cache->find_modified(table_key, object_key, max_links))
+            return *modified;
+    }
+    else if (m_not_modified[table_key].count(object_key)) {
         return false;
+    }
 
     bool ret = check_outgoing_links(table, ObjKey(object_key), filtered_columns, depth);
+    if (ret) {
+        if (m_shared_cache)
+            m_shared_cache->add_modified(table_key, object_key, max_links);
+    }
     // If this object isn't modified and we didn't exceed the maximum search depth,
-    // cache that result to avoid having to repeat it.
-    if (!ret && (depth == 0 || !m_current_path[depth - 1].depth_exceeded))
-        not_modified.insert(object_key);
+    // cache that result to avoid having to repeat it. A search from the root
+    // can't be cut short by a cycle, but only covers `max_links`.
+    else if (depth == 0 || !m_current_path[depth - 1].depth_exceeded) {
+        if (m_shared_cache)
+            m_shared_cache->add_not_modified(table_key, object_key, depth == 0 ? max_links : IndexSet::npos);
+        else
+            m_not_modified[table_key].insert(object_key);
+    }
     return ret;
 }
 
@@ -369,6 +454,15 @@ CollectionKeyPathChangeChecker::CollectionKeyPathChangeChecker(TransactionChange
                                                                bool all_callbacks_filtered)
     : DeepChangeChecker(info, root_table, related_tables, key_path_array, all_callbacks_filtered)
 {
+    if (auto cache = info.deep_change_cache.get()) {
+        m_key_path_ids.reserve(key_path_array.size());
+        for (auto& key_path : key_path_array) {
+            auto& ids = m_key_path_ids.emplace_back();
+            ids.reserve(key_path.size());
+            for (size_t depth = 0; depth < key_path.size(); ++depth)
+                ids.push_back(cache->get_key_path_id(key_path, depth));
+        }
+    }
 }
 
 bool CollectionKeyPathChangeChecker::operator()(ObjKey object_key)
@@ -381,59 +475,81 @@ bool CollectionKeyPathChangeChecker::operator()(ObjKey object_key)
         return false;
     }
 
-    for (auto& key_path : m_key_path_array) {
-        find_changed_columns(changed_columns, key_path, 0, m_root_table, object_key);
+    for (size_t i = 0; i < m_key_path_array.size(); ++i) {
+        find_changed_columns(changed_columns, i, m_root_table, object_key);
     }
 
     return changed_columns.size() > 0;
 }
 
-void CollectionKeyPathChangeChecker::find_changed_columns(std::vector<ColKey>& changed_columns,
-                                                          const KeyPath& key_path, size_t depth, const Table& table,
-                                                          const ObjKey& object_key)
+void CollectionKeyPathChangeChecker::find_changed_columns(std::vector<ColKey>& changed_columns, size_t key_path_ndx,
+                                                          const Table& table, const ObjKey& object_key)
+{
+    // If an object linked to the root object was changed we only mark the
+    // property of the root objects as changed.
+    if (key_path_changed(key_path_ndx, 0, table, object_key))
+        changed_columns.push_back(m_key_path_array[key_path_ndx][0].second);
+}
+
+bool CollectionKeyPathChangeChecker::key_path_changed(size_t key_path_ndx, size_t depth, const Table& table,
+                                                      const ObjKey& object_key)
 {
     REALM_ASSERT(!object_key.is_unresolved());
 
-    if (depth >= key_path.size()) {
+    if (depth >= m_key_path_array[key_path_ndx].size()) {
         // We've reached the end of the key path.
-        return;
+        return false;
     }
 
+    // Key paths shared by several notifiers often lead to the same objects, so
+    // the result for each object and remaining key path is cached
+    if (m_key_path_ids.empty())
+        return do_key_path_changed(key_path_ndx, depth, table, object_key);
+    auto& cache = *m_info.deep_change_cache;
+    size_t key_path_id = m_key_path_ids[key_path_ndx][depth];
+    if (auto changed = cache.find_key_path_changed(key_path_id, table.get_key(), object_key))
+        return *changed;
+    bool changed = do_key_path_changed(key_path_ndx, depth, table, object_key);
+    cache.add_key_path_changed(key_path_id, table.get_key(), object_key, changed);
+    return changed;
+}
+
+bool CollectionKeyPathChangeChecker::do_key_path_changed(size_t key_path_ndx, size_t depth, const Table& table,
+                                                         const ObjKey& object_key)
+{
+    auto& key_path = m_key_path_array[key_path_ndx];
     auto [table_key, column_key] = key_path.at(depth);
 
     // Check for a change on the current depth level.
     auto iterator = m_info.tables.find(table_key);
     if (iterator != m_info.tables.end()) {
         auto& changes = iterator->second;
-        if (changes.modifications_contains(object_key, {column_key}) || changes.insertions_contains(object_key)) {
-            // If an object linked to the root object was changed we only mark the
-            // property of the root objects as changed.
-            // This is also the reason why we can return right after doing so because we would only mark the same root
-            // property again in case we find another change deeper down the same path.
-            auto root_column_key = key_path[0].second;
-            changed_columns.push_back(root_column_key);
-            return;
-        }
+        // We can return right after finding a change because we would only mark
+        // the same root property again in case we find another change deeper
+        // down the same path.
+        if (changes.modifications_contains(object_key, {column_key}) || changes.insertions_contains(object_key))
+            return true;
     }
 
     // Only continue for any kind of link.
     auto column_type = column_key.get_type();
     if (column_type != col_type_Link && column_type != col_type_BackLink && column_type != col_type_TypedLink &&
         column_type != col_type_Mixed) {
-        return;
+        return false;
     }
 
     auto check_mixed_object = [&](const Mixed& mixed_object) {
         if (mixed_object.is_type(type_Link, type_TypedLink)) {
             auto object_key = mixed_object.get<ObjKey>();
             if (object_key.is_unresolved()) {
-                return;
+                return false;
             }
             auto target_table_key = mixed_object.get_link().get_table_key();
             Group* group = table.get_parent_group();
             auto target_table = group->get_table(target_table_key);
-            find_changed_columns(changed_columns, key_path, depth, *target_table, object_key);
+            return key_path_changed(key_path_ndx, depth, *target_table, object_key);
         }
+        return false;
     };
 
     // Advance one level deeper into the key path.
@@ -443,8 +559,8 @@ void CollectionKeyPathChangeChecker::find_changed_columns(std::vector<ColKey>& c
         if (column_type == col_type_Mixed) {
             auto list = object.get_list<Mixed>(column_key);
             for (size_t i = 0; i < list.size(); i++) {
-                auto target_object = list.get_any(i);
-                check_mixed_object(target_object);
+                if (check_mixed_object(list.get_any(i)))
+                    return true;
             }
         }
         else {
@@ -452,47 +568,46 @@ void CollectionKeyPathChangeChecker::find_changed_columns(std::vector<ColKey>& c
             auto list = object.get_linklist(column_key);
             auto target_table = table.get_link_target(column_key);
             for (size_t i = 0; i < list.size(); i++) {
-                auto target_object = list.get(i);
-                find_changed_columns(changed_columns, key_path, depth, *target_table, target_object);
+                if (key_path_changed(key_path_ndx, depth, *target_table, list.get(i)))
+                    return true;
             }
         }
+        return false;
     }
-    else if (column_key.is_set()) {
+    if (column_key.is_set()) {
         if (column_type == col_type_Mixed) {
             auto set = object.get_set<Mixed>(column_key);
-            for (auto& mixed_val : set) {
-                check_mixed_object(mixed_val);
-            }
-        }
-        else {
-            REALM_ASSERT(column_type == col_type_Link);
-            auto set = object.get_linkset(column_key);
-            auto target_table = table.get_link_target(column_key);
-            for (auto& target_object : set) {
-                find_changed_columns(changed_columns, key_path, depth, *target_table, target_object);
-            }
+            return std::any_of(set.begin(), set.end(), check_mixed_object);
         }
+        REALM_ASSERT(column_type == col_type_Link);
+        auto set = object.get_linkset(column_key);
+        auto target_table = table.get_link_target(column_key);
+        return std::any_of(set.begin(), set.end(), [&](ObjKey target_object) {
+            return key_path_changed(key_path_ndx, depth, *target_table, target_object);
+        });
     }
-    else if (column_key.is_dictionary()) {
+    if (column_key.is_dictionary()) {
         // a dictionary always stores mixed values
         auto dictionary = object.get_dictionary(column_key);
+        bool changed = false;
         dictionary.for_all_values([&](Mixed val) {
-            check_mixed_object(val);
+            changed = changed || check_mixed_object(val);
         });
+        return changed;
     }
-    else if (column_type == col_type_Mixed) {
-        check_mixed_object(object.get_any(column_key));
+    if (column_type == col_type_Mixed) {
+        return check_mixed_object(object.get_any(column_key));
     }
-    else if (column_type == col_type_Link) {
+    if (column_type == col_type_Link) {
         // A forward link will only have one target object.
         auto target_object = object.get<ObjKey>(column_key);
         if (!target_object || target_object.is_unresolved()) {
-            return;
+            return false;
         }
         auto target_table = table.get_link_target(column_key);
-        find_changed_columns(changed_columns, key_path, depth, *target_table, target_object);
+        return key_path_changed(key_path_ndx, depth, *target_table, target_object);
     }
-    else if (column_type == col_type_BackLink) {
+    if (column_type == col_type_BackLink) {
         // A backlink can have multiple origin objects. We need to iterate over all of them.
         auto origin_table = table.get_opposite_table(column_key);
         auto origin_column_key = table.get_opposite_column(column_key);
@@ -508,19 +623,17 @@ void CollectionKeyPathChangeChecker::find_changed_columns(std::vector<ColKey>& c
                     auto& changes = iterator->second;
                     if (changes.modifications_contains(origin_object, {origin_column_key}) ||
                         changes.insertions_contains(origin_object)) {
-                        ColKey root_column_key = key_path[0].second;
-                        changed_columns.push_back(root_column_key);
+                        return true;
                     }
                 }
             }
-            else {
-                find_changed_columns(changed_columns, key_path, depth, *origin_table, origin_object);
+            else if (key_path_changed(key_path_ndx, depth, *origin_table, origin_object)) {
+                return true;
             }
         }
+        return false;
     }
-    else {
-        REALM_UNREACHABLE(); // unhandled column type
-    }
+    REALM_UNREACHABLE(); // unhandled column type
 }
 
 ObjectKeyPathChangeChecker::ObjectKeyPathChangeChecker(TransactionChangeInfo const& info, Table const& root_table,
@@ -535,8 +648,8 @@ std::vector<ColKey> ObjectKeyPathChangeChecker::operator()(ObjKey object_key)
 {
     std::vector<ColKey> changed_columns;
 
-    for (auto& key_path : m_key_path_array) {
-        find_changed_columns(changed_columns, key_path, 0, m_root_table, object_key);
+    for (size_t i = 0; i < m_key_path_array.size(); ++i) {
+        find_changed_columns(changed_columns, i, m_root_table, object_key);
     }
 
     return changed_columns;
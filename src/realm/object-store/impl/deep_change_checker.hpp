@@ -22,8 +22,12 @@
 #include <realm/object-store/object_changeset.hpp>
 #include <realm/object-store/impl/collection_change_builder.hpp>
 #include <realm/collection_parent.hpp>
+#include <realm/util/optional.hpp>
 
 #include <array>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace realm {
 class CollectionBase;
@@ -46,10 +50,76 @@ struct CollectionChangeInfo {
     CollectionChangeBuilder* changes;
 };
 
+/**
+ * The `DeepChangeCache` holds the results of searches for modified objects which do not depend on the notifier
+ * performing them, so that notifiers observing objects which link to the same objects do not all have to follow
+ * those links again. It belongs to a `TransactionChangeInfo` and so is only valid for the changes recorded there.
+ * Access is only guarded by a mutex once `enable_concurrent_access()` has been called.
+ */
+class DeepChangeCache {
+public:
+    // To be called before notifiers using this cache run concurrently.
+    void enable_concurrent_access() noexcept
+    {
+        m_concurrent = true;
+    }
+    bool concurrent_access_enabled() const noexcept
+    {
+        return m_concurrent;
+    }
+
+    /**
+     * Look up whether a modified object can be reached from the object identified by `object_key` by following at
+     * most `max_links` links, not counting the object itself.
+     *
+     * @return The cached result, or none if it is not known.
+     */
+    util::Optional<bool> find_modified(TableKey table_key, ObjKey object_key, size_t max_links);
+
+    // Record that a modified object can be reached from the object by following at most `links` links.
+    void add_modified(TableKey table_key, ObjKey object_key, size_t links);
+    // Record that no modified object can be reached from the object by following up to `links` links, or at all
+    // if `links` is npos.
+    void add_not_modified(TableKey table_key, ObjKey object_key, size_t links);
+
+    /**
+     * Get an identifier for the part of `key_path` starting at `depth`, which is the same for equal key paths in
+     * all notifiers.
+     */
+    size_t get_key_path_id(const KeyPath& key_path, size_t depth);
+
+    /**
+     * Look up whether a change was found by following the key path identified by `key_path_id` from the given
+     * object.
+     *
+     * @return The cached result, or none if it is not known.
+     */
+    util::Optional<bool> find_key_path_changed(size_t key_path_id, TableKey table_key, ObjKey object_key);
+    void add_key_path_changed(size_t key_path_id, TableKey table_key, ObjKey object_key, bool changed);
+
+private:
+    struct Result {
+        // A modified object can be reached by following at most this many links, or npos if none has been found
+        size_t modified_within = -1;
+        // No modified object can be reached by following this many links, or any number of links if npos
+        size_t unmodified_within = 0;
+    };
+
+    std::mutex m_mutex;
+    bool m_concurrent = false;
+    std::unordered_map<TableKey, std::unordered_map<ObjKey, Result>> m_results;
+    std::map<KeyPath, size_t> m_key_path_ids;
+    std::vector<std::unordered_map<TableKey, std::unordered_map<ObjKey, bool>>> m_key_path_changed;
+
+    std::unique_lock<std::mutex> lock();
+};
+
 struct TransactionChangeInfo {
     std::vector<CollectionChangeInfo> collections;
     std::unordered_map<TableKey, ObjectChangeSet> tables;
     bool schema_changed = false;
+    // Shared by the modification checkers of all notifiers using this change info
+    std::unique_ptr<DeepChangeCache> deep_change_cache = std::make_unique<DeepChangeCache>();
 };
 
 /**
@@ -149,6 +219,9 @@ protected:
 private:
     RelatedTables const& m_related_tables;
 
+    // Results which are valid for every unfiltered checker are stored in the
+    // cache of the change info. Null if this checker filters on columns.
+    DeepChangeCache* m_shared_cache = nullptr;
     std::unordered_map<TableKey, std::unordered_set<ObjKey>> m_not_modified;
 
     struct Path {
@@ -219,18 +292,34 @@ public:
 private:
     friend class ObjectKeyPathChangeChecker;
 
+    // The `DeepChangeCache::get_key_path_id()` for each depth of each key path in `m_key_path_array`.
+    std::vector<std::vector<size_t>> m_key_path_ids;
+
     /**
      * Traverses down a given `KeyPath` and checks the objects along the way for changes.
      *
      * @param changed_columns The list of `ColKeyType`s that was changed in the root object.
      *                        A key will be added to this list if it turns out to be changed.
-     * @param key_path The `KeyPath` used to traverse the given object with.
+     * @param key_path_ndx The index of the `KeyPath` in `m_key_path_array` used to traverse the given object with.
+     * @param table The root `Table`.
+     * @param object_key_value The `ObjKeyType` that is to be checked for changes.
+     */
+    void find_changed_columns(std::vector<ColKey>& changed_columns, size_t key_path_ndx, const Table& table,
+                              const ObjKey& object_key_value);
+
+    /**
+     * Check if following the `KeyPath` at `key_path_ndx` in `m_key_path_array` from the given object, starting at
+     * `depth`, reaches a change.
+     *
+     * @param key_path_ndx The index of the `KeyPath` in `m_key_path_array`.
      * @param depth The current depth in the key_path.
-     * @param table The `TableKey` for the current depth.
+     * @param table The `Table` for the current depth.
      * @param object_key_value The `ObjKeyType` that is to be checked for changes.
+     *
+     * @return True if a change was found, false otherwise.
      */
-    void find_changed_columns(std::vector<ColKey>& changed_columns, const KeyPath& key_path, size_t depth,
-                              const Table& table, const ObjKey& object_key_value);
+    bool key_path_changed(size_t key_path_ndx, size_t depth, const Table& table, const ObjKey& object_key_value);
+    bool do_key_path_changed(size_t key_path_ndx, size_t depth, const Table& table, const ObjKey& object_key_value);
 };
 
 /**
@@ -52,8 +52,9 @@ void ListNotifier::release_data() noexcept
 
 void ListNotifier::reattach()
 {
-    REALM_ASSERT(m_list);
-    attach(*m_list);
+    // m_list is null once the list has been found to be deleted
+    if (m_list)
+        attach(*m_list);
 }
 
 void ListNotifier::attach(CollectionBase const& src)
@@ -38,8 +38,9 @@ ObjectNotifier::ObjectNotifier(std::shared_ptr<Realm> realm, const Obj& obj)
 
 void ObjectNotifier::reattach()
 {
-    REALM_ASSERT(m_table);
-    m_table = transaction().get_table(m_table->get_key());
+    // m_table is null once the object has been found to be deleted
+    if (m_table)
+        m_table = transaction().get_table(m_table->get_key());
 }
 
 bool ObjectNotifier::do_add_required_change_info(TransactionChangeInfo& info)
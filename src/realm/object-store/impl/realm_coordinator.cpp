@@ -44,14 +44,148 @@
 #include <realm/history.hpp>
 #include <realm/string_data.hpp>
 #include <realm/util/fifo_helper.hpp>
+#include <realm/util/function_ref.hpp>
 #include <realm/sync/config.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <thread>
 #include <unordered_map>
 
 using namespace realm;
 using namespace realm::_impl;
 
+namespace realm::_impl {
+
+// A pool of threads which together with the calling thread run a batch of
+// independent jobs and wait for all of them to finish. The threads are started
+// on first use and kept until the pool is destroyed.
+class NotifierWorkerPool {
+public:
+    NotifierWorkerPool(size_t num_threads)
+        : m_num_threads(num_threads)
+    {
+    }
+
+    ~NotifierWorkerPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_work_cond.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    // The number of distinct values of the `worker` argument passed to the
+    // job function by run().
+    size_t num_workers() const noexcept
+    {
+        return m_num_threads + 1;
+    }
+
+    // Call `fn(worker, i)` for each `i` in [0, count). Each call is made on one
+    // of the threads, and `worker` identifies that thread. Calls made with the
+    // same `worker` are never concurrent. The first exception thrown by a
+    // call is rethrown once all calls are done.
+    void run(size_t count, util::FunctionRef<void(size_t worker, size_t i)> fn)
+    {
+        start_threads();
+        {
+            std::lock_guard lock(m_mutex);
+            m_fn = &fn;
+            m_count = count;
+            m_next.store(0, std::memory_order_relaxed);
+            m_error = nullptr;
+            m_num_busy = m_threads.size();
+            ++m_batch;
+        }
+        m_work_cond.notify_all();
+        do_work(0);
+
+        std::unique_lock lock(m_mutex);
+        m_done_cond.wait(lock, [&] {
+            return m_num_busy == 0;
+        });
+        m_fn = nullptr;
+        if (m_error)
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+
+private:
+    const size_t m_num_threads;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_work_cond;
+    std::condition_variable m_done_cond;
+    util::FunctionRef<void(size_t, size_t)>* m_fn = nullptr;
+    size_t m_count = 0;
+    std::atomic<size_t> m_next = 0;
+    std::exception_ptr m_error;
+    size_t m_num_busy = 0;
+    uint64_t m_batch = 0;
+    bool m_stop = false;
+
+    void start_threads()
+    {
+        if (!m_threads.empty())
+            return;
+        m_threads.reserve(m_num_threads);
+        for (size_t i = 1; i <= m_num_threads; ++i) {
+            try {
+                m_threads.emplace_back([this, i] {
+                    worker_thread(i);
+                });
+            }
+            catch (const std::system_error&) {
+                // Could not start a new thread, so make do with the ones we have
+                break;
+            }
+        }
+    }
+
+    void worker_thread(size_t worker)
+    {
+        uint64_t last_batch = 0;
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_work_cond.wait(lock, [&] {
+                return m_stop || m_batch != last_batch;
+            });
+            if (m_stop)
+                return;
+            last_batch = m_batch;
+            lock.unlock();
+            do_work(worker);
+            lock.lock();
+            if (--m_num_busy == 0)
+                m_done_cond.notify_one();
+        }
+    }
+
+    void do_work(size_t worker)
+    {
+        for (;;) {
+            size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= m_count)
+                return;
+            try {
+                (*m_fn)(worker, i);
+            }
+            catch (...) {
+                std::lock_guard lock(m_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+            }
+        }
+    }
+};
+
+} // namespace realm::_impl
+
 static auto& s_coordinator_mutex = *new std::mutex;
 static auto& s_coordinators_per_path = *new std::unordered_map<std::string, std::weak_ptr<RealmCoordinator>>;
 
@@ -558,6 +692,11 @@ void RealmCoordinator::init_external_helpers()
     }
 #endif
 
+    // Created before the notifier thread is started, as it is not guarded by a
+    // mutex
+    if (!m_notifier_worker_pool && m_config.notifier_threads > 1)
+        m_notifier_worker_pool = std::make_unique<NotifierWorkerPool>(m_config.notifier_threads - 1);
+
     if (!m_notifier && !m_config.immutable() && m_config.automatic_change_notifications) {
         try {
             m_notifier = std::make_unique<ExternalCommitHelper>(*this, m_config);
@@ -665,6 +804,7 @@ RealmCoordinator::~RealmCoordinator()
 
     // Waits for the worker thread to join
     m_notifier.reset();
+    m_notifier_worker_pool.reset();
 
     // If there's any active NotificationTokens they'll keep the notifiers alive,
     // so tell the notifiers to release their Transactions so that the DB can
@@ -987,8 +1127,7 @@ void RealmCoordinator::run_async_notifiers()
         for (auto& notifier : notifiers)
             notifier->add_required_change_info(info);
         transaction::advance(*m_notifier_transaction, info, skip_version->get_version_of_current_transaction());
-        for (auto& notifier : notifiers)
-            notifier->run();
+        auto frozen_transactions = run_notifiers(notifiers, info);
 
         util::CheckedLockGuard lock(m_notifier_mutex);
         for (auto& notifier : notifiers)
@@ -1027,21 +1166,16 @@ void RealmCoordinator::run_async_notifiers()
     // the main Transaction used for background work rather than the temporary one
     for (auto& notifier : new_notifiers) {
         notifier->attach_to(m_notifier_transaction);
-        notifier->run();
     }
 
     // Change info is now all ready, so the notifiers can now perform their
     // background work
-    for (auto& notifier : notifiers) {
-        notifier->run();
-    }
+    notifiers.insert(notifiers.begin(), new_notifiers.begin(), new_notifiers.end());
+    auto frozen_transactions = run_notifiers(notifiers, change_info);
 
     // Reacquire the lock while updating the fields that are actually read on
     // other threads
     util::CheckedLockGuard lock2(m_notifier_mutex);
-    for (auto& notifier : new_notifiers) {
-        notifier->prepare_handover();
-    }
     for (auto& notifier : notifiers) {
         notifier->prepare_handover();
     }
@@ -1050,6 +1184,37 @@ void RealmCoordinator::run_async_notifiers()
         m_notifier_handover_transaction = m_db->start_read(version);
 }
 
+std::vector<TransactionRef> RealmCoordinator::run_notifiers(const NotifierVector& notifiers,
+                                                            TransactionChangeInfo& shared_info)
+{
+    if (!m_notifier_worker_pool || notifiers.size() < 2) {
+        for (auto& notifier : notifiers)
+            notifier->run();
+        return {};
+    }
+
+    // All notifiers except new ones, which have their own change info, share
+    // the results of their deep change checks.
+    shared_info.deep_change_cache->enable_concurrent_access();
+
+    // A Transaction can only be read from one thread at a time, so each worker
+    // runs its notifiers against its own frozen copy of the notifier
+    // transaction. The results of a run may refer to the frozen copy, so the
+    // copies are returned to be kept alive until the notifiers have prepared
+    // their handover.
+    auto version = m_notifier_transaction->get_version_of_current_transaction();
+    for (auto& notifier : notifiers)
+        notifier->prepare_to_run_frozen();
+    std::vector<TransactionRef> frozen_transactions(m_notifier_worker_pool->num_workers());
+    m_notifier_worker_pool->run(notifiers.size(), [&](size_t worker, size_t i) {
+        auto& frozen = frozen_transactions[worker];
+        if (!frozen)
+            frozen = m_db->start_frozen(version);
+        notifiers[i]->run_frozen(frozen);
+    });
+    return frozen_transactions;
+}
+
 void RealmCoordinator::advance_to_ready(Realm& realm)
 {
     // If callbacks close the Realm the last external reference may go away
@@ -37,7 +37,9 @@ class Transaction;
 namespace _impl {
 class CollectionNotifier;
 class ExternalCommitHelper;
+class NotifierWorkerPool;
 class WeakRealmNotifier;
+struct TransactionChangeInfo;
 
 // RealmCoordinator manages the weak cache of Realm instances and communication
 // between per-thread Realm instances for a given file
@@ -262,6 +264,10 @@ private:
 
     std::unique_ptr<_impl::ExternalCommitHelper> m_notifier;
 
+    // Threads which run notifiers concurrently with the thread running
+    // run_async_notifiers(). Null unless Config::notifier_threads is above one.
+    std::unique_ptr<NotifierWorkerPool> m_notifier_worker_pool;
+
 #if REALM_ENABLE_SYNC
     std::shared_ptr<SyncSession> m_sync_session;
 #endif
@@ -280,6 +286,8 @@ private:
     void do_get_realm(Realm::Config&& config, std::shared_ptr<Realm>& realm, util::Optional<VersionID> version,
                       util::CheckedUniqueLock& realm_lock, bool first_time_open = false) REQUIRES(m_realm_mutex);
     void run_async_notifiers() REQUIRES(!m_notifier_mutex, m_running_notifiers_mutex);
+    std::vector<TransactionRef> run_notifiers(const NotifierVector& notifiers, TransactionChangeInfo& shared_info)
+        REQUIRES(!m_notifier_mutex, m_running_notifiers_mutex);
     void clean_up_dead_notifiers() REQUIRES(m_notifier_mutex);
 
     NotifierVector notifiers_for_realm(Realm&) REQUIRES(m_notifier_mutex);
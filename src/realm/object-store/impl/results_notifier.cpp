@@ -114,7 +114,37 @@ bool ResultsNotifier::do_add_required_change_info(TransactionChangeInfo& info)
         update_related_tables(*m_query->get_table());
     }
 
-    return m_query->get_table() && has_run() && have_callbacks();
+    m_info_has_table_changes = m_query->get_table() && has_run() && have_callbacks();
+    return m_info_has_table_changes;
+}
+
+util::Optional<std::vector<ObjKey>> ResultsNotifier::changed_objects(const TableVersions& new_versions) const
+{
+    // The change info only covers the query's own table, so a query depending on
+    // other tables or a sorted/distinct result has to be rerun in full. So does
+    // a query following links within its own table, as an object's match then
+    // depends on the objects it links to.
+    if (!has_run() || m_missed_changes || !m_info_has_table_changes || m_info->schema_changed ||
+        new_versions.size() != 1 || !m_descriptor_ordering.is_empty() || m_query->has_link_dependencies())
+        return util::none;
+
+    std::vector<ObjKey> changed;
+    auto table = m_query->get_table();
+    if (auto it = m_info->tables.find(table->get_key()); it != m_info->tables.end()) {
+        auto& changes = it->second;
+        size_t num_changes = changes.insertions_size() + changes.modifications_size() + changes.deletions_size();
+        // Evaluating objects one at a time is much slower than scanning the
+        // table, so rerun the query if a large part of the table changed
+        if (num_changes > table->size() / 16)
+            return util::none;
+
+        changed.reserve(num_changes);
+        changed.insert(changed.end(), changes.get_insertions().begin(), changes.get_insertions().end());
+        changed.insert(changed.end(), changes.get_deletions().begin(), changes.get_deletions().end());
+        for (auto& [key, columns] : changes.get_modifications())
+            changed.push_back(key);
+    }
+    return changed;
 }
 
 void ResultsNotifier::calculate_changes()
@@ -149,11 +179,26 @@ void ResultsNotifier::calculate_changes()
     }
 }
 
+TableVersions ResultsNotifier::get_table_versions()
+{
+    auto versions = m_query->sync_view_if_needed();
+    m_descriptor_ordering.collect_dependencies(m_query->get_table().unchecked_ptr());
+    m_descriptor_ordering.get_versions(m_query->get_table()->get_parent_group(), versions);
+    return versions;
+}
+
+void ResultsNotifier::prepare_to_run_frozen()
+{
+    if (m_query->get_table())
+        m_versions_before_frozen_run = get_table_versions();
+}
+
 void ResultsNotifier::run()
 {
     NotifierRunLogger log(m_logger.get(), "ResultsNotifier", m_description);
 
     REALM_ASSERT(m_info || !has_run());
+    auto versions_before_frozen_run = std::exchange(m_versions_before_frozen_run, util::none);
 
     // Table's been deleted, so report all objects as deleted
     if (!m_query->get_table()) {
@@ -166,13 +211,15 @@ void ResultsNotifier::run()
     {
         auto lock = lock_target();
         // Don't run the query if the results aren't actually going to be used
-        if (!get_realm() || (!have_callbacks() && !m_results_were_used))
+        if (!get_realm() || (!have_callbacks() && !m_results_were_used)) {
+            m_missed_changes = true;
             return;
+        }
     }
 
-    auto new_versions = m_query->sync_view_if_needed();
-    m_descriptor_ordering.collect_dependencies(m_query->get_table().unchecked_ptr());
-    m_descriptor_ordering.get_versions(m_query->get_table()->get_parent_group(), new_versions);
+    auto new_versions = get_table_versions();
+    if (versions_before_frozen_run)
+        new_versions = std::move(*versions_before_frozen_run);
     if (has_run() && new_versions == m_last_seen_version) {
         // We've run previously and none of the tables involved in the query
         // changed so we don't need to rerun the query, but we still need to
@@ -190,8 +237,16 @@ void ResultsNotifier::run()
     }
 
     m_run_tv = TableView(*m_query, size_t(-1));
-    // Syncing will be done here
-    m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
+    if (auto changed = changed_objects(new_versions)) {
+        // Only the objects changed since the last run can have started or
+        // stopped matching the query, so evaluate those instead of rerunning it
+        m_run_tv.sync_changed_objects(m_previous_objs, std::move(*changed));
+    }
+    else {
+        // Syncing will be done here
+        m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
+        m_missed_changes = false;
+    }
     m_last_seen_version = std::move(new_versions);
 
     calculate_changes();
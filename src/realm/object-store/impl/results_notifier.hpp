@@ -50,6 +50,7 @@ class ResultsNotifier : public ResultsNotifierBase {
 public:
     ResultsNotifier(Results& target);
     bool get_tableview(TableView& out) override;
+    void prepare_to_run_frozen() override;
 
 private:
     std::unique_ptr<Query> m_query;
@@ -68,14 +69,24 @@ private:
     // The table version from the last time the query was run. Used to avoid
     // rerunning the query when there's no chance of it changing.
     TableVersions m_last_seen_version;
+    // The table versions read by prepare_to_run_frozen(), used by the next run
+    // instead of those of the frozen copy it runs against
+    util::Optional<TableVersions> m_versions_before_frozen_run;
 
     // The objects from the previous run of the query, for calculating diffs
     ObjKeys m_previous_objs;
 
     TransactionChangeInfo* m_info = nullptr;
+    // True if m_info records the changes made to the query's table
+    bool m_info_has_table_changes = false;
+    // True if the query was skipped for some changes, so m_previous_objs can't
+    // be updated from the changes of a single run
+    bool m_missed_changes = false;
     bool m_results_were_used = true;
 
     void calculate_changes();
+    TableVersions get_table_versions();
+    util::Optional<std::vector<ObjKey>> changed_objects(const TableVersions& new_versions) const;
 
     void run() override;
     void do_prepare_handover(Transaction&) override;
@@ -172,6 +172,9 @@ size_t Results::do_size()
         case Mode::Query:
             return m_query.count(m_descriptor_ordering);
         case Mode::TableView:
+            // The rest of a window can be counted without finding the objects
+            if (m_window_next)
+                return m_query.count();
             return m_table_view.size();
     }
     REALM_COMPILER_HINT_UNREACHABLE();
@@ -305,8 +308,16 @@ void Results::ensure_up_to_date(EvaluateMode mode)
             // difficult to determine if the async query is actually being
             // used.
             m_query.sync_view_if_needed();
-            if (m_update_policy != UpdatePolicy::AsyncOnly)
-                m_table_view = m_query.find_all(m_descriptor_ordering);
+            if (m_update_policy != UpdatePolicy::AsyncOnly) {
+                if (m_window_size && mode == EvaluateMode::Window) {
+                    // Only find the first window of objects for now
+                    m_table_view = TableView(m_query, size_t(-1));
+                    m_window_next = m_table_view.find_more(ObjKey(0), m_window_size);
+                }
+                else {
+                    m_table_view = m_query.find_all(m_descriptor_ordering);
+                }
+            }
             m_mode = Mode::TableView;
             if (auto audit = m_realm->audit_context())
                 audit->record_query(m_realm->read_transaction_version(), m_table_view);
@@ -324,18 +335,30 @@ void Results::ensure_up_to_date(EvaluateMode mode)
                 prepare_async(ForCallback{false});
             // First check if we have an up-to-date TableView waiting for us
             // which was generated on the background thread
-            else if (m_notifier)
-                m_notifier->get_tableview(m_table_view);
+            else if (m_notifier && m_notifier->get_tableview(m_table_view))
+                m_window_next = ObjKey();
             // This option is here so that tests can verify that the notifier
             // is actually being used.
-            if (m_update_policy == UpdatePolicy::Auto)
+            if (m_update_policy == UpdatePolicy::Auto) {
+                // Rerunning the query finds all of the objects
+                if (m_window_next && !m_table_view.is_in_sync())
+                    m_window_next = ObjKey();
                 m_table_view.sync_if_needed();
+            }
+            if (m_window_next && mode != EvaluateMode::Window && mode != EvaluateMode::Count)
+                m_window_next = m_table_view.find_more(m_window_next, size_t(-1));
             if (auto audit = m_realm->audit_context())
                 audit->record_query(m_realm->read_transaction_version(), m_table_view);
             return;
     }
 }
 
+void Results::ensure_window(size_t ndx)
+{
+    while (m_window_next && ndx >= m_table_view.size())
+        m_window_next = m_table_view.find_more(m_window_next, m_window_size);
+}
+
 size_t Results::actual_index(size_t ndx) const noexcept
 {
     if (auto& indices = m_list_indices) {
@@ -398,7 +421,7 @@ template <>
 util::Optional<Obj> Results::try_get(size_t row_ndx)
 {
     validate_read();
-    ensure_up_to_date();
+    ensure_up_to_date(EvaluateMode::Window);
     switch (m_mode) {
         case Mode::Empty:
             break;
@@ -420,6 +443,7 @@ util::Optional<Obj> Results::try_get(size_t row_ndx)
         case Mode::Query:
             REALM_UNREACHABLE();
         case Mode::TableView:
+            ensure_window(row_ndx);
             if (row_ndx >= m_table_view.size())
                 break;
             return m_table_view.get_object(row_ndx);
@@ -431,7 +455,7 @@ Mixed Results::get_any(size_t ndx)
 {
     util::CheckedUniqueLock lock(m_mutex);
     validate_read();
-    ensure_up_to_date();
+    ensure_up_to_date(EvaluateMode::Window);
     switch (m_mode) {
         case Mode::Empty:
             break;
@@ -451,6 +475,7 @@ Mixed Results::get_any(size_t ndx)
         case Mode::Query:
             REALM_UNREACHABLE(); // should always be in TV mode
         case Mode::TableView: {
+            ensure_window(ndx);
             if (ndx >= m_table_view.size())
                 break;
             if (m_update_policy == UpdatePolicy::Never && !m_table_view.is_obj_valid(ndx))
@@ -956,6 +981,19 @@ Results Results::limit(size_t max_count) const
     return Results(m_realm, do_get_query(), std::move(new_order));
 }
 
+Results Results::windowed(size_t window_size) const
+{
+    util::CheckedUniqueLock lock(m_mutex);
+    auto query = do_get_query();
+    // Only Results in table order can be found a part at a time. The Query
+    // may also carry an ordering of its own from the query parser.
+    bool in_table_order = query.get_table() && m_descriptor_ordering.is_empty() && !Query(query).get_ordering();
+    Results results(m_realm, std::move(query), m_descriptor_ordering);
+    if (in_table_order)
+        results.m_window_size = window_size;
+    return results;
+}
+
 Results Results::apply_ordering(DescriptorOrdering&& ordering)
 {
     util::CheckedUniqueLock lock(m_mutex);
@@ -1164,6 +1202,8 @@ Results Results::import_copy_into_realm(std::shared_ptr<Realm> const& realm)
         case Mode::Query:
             return Results(realm, *realm->import_copy_of(m_query, PayloadPolicy::Copy), m_descriptor_ordering);
         case Mode::TableView: {
+            if (m_window_next)
+                m_window_next = m_table_view.find_more(m_window_next, size_t(-1));
             Results results(realm, *realm->import_copy_of(m_table_view, PayloadPolicy::Copy), m_descriptor_ordering);
             results.assert_unlocked();
             results.evaluate_query_if_needed(false);
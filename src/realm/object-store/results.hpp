@@ -179,6 +179,13 @@ public:
     // Create a new Results with only the first `max_count` entries
     Results limit(size_t max_count) const REQUIRES(!m_mutex);
 
+    // Create a new Results which finds the objects matching its query a window
+    // of `window_size` objects at a time as they are accessed by index, rather
+    // than all at once. Anything else which needs all of the objects (including
+    // a notifier having run the query in the background) completes the window.
+    // Sorted and distinct Results are always evaluated in full.
+    Results windowed(size_t window_size) const REQUIRES(!m_mutex);
+
     // Create a new Results by adding sort and distinct combinations
     Results apply_ordering(DescriptorOrdering&& ordering) REQUIRES(!m_mutex);
 
@@ -310,7 +317,9 @@ public:
      * section.
      *
      * @param section_key_func The callback to be iterated on each value in the underlying Results.
-     * This callback must return a value which defines the section key
+     * This callback must return a value which defines the section key. For a collection of objects the
+     * callback must only depend on the object it is given, as it is not run again for an object that has not
+     * changed since its section key was last calculated.
      *
      * @return A SectionedResults object using a user defined sectioning algorithm.
      */
@@ -349,6 +358,10 @@ private:
     friend class SectionedResults;
     UpdatePolicy m_update_policy = UpdatePolicy::Auto;
     uint64_t m_last_collection_content_version GUARDED_BY(m_mutex) = 0;
+    // When windowed, the number of objects to find at a time and the key to
+    // continue from. A null key means that m_table_view holds all objects.
+    size_t m_window_size = 0;
+    ObjKey m_window_next GUARDED_BY(m_mutex);
 
     void validate_read() const;
     void validate_write() const;
@@ -372,11 +385,16 @@ private:
     template <typename Fn>
     auto dispatch(Fn&&) const REQUIRES(!m_mutex);
 
-    enum class EvaluateMode { Count, Snapshot, Normal };
+    // Window is used when accessing a single object by index, for which a
+    // windowed Results only needs the objects up to that index.
+    enum class EvaluateMode { Count, Snapshot, Normal, Window };
     /// Returns true if the underlying table_view or collection has changed, and is waiting
     /// for `ensure_up_to_date` to run.
     bool has_changed() REQUIRES(!m_mutex);
     void ensure_up_to_date(EvaluateMode mode = EvaluateMode::Normal) REQUIRES(m_mutex);
+    // Find objects for a windowed Results until it has more than `ndx` objects
+    // or has all of them.
+    void ensure_window(size_t ndx) REQUIRES(m_mutex);
 
     // Shared logic between freezing and thawing Results as the Core API is the same.
     Results import_copy_into_realm(std::shared_ptr<Realm> const& realm) REQUIRES(!m_mutex);
@@ -83,12 +83,13 @@ struct IndexSetAdder {
 struct SectionedResultsNotificationHandler {
 public:
     SectionedResultsNotificationHandler(SectionedResults& sectioned_results,
-                                        SectionedResultsNotificationCallback&& cb,
+                                        SectionedResultsNotificationCallback&& cb, bool filtered,
                                         util::Optional<Mixed> section_filter = util::none)
         : m_cb(std::move(cb))
         , m_sectioned_results(sectioned_results)
         , m_prev_row_to_index_path(m_sectioned_results.m_row_to_index_path)
         , m_section_filter(section_filter)
+        , m_filtered(filtered)
     {
     }
 
@@ -96,7 +97,22 @@ public:
     {
         util::CheckedUniqueLock lock(m_sectioned_results.m_mutex);
 
-        m_sectioned_results.calculate_sections_if_required();
+        // The changes tell which rows may have a new section key only if they
+        // are relative to the version the sections were calculated at, and
+        // include every modification. The changes delivered to a callback
+        // cover all commits since its previous call, however many there were,
+        // except for a commit whose notification was suppressed. A callback
+        // filtered by key path is not told about modifications of the other
+        // columns, which the section key may be calculated from.
+        std::optional<VersionID> version;
+        if (auto& realm = m_sectioned_results.m_results.get_realm(); realm && realm->is_in_read_transaction())
+            version = realm->read_transaction_version();
+        CollectionChangeSet const* changes = nullptr;
+        if (!m_filtered && !c.omits_suppressed_changes && m_version && version &&
+            m_sectioned_results.m_row_keys_version == m_version)
+            changes = &c;
+        m_sectioned_results.calculate_sections_if_required(changes);
+        m_version = version;
         section_initial_changes(c);
         m_prev_row_to_index_path = m_sectioned_results.m_row_to_index_path;
 
@@ -187,6 +203,10 @@ private:
     // change indices referring to the supplied section key.
     util::Optional<Mixed> m_section_filter;
     bool m_section_filter_should_deliver_initial_notification = true;
+    // True if the callback is filtered by key path
+    bool m_filtered;
+    // The version of the Realm when the callback was last called
+    std::optional<VersionID> m_version;
 
     // Group the changes in the changeset by the section
     void section_initial_changes(CollectionChangeSet const& c) REQUIRES(m_sectioned_results.m_mutex)
@@ -305,6 +325,44 @@ void create_buffered_key(Mixed& key, Buffer& buffer)
         create_buffered_key(key, buffer, key.get_binary());
 }
 
+// Map each row of the new collection to the row it had in the old one, or to
+// npos if it was inserted or modified and so needs its section key calculated
+// again. Returns an empty vector if the changes don't fit the sizes given.
+std::vector<size_t> unchanged_rows(CollectionChangeSet const& c, size_t old_size, size_t new_size)
+{
+    std::vector<size_t> rows;
+    if (c.collection_was_cleared || c.collection_root_was_deleted ||
+        old_size + c.insertions.count() != new_size + c.deletions.count())
+        return rows;
+
+    std::unordered_map<size_t, size_t> moved;
+    for (auto& move : c.moves)
+        moved[move.to] = move.from;
+
+    auto deletions = c.deletions.as_indexes();
+    auto insertions = c.insertions.as_indexes();
+    auto next_deletion = deletions.begin();
+    auto next_insertion = insertions.begin();
+    size_t old_row = 0;
+    rows.reserve(new_size);
+    for (size_t row = 0; row < new_size; ++row) {
+        if (next_insertion != insertions.end() && *next_insertion == row) {
+            ++next_insertion;
+            auto it = moved.find(row);
+            rows.push_back(it == moved.end() ? npos : it->second);
+            continue;
+        }
+        while (next_deletion != deletions.end() && *next_deletion == old_row) {
+            ++next_deletion;
+            ++old_row;
+        }
+        rows.push_back(old_row++);
+    }
+    for (auto row : c.modifications_new.as_indexes())
+        rows[row] = npos;
+    return rows;
+}
+
 } // anonymous namespace
 
 ResultsSection::ResultsSection(SectionedResults* parent, Mixed key)
@@ -388,7 +446,7 @@ SectionedResults::SectionedResults(Results results, Results::SectionedResultsOpe
 {
 }
 
-void SectionedResults::calculate_sections_if_required()
+void SectionedResults::calculate_sections_if_required(CollectionChangeSet const* changes)
 {
     if (m_results.m_update_policy == Results::UpdatePolicy::Never)
         return;
@@ -400,13 +458,16 @@ void SectionedResults::calculate_sections_if_required()
         m_results.ensure_up_to_date();
     }
 
-    calculate_sections();
+    calculate_sections(changes);
 }
 
 // This method will run in the following scenarios:
 // - SectionedResults is performing its initial evaluation.
 // - The underlying Table in the Results collection has changed
-void SectionedResults::calculate_sections()
+//
+// `changes` are the changes to the underlying Results since the sections were
+// last calculated, if known.
+void SectionedResults::calculate_sections(CollectionChangeSet const* changes)
 {
     m_previous_str_buffers.clear();
     m_previous_str_buffers.swap(m_current_str_buffers);
@@ -418,16 +479,39 @@ void SectionedResults::calculate_sections()
     }
 
     m_sections.clear();
+    auto previous_row_to_index_path = std::move(m_row_to_index_path);
+    auto previous_row_keys = std::move(m_row_keys);
     m_row_to_index_path.clear();
+    m_row_keys.clear();
     size_t size = m_results.size();
     m_row_to_index_path.resize(size);
 
+    std::vector<size_t> unchanged;
+    if (changes)
+        unchanged = unchanged_rows(*changes, previous_row_keys.size(), size);
+    bool track_rows = m_results.get_type() == PropertyType::Object;
+    if (track_rows)
+        m_row_keys.reserve(size);
+
     for (size_t i = 0; i < size; ++i) {
-        Mixed key = m_callback(m_results.get_any(i), m_results.get_realm());
-        // Disallow links as section keys. It would be uncommon to use them to begin with
-        // and if the object acting as the key was deleted bad things would happen.
-        if (key.is_type(type_Link, type_TypedLink)) {
-            throw InvalidArgument("Links are not supported as section keys.");
+        Mixed value = m_results.get_any(i);
+        ObjKey obj_key = track_rows && !value.is_null() ? value.get_link().get_obj_key() : ObjKey();
+        if (track_rows)
+            m_row_keys.push_back(obj_key);
+
+        Mixed key;
+        // The row mapping can only be trusted if the object is the same one as before
+        if (size_t old_row = i < unchanged.size() ? unchanged[i] : npos;
+            old_row != npos && obj_key && previous_row_keys[old_row] == obj_key) {
+            key = m_previous_index_to_key[previous_row_to_index_path[old_row].first];
+        }
+        else {
+            key = m_callback(value, m_results.get_realm());
+            // Disallow links as section keys. It would be uncommon to use them to begin with
+            // and if the object acting as the key was deleted bad things would happen.
+            if (key.is_type(type_Link, type_TypedLink)) {
+                throw InvalidArgument("Links are not supported as section keys.");
+            }
         }
 
         auto it = m_current_key_to_index.find(key);
@@ -453,6 +537,11 @@ void SectionedResults::calculate_sections()
         }
     }
     m_has_performed_initial_evaluation = true;
+    // Changes made in a write transaction aren't reported until it commits and
+    // may instead be rolled back
+    m_row_keys_version.reset();
+    if (auto& realm = m_results.get_realm(); track_rows && realm && !realm->is_in_transaction())
+        m_row_keys_version = realm->read_transaction_version();
 }
 
 size_t SectionedResults::size()
@@ -487,15 +576,18 @@ ResultsSection SectionedResults::operator[](Mixed key)
 NotificationToken SectionedResults::add_notification_callback(SectionedResultsNotificationCallback&& callback,
                                                               std::optional<KeyPathArray> key_path_array) &
 {
-    return m_results.add_notification_callback(SectionedResultsNotificationHandler(*this, std::move(callback)),
-                                               std::move(key_path_array));
+    bool filtered = key_path_array.has_value();
+    return m_results.add_notification_callback(
+        SectionedResultsNotificationHandler(*this, std::move(callback), filtered), std::move(key_path_array));
 }
 
 NotificationToken SectionedResults::add_notification_callback_for_section(
     Mixed section_key, SectionedResultsNotificationCallback&& callback, std::optional<KeyPathArray> key_path_array)
 {
+    bool filtered = key_path_array.has_value();
     return m_results.add_notification_callback(
-        SectionedResultsNotificationHandler(*this, std::move(callback), section_key), std::move(key_path_array));
+        SectionedResultsNotificationHandler(*this, std::move(callback), filtered, section_key),
+        std::move(key_path_array));
 }
 
 // Thread-safety analysis doesn't work when creating a different instance of the
@@ -552,5 +644,7 @@ void SectionedResults::reset_section_callback(SectionKeyFunc section_callback)
     m_current_key_to_index.clear();
     m_previous_key_to_index.clear();
     m_row_to_index_path.clear();
+    m_row_keys.clear();
+    m_row_keys_version.reset();
 }
 } // namespace realm
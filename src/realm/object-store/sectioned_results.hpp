@@ -101,6 +101,11 @@ private:
  * where elements are arranged into sections defined by a key either from a user defined sectioning algorithm
  * or a predefined built-in sectioning algorithm. Elements are then accessed through a `ResultsSection` which can be
  * retrieved through the subscript operator on `SectionedResults`.
+ *
+ * For a collection of objects, the section key of an object is only recalculated when a notification reports
+ * the object as inserted or modified, or when it can not be told whether it was. A user defined sectioning
+ * algorithm must therefore be a pure function of the object it is given: a key derived from other objects or
+ * from captured state may be stale.
  */
 class SectionedResults {
 public:
@@ -168,8 +173,8 @@ private:
     friend struct SectionedResultsNotificationHandler;
     util::CheckedOptionalMutex m_mutex;
     SectionedResults copy(Results&&) REQUIRES(!m_mutex);
-    void calculate_sections_if_required() REQUIRES(m_mutex);
-    void calculate_sections() REQUIRES(m_mutex);
+    void calculate_sections_if_required(CollectionChangeSet const* changes = nullptr) REQUIRES(m_mutex);
+    void calculate_sections(CollectionChangeSet const* changes) REQUIRES(m_mutex);
     bool m_has_performed_initial_evaluation = false;
     NotificationToken
     add_notification_callback_for_section(Mixed section_key, SectionedResultsNotificationCallback&& callback,
@@ -192,6 +197,16 @@ private:
     // this will give a pair with the section index of the object, and the position of the object in that section.
     // This is used for parsing the indices in CollectionChangeSet to section indices.
     std::vector<std::pair<size_t, size_t>> m_row_to_index_path;
+
+    // The object of each row in the underlying `Results` when the sections were
+    // last calculated. When recalculating the sections from the changes reported
+    // to a notification callback, rows which hold the same object and weren't
+    // modified keep their section key without calling the section key callback
+    // again.
+    std::vector<ObjKey> m_row_keys;
+    // The version the sections were calculated at, if `m_row_keys` is current
+    // for it, i.e. the sections weren't calculated in a write transaction.
+    std::optional<VersionID> m_row_keys_version;
     // BinaryData & StringData types require a buffer to hold deep
     // copies of the key values for the lifetime of the sectioned results.
     // This is due to the fact that such values can reference the memory address of the value in the realm.
@@ -177,6 +177,12 @@ struct RealmConfig {
     // it instead delete orphans and duplicate objects with multiple incoming links.
     bool automatically_handle_backlinks_in_migrations = false;
 
+    // The number of threads which run the background work of change
+    // notifiers, including the notifier thread itself. With more than one,
+    // the notifiers for different collections run concurrently after each
+    // commit. Only the value from the first Realm opened for a file is used.
+    size_t notifier_threads = 1;
+
     // Only for internal testing. Not to be exposed by SDKs.
     //
     // Disable the background worker thread for producing change
@@ -29,6 +29,7 @@
 #include <realm/set.hpp>
 
 #include <algorithm>
+#include <thread>
 
 using namespace realm;
 
@@ -87,6 +88,7 @@ Query::Query(const Query& source)
     , m_groups(source.m_groups)
     , m_table(source.m_table)
     , m_ordering(source.m_ordering)
+    , m_num_threads(source.m_num_threads)
 {
     if (source.m_owned_source_table_view) {
         m_owned_source_table_view = source.m_owned_source_table_view->clone();
@@ -133,6 +135,7 @@ Query& Query::operator=(const Query& source)
             m_view = m_source_collection.get();
         }
         m_ordering = source.m_ordering;
+        m_num_threads = source.m_num_threads;
     }
     return *this;
 }
@@ -158,6 +161,7 @@ Query::Query(const Query* source, Transaction* tr, PayloadPolicy policy)
         REALM_ASSERT_DEBUG(m_view);
     }
     m_groups = source->m_groups;
+    m_num_threads = source->m_num_threads;
     if (source->m_table)
         set_table(tr->import_copy_of(source->m_table));
     // otherwise: empty query.
@@ -1119,11 +1123,12 @@ void Query::aggregate(QueryStateBase& st, ColKey column_key) const
             auto pn = root_node();
             auto best = find_best_node(pn);
             auto node = pn->m_children[best];
-            if (auto keys = node->index_based_keys()) {
-                // The node having the search index can be removed from the query as we know that
-                // all the objects will match this condition
-                pn->m_children[best] = pn->m_children.back();
-                pn->m_children.pop_back();
+            if (node->index_based_keys()) {
+                // The nodes having a search index can be removed from the query as we know that
+                // all the objects will match these conditions
+                std::vector<ObjKey> storage;
+                IndexEvaluator combined;
+                auto keys = take_index_conditions(pn, best, storage, combined);
                 const size_t num_keys = keys->size();
                 for (size_t i = 0; i < num_keys; ++i) {
                     auto obj = m_table->get_object(keys->get(i));
@@ -1133,6 +1138,17 @@ void Query::aggregate(QueryStateBase& st, ColKey column_key) const
                     }
                 }
             }
+            else if (size_t num_leaves = 0, num_workers = parallel_worker_count(num_leaves);
+                     num_workers > 1 && st.limit() == size_t(-1)) {
+                std::vector<std::unique_ptr<QueryStateBase>> states;
+                for (size_t w = 0; w < num_workers; ++w)
+                    states.push_back(st.make_partial());
+                run_parallel(states, num_leaves, column_key, [this]() -> std::unique_ptr<ArrayPayload> {
+                    return std::make_unique<LeafType>(m_table.unchecked_ptr()->get_alloc());
+                });
+                for (auto& partial : states)
+                    st.combine(*partial);
+            }
             else {
                 // no index, traverse cluster tree
                 node = pn;
@@ -1173,6 +1189,67 @@ size_t Query::find_best_node(ParentNode* pn) const
     return best;
 }
 
+// Remove the condition pn->m_children[best], which must be answered by a search index, and all other
+// conditions answered by one from pn and return the keys of the objects matching all of them. The
+// keys of the best condition are intersected with the keys of the others, which is much cheaper than
+// looking up each object and evaluating those conditions on it. If an intersection is needed, the
+// result is kept in `storage` and returned through `combined`.
+const IndexEvaluator* Query::take_index_conditions(ParentNode* pn, size_t best, std::vector<ObjKey>& storage,
+                                                   IndexEvaluator& combined) const
+{
+    const IndexEvaluator* keys = pn->m_children[best]->index_based_keys();
+    REALM_ASSERT(keys);
+    auto logger = m_table->get_logger();
+    if (logger && logger->would_log(util::LogCategory::query, util::Logger::Level::debug)) {
+        util::serializer::SerialisationState state(m_table->get_parent_group());
+        logger->log(util::LogCategory::query, util::Logger::Level::debug, "Query uses search index: '%1', matches: %2",
+                    pn->m_children[best]->describe(state), int64_t(keys->size()));
+    }
+    pn->m_children[best] = pn->m_children.back();
+    pn->m_children.pop_back();
+
+    for (size_t c = 0; c < pn->m_children.size();) {
+        const IndexEvaluator* other = pn->m_children[c]->index_based_keys();
+        if (!other) {
+            ++c;
+            continue;
+        }
+        pn->m_children[c] = pn->m_children.back();
+        pn->m_children.pop_back();
+
+        // Both sets of keys are sorted. The best condition usually has far fewer keys, so
+        // gallop through the keys of the other one rather than visiting all of them.
+        std::vector<ObjKey> matches;
+        const size_t num_keys = keys->size();
+        const size_t num_other = other->size();
+        size_t j = 0;
+        for (size_t i = 0; i < num_keys && j < num_other; ++i) {
+            ObjKey key = keys->get(i);
+            size_t end = j;
+            size_t step = 1;
+            while (end < num_other && other->get(end) < key) {
+                j = end + 1;
+                end += step;
+                step *= 2;
+            }
+            end = std::min(end, num_other);
+            while (j < end) {
+                size_t mid = j + (end - j) / 2;
+                if (other->get(mid) < key)
+                    j = mid + 1;
+                else
+                    end = mid;
+            }
+            if (j < num_other && other->get(j) == key)
+                matches.push_back(key);
+        }
+        storage = std::move(matches);
+        combined.init(&storage);
+        keys = &combined;
+    }
+    return keys;
+}
+
 /**************************************************************************************************************
  *                                                                                                             *
  * Main entry point of a query. Schedules calls to aggregate_local                                             *
@@ -1444,11 +1521,12 @@ void Query::do_find_all(QueryStateBase& st) const
             auto pn = root_node();
             auto best = find_best_node(pn);
             auto node = pn->m_children[best];
-            if (auto keys = node->index_based_keys()) {
-                // The node having the search index can be removed from the query as we know that
-                // all the objects will match this condition
-                pn->m_children[best] = pn->m_children.back();
-                pn->m_children.pop_back();
+            if (node->index_based_keys()) {
+                // The nodes having a search index can be removed from the query as we know that
+                // all the objects will match these conditions
+                std::vector<ObjKey> storage;
+                IndexEvaluator combined;
+                auto keys = take_index_conditions(pn, best, storage, combined);
 
                 const size_t num_keys = keys->size();
                 for (size_t i = 0; i < num_keys; ++i) {
@@ -1468,6 +1546,26 @@ void Query::do_find_all(QueryStateBase& st) const
                     }
                 }
             }
+            else if (size_t num_leaves = 0, num_workers = parallel_worker_count(num_leaves); num_workers > 1) {
+                // Each worker collects the keys of its own range of leaves. The ranges
+                // are in table order, so the keys can be reported in sequence.
+                std::vector<std::vector<ObjKey>> keys(num_workers);
+                std::vector<std::unique_ptr<QueryStateBase>> states;
+                for (auto& k : keys)
+                    states.push_back(std::make_unique<QueryStateFindAll<std::vector<ObjKey>>>(k, st.limit()));
+                run_parallel(states, num_leaves);
+
+                st.m_key_values = nullptr;
+                [&] {
+                    for (auto& k : keys) {
+                        for (ObjKey key : k) {
+                            st.m_key_offset = key.value;
+                            if (!st.match(0, Mixed()))
+                                return;
+                        }
+                    }
+                }();
+            }
             else {
                 // no index on best node (and likely no index at all), descend B+-tree
                 node = pn;
@@ -1495,6 +1593,45 @@ void Query::do_find_all(QueryStateBase& st) const
     }
 }
 
+ObjKey Query::do_find_more(std::vector<ObjKey>& keys, ObjKey begin, size_t count) const
+{
+    REALM_ASSERT(count > 0);
+    init();
+
+    ParentNode* node = has_conditions() ? root_node() : nullptr;
+    if (m_view || (node && node->m_children[find_best_node(node)]->index_based_keys())) {
+        // These queries find their matches without scanning the table, so
+        // there is nothing to gain from finding them a part at a time
+        REALM_ASSERT(begin == ObjKey(0));
+        QueryStateFindAll<std::vector<ObjKey>> st(keys);
+        do_find_all(st);
+        return ObjKey();
+    }
+
+    QueryStateFindAll<std::vector<ObjKey>> st(keys, count);
+    auto f = [&node, &st, this](const Cluster* cluster, size_t begin_ndx) {
+        size_t e = cluster->node_size();
+        st.m_key_offset = cluster->get_offset();
+        st.m_key_values = cluster->get_key_array();
+        if (node) {
+            node->set_cluster(cluster);
+            aggregate_internal(node, &st, begin_ndx, e, nullptr);
+        }
+        else {
+            for (size_t i = begin_ndx; i < e; i++) {
+                if (!st.match(i, Mixed()))
+                    break;
+            }
+        }
+        // Stop if limit is reached
+        return st.match_count() == st.limit() ? IteratorControl::Stop : IteratorControl::AdvanceToNext;
+    };
+
+    if (!m_table->traverse_clusters(begin, f))
+        return ObjKey();
+    return ObjKey(keys.back().value + 1);
+}
+
 TableView Query::find_all(size_t limit) const
 {
     TableView ret(*this, limit);
@@ -1560,12 +1697,13 @@ size_t Query::do_count(size_t limit) const
         auto pn = root_node();
         auto best = find_best_node(pn);
         auto node = pn->m_children[best];
-        if (auto keys = node->index_based_keys()) {
-            if (pn->m_children.size() > 1) {
-                // The node having the search index can be removed from the query as we know that
-                // all the objects will match this condition
-                pn->m_children[best] = pn->m_children.back();
-                pn->m_children.pop_back();
+        if (node->index_based_keys()) {
+            // The nodes having a search index can be removed from the query as we know that
+            // all the objects will match these conditions
+            std::vector<ObjKey> storage;
+            IndexEvaluator combined;
+            auto keys = take_index_conditions(pn, best, storage, combined);
+            if (!pn->m_children.empty()) {
                 const size_t num_keys = keys->size();
                 for (size_t i = 0; i < num_keys; ++i) {
                     auto obj = m_table->get_object(keys->get(i));
@@ -1577,11 +1715,21 @@ size_t Query::do_count(size_t limit) const
                 }
             }
             else {
-                // The node having the search index is the only node
+                // The nodes having a search index are the only nodes
                 auto sz = keys->size();
                 cnt = std::min(limit, sz);
             }
         }
+        else if (size_t num_leaves = 0, num_workers = parallel_worker_count(num_leaves); num_workers > 1) {
+            QueryStateCount st(limit);
+            std::vector<std::unique_ptr<QueryStateBase>> states;
+            for (size_t w = 0; w < num_workers; ++w)
+                states.push_back(st.make_partial());
+            run_parallel(states, num_leaves);
+            for (auto& partial : states)
+                st.combine(*partial);
+            cnt = st.get_count();
+        }
         else {
             // no index, descend down the B+-tree instead
             node = pn;
@@ -1681,135 +1829,97 @@ size_t Query::remove() const
     return rows;
 }
 
-#if REALM_MULTITHREAD_QUERY
-TableView Query::find_all_multi(size_t start, size_t end)
+size_t Query::parallel_worker_count(size_t& num_leaves) const
 {
-    static_cast<void>(start);
-    static_cast<void>(end);
+    // Minimum number of cluster leaves handed to each worker. Below this the cost
+    // of copying the conditions and starting the thread is not worth it.
+    constexpr size_t min_leaves_per_worker = 4;
 
-    // Initialization
-    init();
-    ts.next_job = start;
-    ts.end_job = end;
-    ts.done_job = 0;
-    ts.count = 0;
-    ts.table = &table;
-    ts.node = first[0];
+    // Parallel evaluation relies on the table being an immutable snapshot
+    if (m_num_threads < 2 || m_view || !m_table || !m_table->is_frozen())
+        return 1;
 
-    // Signal all threads to start
-    pthread_mutex_unlock(&ts.jobs_mutex);
-    pthread_cond_broadcast(&ts.jobs_cond);
+    num_leaves = 0;
+    m_table->traverse_clusters([&num_leaves](const Cluster*) {
+        ++num_leaves;
+        return IteratorControl::AdvanceToNext;
+    });
+    return std::max(std::min(m_num_threads, num_leaves / min_leaves_per_worker), size_t(1));
+}
 
-    // Wait until all threads have completed
-    pthread_mutex_lock(&ts.completed_mutex);
-    while (ts.done_job < ts.end_job)
-        pthread_cond_wait(&ts.completed_cond, &ts.completed_mutex);
-    pthread_mutex_lock(&ts.jobs_mutex);
-    pthread_mutex_unlock(&ts.completed_mutex);
+void Query::run_parallel(std::vector<std::unique_ptr<QueryStateBase>>& states, size_t num_leaves, ColKey column_key,
+                         const std::function<std::unique_ptr<ArrayPayload>()>& make_leaf) const
+{
+    const size_t num_workers = states.size();
 
-    TableView tv(*m_table);
+    // The condition nodes hold per-leaf state, so each worker needs its own copy.
+    // The copies are made up front as cloning is not safe while another thread
+    // is using the source nodes.
+    std::vector<Query> queries(num_workers, *this);
+    std::vector<std::exception_ptr> errors(num_workers);
 
-    // Sort search results because user expects ascending order
-    sort(ts.chunks.begin(), ts.chunks.end(), &Query::comp);
-    for (size_t i = 0; i < ts.chunks.size(); ++i) {
-        const size_t from = ts.chunks[i].m_root_node;
-        const size_t upto = (i == ts.chunks.size() - 1) ? size_t(-1) : ts.chunks[i + 1].m_root_node;
-        size_t first = ts.chunks[i].second;
+    auto work = [&](size_t w) {
+        try {
+            const Query& q = queries[w];
+            q.init();
+            std::unique_ptr<ArrayPayload> leaf;
+            if (make_leaf)
+                leaf = make_leaf();
+            size_t begin = num_leaves * w / num_workers;
+            size_t end = num_leaves * (w + 1) / num_workers;
+            q.traverse_leaves(*states[w], begin, end, column_key, leaf.get());
+        }
+        catch (...) {
+            errors[w] = std::current_exception();
+        }
+    };
 
-        while (first < ts.results.size() && ts.results[first] < upto && ts.results[first] >= from) {
-            tv.get_ref_column().add(ts.results[first]);
-            ++first;
+    std::vector<std::thread> threads;
+    threads.reserve(num_workers - 1);
+    for (size_t w = 1; w < num_workers; ++w) {
+        try {
+            threads.emplace_back(work, w);
+        }
+        catch (const std::system_error&) {
+            // Could not start a new thread, so do the job here instead
+            work(w);
         }
     }
+    work(0);
+    for (auto& thread : threads)
+        thread.join();
 
-    return move(tv);
-}
-
-int Query::set_threads(unsigned int threadcount)
-{
-#if defined(_WIN32) || defined(__WIN32__) || defined(_WIN64)
-    pthread_win32_process_attach_np();
-#endif
-    pthread_mutex_init(&ts.result_mutex, nullptr);
-    pthread_cond_init(&ts.completed_cond, nullptr);
-    pthread_mutex_init(&ts.jobs_mutex, nullptr);
-    pthread_mutex_init(&ts.completed_mutex, nullptr);
-    pthread_cond_init(&ts.jobs_cond, nullptr);
-
-    pthread_mutex_lock(&ts.jobs_mutex);
-
-    for (size_t i = 0; i < m_threadcount; ++i)
-        pthread_detach(threads[i]);
-
-    for (size_t i = 0; i < threadcount; ++i) {
-        int r = pthread_create(&threads[i], nullptr, query_thread, (void*)&ts);
-        if (r != 0)
-            REALM_ASSERT(false); // todo
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
     }
-    m_threadcount = threadcount;
-    return 0;
 }
 
-
-void* Query::query_thread(void* arg)
+void Query::traverse_leaves(QueryStateBase& st, size_t begin_leaf, size_t end_leaf, ColKey column_key,
+                            ArrayPayload* source_column) const
 {
-    static_cast<void>(arg);
-    thread_state* ts = static_cast<thread_state*>(arg);
-
-    std::vector<size_t> res;
-    std::vector<pair<size_t, size_t>> chunks;
-
-    for (;;) {
-        // Main waiting loop that waits for a query to start
-        pthread_mutex_lock(&ts->jobs_mutex);
-        while (ts->next_job == ts->end_job)
-            pthread_cond_wait(&ts->jobs_cond, &ts->jobs_mutex);
-        pthread_mutex_unlock(&ts->jobs_mutex);
+    ParentNode* node = root_node();
+    size_t leaf_ndx = 0;
 
-        for (;;) {
-            // Pick a job
-            pthread_mutex_lock(&ts->jobs_mutex);
-            if (ts->next_job == ts->end_job)
-                break;
-            const size_t chunk = min(ts->end_job - ts->next_job, thread_chunk_size);
-            const size_t mine = ts->next_job;
-            ts->next_job += chunk;
-            size_t r = mine - 1;
-            const size_t end = mine + chunk;
-
-            pthread_mutex_unlock(&ts->jobs_mutex);
-
-            // Execute job
-            for (;;) {
-                r = ts->node->find_first(r + 1, end);
-                if (r == end)
-                    break;
-                res.push_back(r);
-            }
+    auto f = [&](const Cluster* cluster) {
+        if (leaf_ndx++ < begin_leaf)
+            return IteratorControl::AdvanceToNext;
 
-            // Append result in common queue shared by all threads.
-            pthread_mutex_lock(&ts->result_mutex);
-            ts->done_job += chunk;
-            if (res.size() > 0) {
-                ts->chunks.push_back(std::pair<size_t, size_t>(mine, ts->results.size()));
-                ts->count += res.size();
-                for (size_t i = 0; i < res.size(); i++) {
-                    ts->results.push_back(res[i]);
-                }
-                res.clear();
-            }
-            pthread_mutex_unlock(&ts->result_mutex);
+        size_t e = cluster->node_size();
+        node->set_cluster(cluster);
+        if (source_column)
+            cluster->init_leaf(column_key, source_column);
+        st.m_key_offset = cluster->get_offset();
+        st.m_key_values = cluster->get_key_array();
+        aggregate_internal(node, &st, 0, e, source_column);
+        // Stop if limit or end of range is reached
+        return (leaf_ndx == end_leaf || st.match_count() == st.limit()) ? IteratorControl::Stop
+                                                                         : IteratorControl::AdvanceToNext;
+    };
 
-            // Signal main thread that we might have compleeted
-            pthread_mutex_lock(&ts->completed_mutex);
-            pthread_cond_signal(&ts->completed_cond);
-            pthread_mutex_unlock(&ts->completed_mutex);
-        }
-    }
-    return 0;
+    m_table->traverse_clusters(f);
 }
 
-#endif // REALM_MULTITHREADQUERY
 
 std::string Query::validate() const
 {
@@ -1883,6 +1993,16 @@ void Query::init() const
         root->init(m_view == nullptr);
         std::vector<ParentNode*> vec;
         root->gather_children(vec);
+
+        // For conditions answered by a search index the number of matches is known up front, so
+        // use it instead of the default estimate. This makes find_best_node() pick the most
+        // selective index to drive the query, and prefer scanning over an index matching a large
+        // part of the table.
+        const double table_size = double(m_table.unchecked_ptr()->size());
+        for (auto node : root->m_children) {
+            if (auto keys = node->index_based_keys())
+                node->m_dD = std::max(table_size / (keys->size() + 1.1), 1.0);
+        }
     }
 }
 
@@ -2033,6 +2153,14 @@ void Query::get_outside_versions(TableVersions& versions) const
     }
 }
 
+bool Query::has_link_dependencies() const
+{
+    std::vector<TableKey> table_keys;
+    if (ParentNode* root = root_node())
+        root->get_link_dependencies(table_keys);
+    return !table_keys.empty();
+}
+
 TableVersions Query::sync_view_if_needed() const
 {
     if (m_view) {
@@ -23,17 +23,10 @@
 #include <cstdio>
 #include <climits>
 #include <algorithm>
+#include <functional>
 #include <string>
 #include <vector>
 
-#define REALM_MULTITHREAD_QUERY 0
-
-#if REALM_MULTITHREAD_QUERY
-// FIXME: Use our C++ thread abstraction API since it provides a much
-// higher level of encapsulation and safety.
-#include <pthread.h>
-#endif
-
 #include <realm/aggregate_ops.hpp>
 #include <realm/binary_data.hpp>
 #include <realm/column_type_traits.hpp>
@@ -50,6 +43,7 @@ namespace realm {
 class Array;
 class Expression;
 class Group;
+class IndexEvaluator;
 class LinkMap;
 class ParentNode;
 class Table;
@@ -277,12 +271,27 @@ public:
     // Deletion
     size_t remove() const;
 
-#if REALM_MULTITHREAD_QUERY
     // Multi-threading
-    TableView find_all_multi(size_t start = 0, size_t end = size_t(-1));
-    TableView find_all_multi(size_t start = 0, size_t end = size_t(-1)) const;
-    int set_threads(unsigned int threadcount);
-#endif
+    // A query on a frozen table without a restricting view may be evaluated by
+    // up to 'num_threads' threads, each scanning a contiguous range of cluster
+    // leaves with its own copy of the conditions. Results are identical to those
+    // of a single threaded run. The default value of 1 disables parallel execution.
+    Query& set_num_threads(size_t num_threads) noexcept
+    {
+        m_num_threads = std::max(num_threads, size_t(1));
+        return *this;
+    }
+    size_t get_num_threads() const noexcept
+    {
+        return m_num_threads;
+    }
+    // The number of threads the query is currently evaluated by. This is 1 unless the table is
+    // frozen and has enough cluster leaves to give each thread a share worth the startup cost.
+    size_t get_num_workers() const
+    {
+        size_t num_leaves = 0;
+        return parallel_worker_count(num_leaves);
+    }
 
     const ConstTableRef& get_table() const noexcept
     {
@@ -300,6 +309,11 @@ public:
     }
     void get_outside_versions(TableVersions&) const;
 
+    // True if the query follows links or backlinks, even if they lead back to
+    // its own table, so that whether an object matches can depend on other
+    // objects.
+    bool has_link_dependencies() const;
+
     // True if matching rows are guaranteed to be returned in table order.
     bool produces_results_in_table_order() const
     {
@@ -363,11 +377,23 @@ private:
     void aggregate(QueryStateBase& st, ColKey column_key) const;
 
     size_t find_best_node(ParentNode* pn) const;
+    const IndexEvaluator* take_index_conditions(ParentNode* pn, size_t best, std::vector<ObjKey>& storage,
+                                                IndexEvaluator& combined) const;
     void aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                             ArrayPayload* source_column) const;
 
     void do_find_all(QueryStateBase& st) const;
+    // Append up to 'count' matches among the objects with a key not less than 'begin' to 'keys', in table order.
+    // Returns the key to continue from, or a null key when there are no more objects to search.
+    ObjKey do_find_more(std::vector<ObjKey>& keys, ObjKey begin, size_t count) const;
     size_t do_count(size_t limit = size_t(-1)) const;
+
+    size_t parallel_worker_count(size_t& num_leaves) const;
+    void run_parallel(std::vector<std::unique_ptr<QueryStateBase>>& states, size_t num_leaves,
+                      ColKey column_key = {},
+                      const std::function<std::unique_ptr<ArrayPayload>()>& make_leaf = nullptr) const;
+    void traverse_leaves(QueryStateBase& st, size_t begin_leaf, size_t end_leaf, ColKey column_key,
+                         ArrayPayload* source_column) const;
     void delete_nodes() noexcept;
 
     ParentNode* root_node() const
@@ -406,6 +432,7 @@ private:
     TableView* m_source_table_view = nullptr; // table views are not refcounted, and not owned by the query.
     std::unique_ptr<TableView> m_owned_source_table_view; // <--- except when indicated here
     util::bind_ptr<DescriptorOrdering> m_ordering;
+    size_t m_num_threads = 1;
 };
 
 // Implementation:
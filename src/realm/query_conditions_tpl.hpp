@@ -67,6 +67,16 @@ public:
     {
         return m_state.items_counted();
     }
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateSum>(m_limit);
+    }
+    void combine(const QueryStateBase& partial) final
+    {
+        auto& other = static_cast<const QueryStateSum&>(partial);
+        m_state.combine(other.m_state);
+        m_match_count += other.m_match_count;
+    }
 
 private:
     aggregate_operations::Sum<typename util::RemoveOptional<T>::type> m_state;
@@ -110,6 +120,13 @@ public:
     {
         return m_state.is_null() ? Mixed() : m_state.result();
     }
+    void combine(const QueryStateBase& partial) final
+    {
+        auto& other = static_cast<const QueryStateMinMax&>(partial);
+        if (m_state.combine(other.m_state))
+            m_minmax_key = other.m_minmax_key;
+        m_match_count += other.m_match_count;
+    }
 
 private:
     State<typename util::RemoveOptional<R>::type> m_state;
@@ -119,12 +136,20 @@ template <class R>
 class QueryStateMin : public QueryStateMinMax<R, aggregate_operations::Minimum> {
 public:
     using QueryStateMinMax<R, aggregate_operations::Minimum>::QueryStateMinMax;
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateMin>(this->m_limit);
+    }
 };
 
 template <class R>
 class QueryStateMax : public QueryStateMinMax<R, aggregate_operations::Maximum> {
 public:
     using QueryStateMinMax<R, aggregate_operations::Maximum>::QueryStateMinMax;
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateMax>(this->m_limit);
+    }
 };
 
 template <class Target>
@@ -50,8 +50,11 @@ void LinkMap::set_base_table(ConstTableRef table)
 
 void LinkMap::collect_dependencies(std::vector<TableKey>& tables) const
 {
-    for (auto& t : m_tables) {
-        TableKey k = t->get_key();
+    // The base table is either the table of the query, or reached through the
+    // links of an enclosing subquery, so only the tables reached through our
+    // own links are collected
+    for (auto it = m_tables.begin() + (m_tables.empty() ? 0 : 1); it != m_tables.end(); ++it) {
+        TableKey k = (*it)->get_key();
         if (find(tables.begin(), tables.end(), k) == tables.end()) {
             tables.push_back(k);
         }
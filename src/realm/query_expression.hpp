@@ -88,6 +88,11 @@ Value<T> containing 8 values representing table rows i...i + 7.
 So Value<T> contains 8 concecutive values and all operations are based on these chunks. This is
 to save overhead by virtual calls needed for evaluating a query that has been dynamically constructed at runtime.
 
+Expressions made only of non-link Int, Float and Double columns, numeric constants and arithmetic operators can
+furthermore be evaluated through evaluate_batch(), which fills a BatchValues with up to BatchValues::max_size
+consecutive rows of the current cluster as plain int64_t or double values. Compare then runs typed loops over
+the two batches, falling back to QueryValue comparison only for the rows involving nulls or NaNs.
+
 
 Memory allocation:
 -----------------------------------------------------------------------------------------------------------------------
@@ -177,6 +182,11 @@ struct Plus {
     {
         return v1 + v2;
     }
+    template <class T>
+    static T apply(T v1, T v2)
+    {
+        return v1 + v2;
+    }
     static std::string description()
     {
         return "+";
@@ -188,6 +198,11 @@ struct Minus {
     {
         return v1 - v2;
     }
+    template <class T>
+    static T apply(T v1, T v2)
+    {
+        return v1 - v2;
+    }
     static std::string description()
     {
         return "-";
@@ -199,6 +214,16 @@ struct Div {
     {
         return v1 / v2;
     }
+    template <class T>
+    static T apply(T v1, T v2)
+    {
+        if constexpr (std::is_integral_v<T>) {
+            // Same as Mixed::operator/()
+            if (v2 == 0)
+                return v1 < 0 ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+        }
+        return v1 / v2;
+    }
     static std::string description()
     {
         return "/";
@@ -210,6 +235,11 @@ struct Mul {
     {
         return v1 * v2;
     }
+    template <class T>
+    static T apply(T v1, T v2)
+    {
+        return v1 * v2;
+    }
     static std::string description()
     {
         return "*";
@@ -643,6 +673,133 @@ private:
     }
 };
 
+// Values of a plain numeric expression for a range of consecutive rows in a cluster. Int values are kept in
+// `ints`, Float and Double values in `doubles` (a float converts to double exactly, and arithmetic on Float
+// operands is done in float precision, like Mixed does). `nulls` is only meaningful if `has_nulls` is set.
+struct BatchValues {
+    static constexpr size_t max_size = 128;
+
+    DataType type = type_Int;
+    size_t size = 0;
+    bool has_nulls = false;
+    int64_t ints[max_size];
+    double doubles[max_size];
+    bool nulls[max_size];
+
+    bool is_null(size_t ndx) const
+    {
+        return has_nulls && nulls[ndx];
+    }
+
+    QueryValue get(size_t ndx) const
+    {
+        if (is_null(ndx))
+            return {};
+        if (type == type_Int)
+            return ints[ndx];
+        if (type == type_Float)
+            return float(doubles[ndx]);
+        return doubles[ndx];
+    }
+
+    void fill(const Mixed& value, size_t n)
+    {
+        REALM_ASSERT_DEBUG(value.is_type(type_Int, type_Float, type_Double));
+        size = n;
+        has_nulls = false;
+        type = value.get_type();
+        if (type == type_Int) {
+            std::fill(ints, ints + n, value.get_int());
+        }
+        else {
+            std::fill(doubles, doubles + n, value.export_to_type<double>());
+        }
+    }
+
+    // Convert the values to `to`, which must be the same or a wider type
+    void promote(DataType to)
+    {
+        if (type == type_Int && to != type_Int) {
+            for (size_t i = 0; i < size; ++i)
+                doubles[i] = to == type_Float ? double(float(ints[i])) : double(ints[i]);
+        }
+        type = to;
+    }
+
+    // *this = *this `TOperator` right
+    template <class TOperator>
+    void apply(BatchValues& right)
+    {
+        REALM_ASSERT_DEBUG(size == right.size);
+        if (right.has_nulls) {
+            for (size_t i = 0; i < size; ++i)
+                nulls[i] = is_null(i) || right.nulls[i];
+            has_nulls = true;
+        }
+
+        // Same promotion as Mixed arithmetic: Int < Float < Double
+        DataType common = std::max(type, right.type);
+        promote(common);
+        right.promote(common);
+        if (common == type_Int) {
+            for (size_t i = 0; i < size; ++i)
+                ints[i] = TOperator::apply(ints[i], right.ints[i]);
+        }
+        else if (common == type_Float) {
+            for (size_t i = 0; i < size; ++i)
+                doubles[i] = TOperator::apply(float(doubles[i]), float(right.doubles[i]));
+        }
+        else {
+            for (size_t i = 0; i < size; ++i)
+                doubles[i] = TOperator::apply(doubles[i], right.doubles[i]);
+        }
+    }
+
+    // Set matches[i] to whether row i matches `TCond`. The result is the same as comparing the QueryValues.
+    template <class TCond>
+    static void compare(const BatchValues& left, const BatchValues& right, bool* matches)
+    {
+        REALM_ASSERT_DEBUG(left.size == right.size);
+        TCond c;
+        const size_t n = left.size;
+        if (left.type == type_Int && right.type == type_Int) {
+            for (size_t i = 0; i < n; ++i)
+                matches[i] = c(left.ints[i], right.ints[i]);
+        }
+        else if (left.type != type_Int && right.type != type_Int) {
+            for (size_t i = 0; i < n; ++i) {
+                double a = left.doubles[i];
+                double b = right.doubles[i];
+                // NaNs have a defined order in Mixed
+                matches[i] = (std::isnan(a) || std::isnan(b)) ? c(left.get(i), right.get(i)) : c(a, b);
+            }
+        }
+        else {
+            // Integers with a magnitude above 2^53 do not convert to double exactly
+            constexpr int64_t precise_limit = int64_t(1) << 53;
+            const bool left_is_int = left.type == type_Int;
+            const int64_t* ints = left_is_int ? left.ints : right.ints;
+            const double* doubles = left_is_int ? right.doubles : left.doubles;
+            for (size_t i = 0; i < n; ++i) {
+                int64_t a = ints[i];
+                double b = doubles[i];
+                if (a > precise_limit || a < -precise_limit || std::isnan(b)) {
+                    matches[i] = c(left.get(i), right.get(i));
+                }
+                else {
+                    matches[i] = left_is_int ? c(double(a), b) : c(b, double(a));
+                }
+            }
+        }
+        if (left.has_nulls || right.has_nulls) {
+            for (size_t i = 0; i < n; ++i) {
+                if (left.is_null(i) || right.is_null(i))
+                    matches[i] = c(left.get(i), right.get(i));
+            }
+        }
+    }
+};
+
 class Expression {
 public:
     virtual ~Expression() = default;
@@ -774,6 +931,18 @@ public:
 
     virtual void evaluate(Subexpr::Index& index, ValueBase& destination) = 0;
 
+    // True if evaluate_batch() can be used, which is the case for plain numeric expressions
+    virtual bool has_batch_evaluation() const
+    {
+        return false;
+    }
+
+    // Load the values of rows [start, start + n) of the current cluster into destination
+    virtual void evaluate_batch(size_t, size_t, BatchValues&)
+    {
+        REALM_UNREACHABLE();
+    }
+
     virtual Mixed get_mixed() const
     {
         return {};
@@ -1361,6 +1530,16 @@ public:
         destination = *this;
     }
 
+    bool has_batch_evaluation() const override
+    {
+        return !m_from_list && size() == 1 && get(0).is_type(type_Int, type_Float, type_Double);
+    }
+
+    void evaluate_batch(size_t, size_t n, BatchValues& destination) override
+    {
+        destination.fill(get(0), n);
+    }
+
     std::unique_ptr<Subexpr> clone() const override
     {
         return make_subexpr<Value<T>>(*this);
@@ -3979,6 +4158,56 @@ public:
         }
     }
 
+    bool has_batch_evaluation() const override
+    {
+        return realm::is_any_v<T, int64_t, float, double> && !links_exist();
+    }
+
+    void evaluate_batch(size_t start, size_t n, BatchValues& destination) override
+    {
+        REALM_ASSERT_DEBUG(n <= BatchValues::max_size);
+        destination.size = n;
+        if constexpr (std::is_same_v<T, int64_t>) {
+            destination.type = type_Int;
+            if (is_nullable()) {
+                auto leaf = mpark::get_if<NullableLeafType>(&m_leaf);
+                REALM_ASSERT(leaf);
+                for (size_t i = 0; i < n; ++i) {
+                    auto val = leaf->get(start + i);
+                    destination.nulls[i] = !val;
+                    destination.ints[i] = val.value_or(0);
+                }
+                destination.has_nulls = true;
+            }
+            else {
+                auto leaf = mpark::get_if<LeafType>(&m_leaf);
+                REALM_ASSERT(leaf);
+                // max_size is a multiple of 8, so get_chunk() never writes past the end of ints
+                static_assert(BatchValues::max_size % 8 == 0);
+                for (size_t i = 0; i < n; i += 8)
+                    leaf->get_chunk(start + i, destination.ints + i);
+                destination.has_nulls = false;
+            }
+        }
+        else if constexpr (realm::is_any_v<T, float, double>) {
+            destination.type = std::is_same_v<T, float> ? type_Float : type_Double;
+            auto leaf = mpark::get_if<LeafType>(&m_leaf);
+            REALM_ASSERT(leaf);
+            bool has_nulls = false;
+            for (size_t i = 0; i < n; ++i) {
+                bool is_null = leaf->is_null(start + i);
+                destination.nulls[i] = is_null;
+                destination.doubles[i] = is_null ? 0.0 : double(leaf->get(start + i));
+                has_nulls |= is_null;
+            }
+            destination.has_nulls = has_nulls;
+        }
+        else {
+            static_cast<void>(start);
+            REALM_UNREACHABLE();
+        }
+    }
+
     void evaluate(ObjKey key, ValueBase& destination)
     {
         destination.init(false, 1);
@@ -4387,6 +4616,19 @@ public:
         destination = result;
     }
 
+    bool has_batch_evaluation() const override
+    {
+        return m_left->has_batch_evaluation() && m_right->has_batch_evaluation();
+    }
+
+    void evaluate_batch(size_t start, size_t n, BatchValues& destination) override
+    {
+        BatchValues right;
+        m_left->evaluate_batch(start, n, destination);
+        m_right->evaluate_batch(start, n, right);
+        destination.template apply<oper>(right);
+    }
+
     std::string description(util::serializer::SerialisationState& state) const override
     {
         std::string s = "(";
@@ -4455,6 +4697,7 @@ public:
         else {
             m_left->set_cluster(cluster);
             m_right->set_cluster(cluster);
+            m_batch_end = 0;
         }
     }
 
@@ -4540,6 +4783,13 @@ protected:
     std::vector<ObjKey> m_matches;
     mutable size_t m_index_get = 0;
     size_t m_index_end = 0;
+
+    // Batch evaluation. Rows [m_batch_begin, m_batch_end) of the current cluster have been compared, with
+    // the results in m_batch_matches, so that consecutive calls to find_first() do not redo the work.
+    bool m_use_batch = false;
+    mutable size_t m_batch_begin = 0;
+    mutable size_t m_batch_end = 0;
+    mutable bool m_batch_matches[BatchValues::max_size];
 };
 
 template <class TCond>
@@ -4550,6 +4800,9 @@ public:
     double init() override
     {
         double dT = 50.0;
+        m_use_batch = realm::is_any_v<TCond, Equal, NotEqual, Greater, Less, GreaterEqual, LessEqual> &&
+                      m_left->has_batch_evaluation() && m_right->has_batch_evaluation();
+        m_batch_end = 0;
         if ((m_left->has_single_value()) || (m_right->has_single_value())) {
             dT = 10.0;
             if constexpr (std::is_same_v<TCond, Equal>) {
@@ -4613,6 +4866,11 @@ public:
         if (m_has_matches) {
             return find_first_with_matches(start, end);
         }
+        if constexpr (realm::is_any_v<TCond, Equal, NotEqual, Greater, Less, GreaterEqual, LessEqual>) {
+            if (m_use_batch) {
+                return find_first_batch(start, end);
+            }
+        }
 
         size_t match;
         ValueBase left_buf;
@@ -4649,6 +4907,30 @@ public:
         return not_found; // no match
     }
 
+    size_t find_first_batch(size_t start, size_t end) const
+    {
+        while (start < end) {
+            if (start < m_batch_begin || start >= m_batch_end) {
+                BatchValues left;
+                BatchValues right;
+                size_t n = std::min(end - start, BatchValues::max_size);
+                m_left->evaluate_batch(start, n, left);
+                m_right->evaluate_batch(start, n, right);
+                BatchValues::compare<TCond>(left, right, m_batch_matches);
+                m_batch_begin = start;
+                m_batch_end = start + n;
+            }
+            size_t stop = std::min(end, m_batch_end);
+            const bool* first = m_batch_matches + (start - m_batch_begin);
+            const bool* last = m_batch_matches + (stop - m_batch_begin);
+            const bool* match = std::find(first, last, true);
+            if (match != last)
+                return m_batch_begin + (match - m_batch_matches);
+            start = stop;
+        }
+        return not_found;
+    }
+
     std::string description(util::serializer::SerialisationState& state) const override
     {
         if constexpr (realm::is_any_v<TCond, BeginsWith, BeginsWithIns, EndsWith, EndsWithIns, Contains, ContainsIns,
@@ -19,8 +19,10 @@
 #ifndef REALM_QUERY_STATE_HPP
 #define REALM_QUERY_STATE_HPP
 
+#include <algorithm>
 #include <cstdlib> // size_t
 #include <cstdint> // unint8_t etc
+#include <memory>
 
 #include <realm/node.hpp>
 
@@ -60,6 +62,16 @@ public:
         return false;
     }
 
+    // Support for parallel query evaluation. make_partial() returns an empty state
+    // of the same kind which collects the matches found in one part of the table,
+    // or null if this state cannot be split. Partial states are folded back into
+    // this state with combine() in table order.
+    virtual std::unique_ptr<QueryStateBase> make_partial() const
+    {
+        return nullptr;
+    }
+    virtual void combine(const QueryStateBase&) {}
+
     inline size_t match_count() const noexcept
     {
         return m_match_count;
@@ -104,6 +116,14 @@ public:
     {
         return m_match_count;
     }
+    std::unique_ptr<QueryStateBase> make_partial() const final
+    {
+        return std::make_unique<QueryStateCount>(m_limit);
+    }
+    void combine(const QueryStateBase& partial) final
+    {
+        m_match_count = std::min(m_match_count + partial.match_count(), m_limit);
+    }
 };
 
 } // namespace realm
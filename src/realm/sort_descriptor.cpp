@@ -316,25 +316,15 @@ void SortDescriptor::execute(IndexPairs& v, const Sorter& predicate, const BaseD
     if (next && next->get_type() == DescriptorType::Limit) {
         limit = static_cast<const LimitDescriptor*>(next)->get_limit();
     }
-    // Measurements shows that if limit is smaller than size / 16, then
-    // it is quicker to make a sorted insert into a smaller vector
-    if (limit < (v.size() >> 4)) {
-        IndexPairs buffer;
-        buffer.reserve(limit + 1);
-        for (auto& elem : v) {
-            auto it = std::lower_bound(buffer.begin(), buffer.end(), elem, std::ref(predicate));
-            buffer.insert(it, elem);
-            if (buffer.size() > limit) {
-                buffer.pop_back();
-            }
-        }
+    if (limit < v.size()) {
+        // Only the first 'limit' elements survive, so partition those to the front in
+        // linear time and only sort them. The predicate is a total ordering, which makes
+        // the result the same as sorting everything and truncating.
+        std::nth_element(v.begin(), v.begin() + limit, v.end(), std::ref(predicate));
         v.m_removed_by_limit += v.size() - limit;
         v.erase(v.begin() + limit, v.end());
-        std::move(buffer.begin(), buffer.end(), v.begin());
-    }
-    else {
-        std::sort(v.begin(), v.end(), std::ref(predicate));
     }
+    std::sort(v.begin(), v.end(), std::ref(predicate));
 
     // not doing this on the last step is an optimisation
     if (next) {
@@ -689,6 +689,14 @@ void parse_changeset(util::InputStream& input, Changeset& out_log)
         state.parse_one();
 }
 
+void parse_changeset(util::InputStream& input, InstructionHandler& handler)
+{
+    State state{input, handler};
+
+    while (state.has_next())
+        state.parse_one();
+}
+
 OwnedMixed parse_base64_encoded_primary_key(std::string_view str)
 {
     auto bin_encoded = util::base64_decode_to_vector(str);
@@ -9,6 +9,10 @@
 namespace realm::sync {
 void parse_changeset(util::InputStream&, Changeset& out_log);
 
+// Parse a changeset and pass each instruction to the handler as soon as it has
+// been decoded, without building a Changeset.
+void parse_changeset(util::InputStream&, InstructionHandler&);
+
 // The server may send us primary keys of objects in json-encoded error messages as base64-encoded changeset payloads.
 // This function takes such a base64-encoded payload and returns it parsed as an owned Mixed value. If it cannot
 // be decoded, this throws a BadChangeset exception.
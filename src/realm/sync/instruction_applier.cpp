@@ -1,4 +1,5 @@
 #include <realm/sync/instruction_applier.hpp>
+#include <realm/sync/changeset_parser.hpp>
 #include <realm/set.hpp>
 #include <realm/util/scope_exit.hpp>
 
@@ -68,6 +69,50 @@ REALM_NORETURN void InstructionApplier::bad_transaction_log(const char* msg, Par
     bad_transaction_log(util::format(msg, std::forward<Params>(params)...));
 }
 
+void InstructionApplier::parse_and_apply(util::InputStream& in, Changeset& log)
+{
+    struct Handler final : InstructionHandler {
+        InstructionApplier& applier;
+        Changeset& log;
+        // The end of the interned strings in the string buffer of `log`.
+        // Anything after that belongs to the instruction being parsed.
+        size_t interned_strings_end = 0;
+
+        Handler(InstructionApplier& a, Changeset& l)
+            : applier(a)
+            , log(l)
+        {
+        }
+
+        void set_intern_string(uint32_t index, StringBufferRange range) override
+        {
+            InternStrings& strings = log.interned_strings();
+            REALM_ASSERT(index == strings.size());
+            strings.push_back(range); // Throws
+            interned_strings_end = log.string_buffer().size();
+        }
+
+        StringBufferRange add_string_range(StringData string) override
+        {
+            return log.append_string(string); // Throws
+        }
+
+        void operator()(const Instruction& instr) override
+        {
+            instr.visit(applier); // Throws
+            log.string_buffer().resize(interned_strings_end);
+        }
+    };
+
+    log.clear();
+    log.interned_strings().clear();
+    log.string_buffer().clear();
+    Handler handler{*this, log};
+    begin_apply(log);
+    parse_changeset(in, handler); // Throws
+    end_apply();
+}
+
 StringData InstructionApplier::get_string(InternString str) const
 {
     auto string = m_log->try_get_intern_string(str);
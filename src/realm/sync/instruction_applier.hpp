@@ -42,6 +42,17 @@ struct InstructionApplier {
     /// BadChangesetError.
     void apply(const Changeset&);
 
+    /// Parse the changeset in the input stream and apply each instruction as
+    /// soon as it has been decoded, without building the list of
+    /// instructions. \a log supplies the metadata of the changeset (version,
+    /// origin) for error messages, and holds its interned strings; any
+    /// instructions and strings it contains are discarded. The strings in the
+    /// payload of an instruction are only kept until it has been applied, so
+    /// memory usage does not grow with the size of the changeset.
+    ///
+    /// Throws BadChangesetError if parsing or application fails.
+    void parse_and_apply(util::InputStream&, Changeset& log);
+
     void begin_apply(const Changeset&) noexcept;
     void end_apply() noexcept;
 
@@ -18,7 +18,7 @@ namespace {
 class DefaultWebSocketImpl final : public DefaultWebSocket, public Config {
 public:
     DefaultWebSocketImpl(const std::shared_ptr<util::Logger>& logger_ptr, network::Service& service,
-                         std::mt19937_64& random, const std::string user_agent,
+                         std::mt19937_64& random, const std::string user_agent, const Options& websocket_options,
                          std::unique_ptr<WebSocketObserver> observer, WebSocketEndpoint&& endpoint)
         : m_logger_ptr{logger_ptr}
         , m_network_logger{*m_logger_ptr}
@@ -27,7 +27,7 @@ public:
         , m_user_agent{user_agent}
         , m_observer{std::move(observer)}
         , m_endpoint{std::move(endpoint)}
-        , m_websocket(*this)
+        , m_websocket(*this, websocket_options)
     {
         initiate_resolve();
     }
@@ -476,10 +476,11 @@ void DefaultWebSocketImpl::initiate_websocket_handshake()
 DefaultSocketProvider::DefaultSocketProvider(const std::shared_ptr<util::Logger>& logger,
                                              const std::string& user_agent,
                                              const std::shared_ptr<BindingCallbackThreadObserver>& observer_ptr,
-                                             AutoStart auto_start)
+                                             AutoStart auto_start, const Options& websocket_options)
     : m_logger_ptr{std::make_shared<util::CategoryLogger>(util::LogCategory::network, logger)}
     , m_observer_ptr{observer_ptr}
     , m_user_agent{user_agent}
+    , m_websocket_options{websocket_options}
     , m_state{State::Stopped}
 {
     REALM_ASSERT(m_logger_ptr);                     // Make sure the logger is valid
@@ -640,7 +641,7 @@ std::unique_ptr<WebSocketInterface> DefaultSocketProvider::connect(std::unique_p
                                                                    WebSocketEndpoint&& endpoint)
 {
     return std::make_unique<DefaultWebSocketImpl>(m_logger_ptr, m_service, m_random, m_user_agent,
-                                                  std::move(observer), std::move(endpoint));
+                                                  m_websocket_options, std::move(observer), std::move(endpoint));
 }
 
 } // namespace realm::sync::websocket
@@ -5,6 +5,7 @@
 #include <realm/sync/socket_provider.hpp>
 #include <realm/sync/network/http.hpp>
 #include <realm/sync/network/network.hpp>
+#include <realm/sync/network/websocket.hpp>
 #include <realm/util/checked_mutex.hpp>
 #include <realm/util/future.hpp>
 #include <realm/util/tagged_bool.hpp>
@@ -47,9 +48,11 @@ public:
     };
 
     using AutoStart = util::TaggedBool<struct AutoStartTag>;
+    /// \a websocket_options selects the optional WebSocket features, such as
+    /// compression, which are used by the websockets created by connect().
     DefaultSocketProvider(const std::shared_ptr<util::Logger>& logger, const std::string& user_agent,
                           const std::shared_ptr<BindingCallbackThreadObserver>& observer_ptr = nullptr,
-                          AutoStart auto_start = AutoStart{true});
+                          AutoStart auto_start = AutoStart{true}, const Options& websocket_options = {});
 
     ~DefaultSocketProvider();
 
@@ -91,6 +94,7 @@ private:
     network::Service m_service;
     std::mt19937_64 m_random;
     const std::string m_user_agent;
+    const Options m_websocket_options;
     util::CheckedMutex m_mutex;
     uint64_t m_event_loop_generation = 0;
     State m_state GUARDED_BY(m_mutex);
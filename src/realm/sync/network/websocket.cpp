@@ -1,9 +1,13 @@
 #include <cctype>
+#include <deque>
+#include <set>
 
 #include <realm/sync/network/network.hpp>
 #include <realm/sync/network/websocket.hpp>
 #include <realm/util/buffer.hpp>
 #include <realm/util/base64.hpp>
+#include <realm/util/compression.hpp>
+#include <realm/util/scope_exit.hpp>
 #include <realm/util/sha_crypto.hpp>
 
 using namespace realm;
@@ -129,8 +133,158 @@ bool find_sec_websocket_key(const HTTPHeaders& headers, std::string& sec_websock
     return true;
 }
 
+// The parameters of the permessage-deflate extension (RFC 7692) which are
+// agreed on in the handshake.
+struct DeflateParams {
+    bool client_no_context_takeover = false;
+    bool server_no_context_takeover = false;
+    int client_max_window_bits = 15;
+    int server_max_window_bits = 15;
+};
+
+std::string_view trim_whitespace(std::string_view str)
+{
+    while (!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+        str.remove_prefix(1);
+    while (!str.empty() && (str.back() == ' ' || str.back() == '\t'))
+        str.remove_suffix(1);
+    return str;
+}
+
+// parse_window_bits() parses the value of the *_max_window_bits parameters,
+// which must be in the range [8, 15]. Zero is returned if it is not.
+int parse_window_bits(std::string_view value)
+{
+    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+        value = value.substr(1, value.size() - 2);
+    if (value.empty() || value.size() > 2)
+        return 0;
+    int bits = 0;
+    for (char ch : value) {
+        if (ch < '0' || ch > '9')
+            return 0;
+        bits = 10 * bits + (ch - '0');
+    }
+    return (bits >= 8 && bits <= 15) ? bits : 0;
+}
+
+// parse_permessage_deflate() parses one element of a Sec-WebSocket-Extensions
+// header, which is either an offer from the client (\a is_offer) or the
+// response from the server. None is returned if the element is not
+// permessage-deflate, or if its parameters are invalid or cannot be honored
+// by this implementation. zlib cannot make raw DEFLATE streams with a window
+// of 256 bytes, so a limit of 8 window bits on our own compressor is refused.
+util::Optional<DeflateParams> parse_permessage_deflate(std::string_view element, bool is_offer)
+{
+    size_t end = element.find(';');
+    if (trim_whitespace(element.substr(0, end)) != "permessage-deflate")
+        return none;
+
+    DeflateParams params;
+    std::set<std::string_view> seen_names;
+    while (end != std::string_view::npos) {
+        element.remove_prefix(end + 1);
+        end = element.find(';');
+        std::string_view param = element.substr(0, end);
+        size_t equal_sign = param.find('=');
+        std::string_view name = trim_whitespace(param.substr(0, equal_sign));
+        bool has_value = (equal_sign != std::string_view::npos);
+        std::string_view value = has_value ? trim_whitespace(param.substr(equal_sign + 1)) : std::string_view{};
+
+        // A parameter must not be repeated
+        if (!seen_names.insert(name).second)
+            return none;
+
+        if (name == "client_no_context_takeover" && !has_value) {
+            params.client_no_context_takeover = true;
+        }
+        else if (name == "server_no_context_takeover" && !has_value) {
+            params.server_no_context_takeover = true;
+        }
+        else if (name == "server_max_window_bits") {
+            params.server_max_window_bits = parse_window_bits(value);
+            if (params.server_max_window_bits == 0)
+                return none;
+        }
+        else if (name == "client_max_window_bits") {
+            // In an offer, the value is optional, and only tells that the
+            // client supports the parameter. The window of the client is of no
+            // concern to the server, as it always decompresses with the
+            // largest window.
+            if (is_offer)
+                continue;
+            params.client_max_window_bits = parse_window_bits(value);
+            if (params.client_max_window_bits == 0)
+                return none;
+        }
+        else {
+            return none;
+        }
+    }
+
+    int own_window_bits = (is_offer ? params.server_max_window_bits : params.client_max_window_bits);
+    if (own_window_bits < 9)
+        return none;
+    return params;
+}
+
+// format_permessage_deflate() formats \a params as a
+// Sec-WebSocket-Extensions header value accepting permessage-deflate.
+std::string format_permessage_deflate(const DeflateParams& params)
+{
+    std::string str = "permessage-deflate";
+    if (params.client_no_context_takeover)
+        str += "; client_no_context_takeover";
+    if (params.server_no_context_takeover)
+        str += "; server_no_context_takeover";
+    if (params.client_max_window_bits != 15)
+        str += "; client_max_window_bits=" + std::to_string(params.client_max_window_bits);
+    if (params.server_max_window_bits != 15)
+        str += "; server_max_window_bits=" + std::to_string(params.server_max_window_bits);
+    return str;
+}
+
+// make_permessage_deflate_offer() returns the Sec-WebSocket-Extensions header
+// value with which the client offers permessage-deflate.
+std::string make_permessage_deflate_offer(const websocket::Options& options)
+{
+    std::string str = "permessage-deflate; client_max_window_bits";
+    if (!options.deflate_context_takeover)
+        str += "; client_no_context_takeover; server_no_context_takeover";
+    return str;
+}
+
+// negotiate_permessage_deflate() returns the parameters of the first offer of
+// permessage-deflate in the request \a headers which the server can accept,
+// or None if there is none.
+util::Optional<DeflateParams> negotiate_permessage_deflate(const HTTPHeaders& headers,
+                                                           const websocket::Options& options)
+{
+    util::Optional<StringData> header_value = find_http_header_value(headers, "Sec-WebSocket-Extensions");
+    if (!header_value)
+        return none;
+
+    std::string_view offers{header_value->data(), header_value->size()};
+    for (;;) {
+        size_t end = offers.find(',');
+        if (util::Optional<DeflateParams> params = parse_permessage_deflate(offers.substr(0, end), true)) {
+            // The server may ask for no context takeover in both directions
+            // regardless of what the client offered
+            if (!options.deflate_context_takeover) {
+                params->client_no_context_takeover = true;
+                params->server_no_context_takeover = true;
+            }
+            return params;
+        }
+        if (end == std::string_view::npos)
+            return none;
+        offers.remove_prefix(end + 1);
+    }
+}
+
 util::Optional<HTTPResponse> do_make_http_response(const HTTPRequest& request,
-                                                   const std::string& sec_websocket_protocol, std::error_code& ec)
+                                                   const std::string& sec_websocket_protocol,
+                                                   const websocket::Options& options, std::error_code& ec)
 {
     std::string sec_websocket_key;
 
@@ -163,6 +317,11 @@ util::Optional<HTTPResponse> do_make_http_response(const HTTPRequest& request,
     response.headers["Sec-WebSocket-Accept"] = sec_websocket_accept;
     response.headers["Sec-WebSocket-Protocol"] = sec_websocket_protocol;
 
+    if (options.permessage_deflate) {
+        if (util::Optional<DeflateParams> params = negotiate_permessage_deflate(request.headers, options))
+            response.headers["Sec-WebSocket-Extensions"] = format_permessage_deflate(*params);
+    }
+
     return response;
 }
 
@@ -178,6 +337,8 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
 // \param fin indicates whether the frame is the final fragment in a message.
 // Sync clients and servers will only send unfragmented messages, but they must be
 // prepared to receive fragmented messages.
+// \param compressed sets the RSV1 bit, which marks the payload as compressed
+// by the permessage-deflate extension.
 // \param opcode must be one of six values:
 // 0  = continuation frame
 // 1  = text frame
@@ -194,8 +355,8 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
 // The frame size can at most be payload_size + 14.
 // \param random is used to create a random masking key.
 // The return value is the size of the frame.
-size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t payload_size, char* output,
-                  std::mt19937_64& random)
+size_t make_frame(bool fin, bool compressed, int opcode, bool mask, const char* payload, size_t payload_size,
+                  char* output, std::mt19937_64& random)
 {
     int index = 0; // used to keep track of position within the header.
     using uchar = unsigned char;
@@ -227,6 +388,8 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
         }
         index = 10;
     }
+    if (compressed)
+        output[0] += 64; // rsv1 is the second bit of the first byte.
     if (mask) {
         char masking_key[4];
         std::uniform_int_distribution<> dis(0, 255);
@@ -267,6 +430,8 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
 //     // frame_reader.delivery_size
 //     // with opcode (type)
 //     // frame_reader.delivery_opcode
+//     // which must be decompressed if
+//     // frame_reader.delivery_compressed
 // }
 // else {
 //    // read frame_reader.read_size
@@ -286,8 +451,13 @@ public:
     char* read_buffer = nullptr;
     bool protocol_error = false;
     bool delivery_ready = false;
+    bool delivery_compressed = false;
     websocket::Opcode delivery_opcode = websocket::Opcode::continuation;
 
+    // Set when the permessage-deflate extension is in use, which allows the
+    // first frame of text and binary messages to have the rsv1 bit set.
+    bool permessage_deflate = false;
+
     FrameReader(util::Logger& logger, bool& is_client)
         : logger(logger)
         , m_is_client(is_client)
@@ -346,6 +516,9 @@ private:
     // The opcode of the message.
     websocket::Opcode m_message_opcode = websocket::Opcode::continuation;
 
+    // Whether the payload of the message is compressed.
+    bool m_message_compressed = false;
+
     // The size of the stored Websocket message.
     // This size is not the same as the size of the buffer.
     size_t m_message_size = 0;
@@ -386,6 +559,7 @@ private:
         if (m_message_buffer.size() != s_message_buffer_min_size)
             m_message_buffer.resize(s_message_buffer_min_size);
         m_message_opcode = websocket::Opcode::continuation;
+        m_message_compressed = false;
         m_message_size = 0;
     }
 
@@ -397,6 +571,7 @@ private:
     {
         protocol_error = false;
         delivery_ready = false;
+        delivery_compressed = false;
         delivery_buffer = nullptr;
         delivery_size = 0;
         delivery_opcode = websocket::Opcode::continuation;
@@ -416,8 +591,6 @@ private:
 
         // bit 2,3, and 4.
         char rsv = (header_buffer[0] & 112) >> 4;
-        if (rsv != 0)
-            return set_protocol_error();
 
         // bit 5, 6, 7, and 8.
         char op = (header_buffer[0] & 15);
@@ -427,6 +600,13 @@ private:
 
         m_opcode = websocket::Opcode(op);
 
+        // rsv1 marks the first frame of a compressed message when
+        // permessage-deflate is in use. Other bits are never set.
+        bool rsv1 = (rsv == 4);
+        if (rsv != 0 && !(rsv1 && permessage_deflate &&
+                          (m_opcode == websocket::Opcode::text || m_opcode == websocket::Opcode::binary)))
+            return set_protocol_error();
+
         // bit 9.
         m_mask = ((header_buffer[1] & 128) == 128);
         if ((m_mask && m_is_client) || (!m_mask && !m_is_client))
@@ -444,6 +624,7 @@ private:
                 return set_protocol_error();
 
             m_message_opcode = m_opcode;
+            m_message_compressed = rsv1;
         }
         else { // close, ping, pong.
             if (!m_fin || m_short_payload_size > 125)
@@ -527,6 +708,7 @@ private:
             m_opcode == websocket::Opcode::pong) {
             m_stage = Stage::delivery;
             delivery_ready = true;
+            delivery_compressed = false;
             delivery_opcode = m_opcode;
             delivery_buffer = control_buffer;
             delivery_size = m_payload_size;
@@ -536,6 +718,7 @@ private:
             if (m_fin) {
                 m_stage = Stage::delivery;
                 delivery_ready = true;
+                delivery_compressed = m_message_compressed;
                 delivery_opcode = m_message_opcode;
                 delivery_buffer = m_message_buffer.data();
                 delivery_size = m_message_size;
@@ -554,6 +737,7 @@ private:
         read_buffer = header_buffer;
         read_size = 2;
         delivery_ready = false;
+        delivery_compressed = false;
         delivery_buffer = nullptr;
         delivery_size = 0;
         delivery_opcode = websocket::Opcode::continuation;
@@ -567,8 +751,9 @@ private:
 
 class WebSocket {
 public:
-    WebSocket(websocket::Config& config)
+    WebSocket(websocket::Config& config, const websocket::Options& options)
         : m_config(config)
+        , m_options(options)
         , m_logger_ptr(config.websocket_get_logger())
         , m_logger{*m_logger_ptr}
         , m_frame_reader(m_logger, m_is_client)
@@ -576,6 +761,12 @@ public:
         m_logger.debug(util::LogCategory::network, "WebSocket::Websocket()");
     }
 
+    ~WebSocket() noexcept
+    {
+        if (m_destroyed)
+            *m_destroyed = true;
+    }
+
     void initiate_client_handshake(const std::string& request_uri, const std::string& host,
                                    const std::string& sec_websocket_protocol, HTTPHeaders headers)
     {
@@ -588,6 +779,7 @@ public:
 
         m_http_client.reset(new HTTPClient<websocket::Config>(m_config, m_logger_ptr));
         m_frame_reader.reset();
+        disable_extensions();
 
         if (m_test_handshake_response) {
             HTTPResponse test_response;
@@ -609,6 +801,8 @@ public:
         req.headers["Sec-WebSocket-Key"] = m_sec_websocket_key;
         req.headers["Sec-WebSocket-Version"] = sec_websocket_version;
         req.headers["Sec-WebSocket-Protocol"] = sec_websocket_protocol;
+        if (m_options.permessage_deflate)
+            req.headers["Sec-WebSocket-Extensions"] = make_permessage_deflate_offer(m_options);
 
         m_logger.trace(util::LogCategory::network, "HTTP request =\n%1", req);
 
@@ -636,11 +830,16 @@ public:
         m_http_client->async_request(req, std::move(handler));
     }
 
-    void initiate_server_websocket_after_handshake()
+    void initiate_server_websocket_after_handshake(std::string_view sec_websocket_extensions)
     {
         m_stopped = false;
         m_is_client = false;
         m_frame_reader.reset();
+        disable_extensions();
+        if (!sec_websocket_extensions.empty()) {
+            bool valid = enable_extensions(sec_websocket_extensions); // Throws
+            REALM_ASSERT(valid);
+        }
         frame_reader_loop(); // Throws
     }
 
@@ -652,6 +851,7 @@ public:
         m_is_client = false;
         m_http_server.reset(new HTTPServer<websocket::Config>(m_config, m_logger_ptr));
         m_frame_reader.reset();
+        disable_extensions();
 
         auto handler = [this](HTTPRequest request, std::error_code ec) {
             if (ec != util::error::operation_aborted) {
@@ -680,13 +880,30 @@ public:
 
         bool mask = m_is_client;
 
+        // Only unfragmented messages are compressed
+        bool compressed = false;
+        bool is_data = (opcode == int(websocket::Opcode::text) || opcode == int(websocket::Opcode::binary));
+        if (m_deflater && fin && is_data && size >= m_options.deflate_min_message_size) {
+            compressed = compress_message(data, size); // Throws
+            if (compressed) {
+                data = m_deflate_buffer.data();
+                size = m_deflate_buffer.size();
+            }
+        }
+
+        if (m_options.coalesce_writes) {
+            queue_frame(fin, compressed, opcode, mask, data, size, std::move(write_completion_handler)); // Throws
+            return;
+        }
+
         // 14 is the maximum header length of a Websocket frame.
         size_t required_size = size + 14;
         if (m_write_buffer.size() < required_size)
             m_write_buffer.resize(required_size);
 
-        size_t message_size =
-            make_frame(fin, opcode, mask, data, size, m_write_buffer.data(), m_config.websocket_get_random());
+        size_t message_size = make_frame(fin, compressed, opcode, mask, data, size, m_write_buffer.data(),
+                                         m_config.websocket_get_random());
+        release_deflate_buffer();
 
         auto handler = [this, handler = std::move(write_completion_handler)](std::error_code ec, size_t) mutable {
             // If the operation is aborted, then the write operation was canceled and we should ignore this callback.
@@ -730,6 +947,8 @@ public:
     {
         m_stopped = true;
         m_frame_reader.reset();
+        m_queued_frames.clear();
+        m_queued_frame_handlers.clear();
     }
 
     void force_handshake_response_for_testing(int status_code, std::string body)
@@ -740,6 +959,7 @@ public:
 
 private:
     websocket::Config& m_config;
+    const websocket::Options m_options;
     const std::shared_ptr<util::Logger> m_logger_ptr;
     util::Logger& m_logger;
     FrameReader m_frame_reader;
@@ -755,11 +975,192 @@ private:
     std::string m_sec_websocket_accept;
 
     std::vector<char> m_write_buffer;
-    static const size_t s_write_buffer_stable_size = 2048;
+    static constexpr size_t s_write_buffer_stable_size = 2048;
+
+    // Present when the permessage-deflate extension is in use.
+    std::optional<util::compression::MessageDeflater> m_deflater;
+    std::optional<util::compression::MessageInflater> m_inflater;
+    bool m_deflate_no_context_takeover = false;
+    util::AppendBuffer<char> m_deflate_buffer;
+    util::AppendBuffer<char> m_inflate_buffer;
+    static const size_t s_deflate_buffer_stable_size = 16 * 1024;
+
+    // Used when writes are coalesced. m_queued_frames holds the frames which
+    // wait for the write in progress, and m_queued_frame_handlers the
+    // completion handlers of those of them which have not been called yet.
+    std::vector<char> m_queued_frames;
+    std::deque<websocket::WriteCompletionHandler> m_queued_frame_handlers;
+    bool m_write_in_progress = false;
+    bool m_calling_write_handlers = false;
+
+    // Points to a flag which is set if this object is destroyed while the
+    // completion handlers of a coalesced write are called.
+    bool* m_destroyed = nullptr;
 
     std::optional<int> m_test_handshake_response;
     std::string m_test_handshake_response_body;
 
+    void disable_extensions() noexcept
+    {
+        m_deflater.reset();
+        m_inflater.reset();
+        m_frame_reader.permessage_deflate = false;
+    }
+
+    // enable_extensions() enables the extensions agreed on in the handshake,
+    // as given by the Sec-WebSocket-Extensions header of the response. Only
+    // permessage-deflate is ever offered or accepted, so false is returned if
+    // the header names any other extension, or if the parameters are invalid.
+    bool enable_extensions(std::string_view sec_websocket_extensions)
+    {
+        if (!m_options.permessage_deflate)
+            return false;
+        util::Optional<DeflateParams> params = parse_permessage_deflate(sec_websocket_extensions, false);
+        if (!params)
+            return false;
+
+        int window_bits = (m_is_client ? params->client_max_window_bits : params->server_max_window_bits);
+        m_deflater.emplace(window_bits); // Throws
+        m_inflater.emplace();            // Throws
+        m_deflate_no_context_takeover =
+            (m_is_client ? params->client_no_context_takeover : params->server_no_context_takeover);
+        m_frame_reader.permessage_deflate = true;
+        m_logger.debug(util::LogCategory::network, "WebSocket: Using %1", format_permessage_deflate(*params)); // Throws
+        return true;
+    }
+
+    // compress_message() compresses the payload of an outgoing message into
+    // m_deflate_buffer. If false is returned, the message must be sent
+    // uncompressed.
+    bool compress_message(const char* data, size_t size)
+    {
+        m_deflate_buffer.clear();
+        std::error_code ec = m_deflater->compress({data, size}, m_deflate_buffer); // Throws
+        if (ec || m_deflate_buffer.size() >= size) {
+            // An uncompressed message does not enter the window of the peer,
+            // so later messages must not refer back to it.
+            if (ec)
+                m_logger.error(util::LogCategory::network, "WebSocket: Failed to compress message: %1", ec.message());
+            m_deflater->reset();
+            return false;
+        }
+        if (m_deflate_no_context_takeover)
+            m_deflater->reset();
+        return true;
+    }
+
+    void release_deflate_buffer() noexcept
+    {
+        if (m_deflate_buffer.capacity() > s_deflate_buffer_stable_size)
+            m_deflate_buffer = util::AppendBuffer<char>{};
+    }
+
+    // queue_frame() adds a frame to the frames which are written together
+    // when the write in progress completes, or starts writing it right away
+    // if there is no write in progress.
+    void queue_frame(bool fin, bool compressed, int opcode, bool mask, const char* data, size_t size,
+                     websocket::WriteCompletionHandler handler)
+    {
+        size_t offset = m_queued_frames.size();
+        // 14 is the maximum header length of a Websocket frame.
+        m_queued_frames.resize(offset + size + 14); // Throws
+        size_t frame_size = make_frame(fin, compressed, opcode, mask, data, size, m_queued_frames.data() + offset,
+                                       m_config.websocket_get_random());
+        m_queued_frames.resize(offset + frame_size);
+        release_deflate_buffer();
+        m_queued_frame_handlers.push_back(std::move(handler)); // Throws
+
+        // While the completion handlers of the previous write are called, the
+        // write is held back so that they can add more frames to it.
+        if (!m_write_in_progress && !m_calling_write_handlers)
+            write_queued_frames(); // Throws
+    }
+
+    void write_queued_frames()
+    {
+        REALM_ASSERT(!m_write_in_progress);
+        m_write_buffer.clear();
+        std::swap(m_write_buffer, m_queued_frames);
+        std::deque<websocket::WriteCompletionHandler> handlers;
+        std::swap(handlers, m_queued_frame_handlers);
+        m_write_in_progress = true;
+
+        auto handler = [this, handlers = std::move(handlers)](std::error_code ec, size_t) mutable {
+            // If the operation is aborted, the WebSocket object may have been destroyed.
+            if (ec == util::error::operation_aborted) {
+                for (auto& handler : handlers)
+                    handler(ec, 0);
+                return;
+            }
+
+            auto is_socket_closed_err = (ec == util::error::make_error_code(util::error::connection_reset) ||
+                                         ec == util::error::make_error_code(util::error::broken_pipe) ||
+                                         ec == util::make_error_code(util::MiscExtErrors::end_of_input));
+            // See async_write_frame().
+            if (is_socket_closed_err) {
+                return;
+            }
+
+            if (ec) {
+                stop();
+                return m_config.websocket_write_error_handler(ec);
+            }
+
+            handle_write_queued_frames(std::move(handlers)); // Throws
+        };
+
+        m_config.async_write(m_write_buffer.data(), m_write_buffer.size(), std::move(handler)); // Throws
+    }
+
+    void handle_write_queued_frames(std::deque<websocket::WriteCompletionHandler> handlers)
+    {
+        m_write_in_progress = false;
+        if (m_write_buffer.capacity() > std::max(s_write_buffer_stable_size, m_options.max_coalesced_write_size)) {
+            m_write_buffer.clear();
+            m_write_buffer.shrink_to_fit();
+        }
+
+        // Call the handlers of the frames which were just written, and then
+        // those of the frames which were queued meanwhile, until enough frames
+        // are queued for the next write. A handler of the latter kind can then
+        // queue another frame without waiting for the next write to complete.
+        bool destroyed = false;
+        m_destroyed = &destroyed;
+        m_calling_write_handlers = true;
+        auto guard = util::make_scope_exit([&]() noexcept {
+            if (!destroyed) {
+                m_destroyed = nullptr;
+                m_calling_write_handlers = false;
+            }
+        });
+        for (;;) {
+            websocket::WriteCompletionHandler handler;
+            if (!handlers.empty()) {
+                handler = std::move(handlers.front());
+                handlers.pop_front();
+            }
+            else if (!m_queued_frame_handlers.empty() &&
+                     m_queued_frames.size() < m_options.max_coalesced_write_size) {
+                handler = std::move(m_queued_frame_handlers.front());
+                m_queued_frame_handlers.pop_front();
+            }
+            else {
+                break;
+            }
+            handler(std::error_code(), 0); // Throws
+            if (destroyed)
+                return;
+            if (m_stopped)
+                break;
+        }
+        guard.cancel();
+        m_destroyed = nullptr;
+        m_calling_write_handlers = false;
+
+        if (!m_stopped && !m_queued_frames.empty())
+            write_queued_frames(); // Throws
+    }
+
     void error_client_malformed_response()
     {
         m_stopped = true;
@@ -879,6 +1280,14 @@ private:
             return;
         }
 
+        if (util::Optional<StringData> extensions =
+                find_http_header_value(response.headers, "Sec-WebSocket-Extensions")) {
+            if (!enable_extensions(std::string_view{extensions->data(), extensions->size()})) { // Throws
+                error_client_response_websocket_headers_invalid(response);
+                return;
+            }
+        }
+
         m_config.websocket_handshake_completion_handler(response.headers);
 
         if (m_stopped)
@@ -894,8 +1303,8 @@ private:
         util::Optional<std::string> sec_websocket_protocol = websocket::read_sec_websocket_protocol(request);
 
         std::error_code ec;
-        util::Optional<HTTPResponse> response =
-            do_make_http_response(request, sec_websocket_protocol ? *sec_websocket_protocol : "realm.io", ec);
+        util::Optional<HTTPResponse> response = do_make_http_response(
+            request, sec_websocket_protocol ? *sec_websocket_protocol : "realm.io", m_options, ec);
 
         if (ec) {
             error_server_request_header_protocol_violation(ec, request);
@@ -903,6 +1312,12 @@ private:
         }
         REALM_ASSERT(response);
 
+        if (util::Optional<StringData> extensions =
+                find_http_header_value(response->headers, "Sec-WebSocket-Extensions")) {
+            bool valid = enable_extensions(std::string_view{extensions->data(), extensions->size()}); // Throws
+            REALM_ASSERT(valid);
+        }
+
         auto handler = [request, this](std::error_code ec) {
             // If the operation is aborted, the socket object may have been destroyed.
             if (ec != util::error::operation_aborted) {
@@ -1002,14 +1417,28 @@ private:
         if (m_frame_reader.delivery_ready) {
             bool should_continue = true;
 
+            const char* data = m_frame_reader.delivery_buffer;
+            size_t size = m_frame_reader.delivery_size;
+            if (m_frame_reader.delivery_compressed) {
+                m_inflate_buffer.clear();
+                std::error_code ec = m_inflater->decompress({data, size}, m_inflate_buffer,
+                                                            m_options.max_inflated_message_size); // Throws
+                if (ec) {
+                    m_logger.error(util::LogCategory::network, "WebSocket: Failed to decompress message: %1",
+                                   ec.message());
+                    protocol_error(HttpError::bad_message);
+                    return;
+                }
+                data = m_inflate_buffer.data();
+                size = m_inflate_buffer.size();
+            }
+
             switch (m_frame_reader.delivery_opcode) {
                 case websocket::Opcode::text:
-                    should_continue = m_config.websocket_text_message_received(m_frame_reader.delivery_buffer,
-                                                                               m_frame_reader.delivery_size);
+                    should_continue = m_config.websocket_text_message_received(data, size);
                     break;
                 case websocket::Opcode::binary:
-                    should_continue = m_config.websocket_binary_message_received(m_frame_reader.delivery_buffer,
-                                                                                 m_frame_reader.delivery_size);
+                    should_continue = m_config.websocket_binary_message_received(data, size);
                     break;
                 case websocket::Opcode::close: {
                     auto [error_code, error_message] =
@@ -1036,6 +1465,9 @@ private:
             if (m_stopped)
                 return;
 
+            if (m_inflate_buffer.capacity() > s_deflate_buffer_stable_size)
+                m_inflate_buffer = util::AppendBuffer<char>{};
+
             // recursion is harmless, since the depth will be at most 2.
             frame_reader_loop();
             return;
@@ -1233,14 +1665,14 @@ bool websocket::Config::websocket_pong_message_received(const char*, size_t)
 
 class websocket::Socket::Impl : public WebSocket {
 public:
-    Impl(Config& config)
-        : WebSocket(config) // Throws
+    Impl(Config& config, const Options& options)
+        : WebSocket(config, options) // Throws
     {
     }
 };
 
-websocket::Socket::Socket(Config& config)
-    : m_impl(new Impl{config})
+websocket::Socket::Socket(Config& config, const Options& options)
+    : m_impl(new Impl{config, options})
 {
 }
 
@@ -1264,7 +1696,12 @@ void websocket::Socket::initiate_server_handshake()
 
 void websocket::Socket::initiate_server_websocket_after_handshake()
 {
-    m_impl->initiate_server_websocket_after_handshake();
+    m_impl->initiate_server_websocket_after_handshake({});
+}
+
+void websocket::Socket::initiate_server_websocket_after_handshake(std::string_view sec_websocket_extensions)
+{
+    m_impl->initiate_server_websocket_after_handshake(sec_websocket_extensions);
 }
 
 void websocket::Socket::async_write_frame(bool fin, Opcode opcode, const char* data, size_t size,
@@ -1320,7 +1757,14 @@ util::Optional<HTTPResponse> websocket::make_http_response(const HTTPRequest& re
                                                            const std::string& sec_websocket_protocol,
                                                            std::error_code& ec)
 {
-    return do_make_http_response(request, sec_websocket_protocol, ec);
+    return do_make_http_response(request, sec_websocket_protocol, Options{}, ec);
+}
+
+util::Optional<HTTPResponse> websocket::make_http_response(const HTTPRequest& request,
+                                                           const std::string& sec_websocket_protocol,
+                                                           const Options& options, std::error_code& ec)
+{
+    return do_make_http_response(request, sec_websocket_protocol, options, ec);
 }
 
 const std::error_category& websocket::http_error_category() noexcept
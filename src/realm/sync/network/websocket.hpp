@@ -86,9 +86,48 @@ public:
 enum class Opcode { continuation = 0, text = 1, binary = 2, close = 8, ping = 9, pong = 10 };
 
 
+/// Options for the optional features of a Socket. All of them are disabled by
+/// default.
+struct Options {
+    /// If true, a client Socket offers the permessage-deflate extension (RFC
+    /// 7692), and a server Socket accepts it if offered by the client. When
+    /// both endpoints agree to use it, the payload of unfragmented text and
+    /// binary messages is compressed.
+    bool permessage_deflate = false;
+
+    /// If false, both endpoints are asked to compress each message on its own
+    /// ("no context takeover") instead of letting it refer back to the content
+    /// of the previous messages. This worsens the compression of small
+    /// messages with recurring content.
+    bool deflate_context_takeover = true;
+
+    /// Messages with a smaller payload are sent uncompressed even when
+    /// permessage-deflate is in use, as compressing them rarely pays off.
+    size_t deflate_min_message_size = 64;
+
+    /// A compressed message which decompresses to more than this many bytes
+    /// is treated as a protocol error, so that a peer cannot exhaust our
+    /// memory with a small message that decompresses to a huge one.
+    size_t max_inflated_message_size = 64 * 1024 * 1024;
+
+    /// If true, frames can be sent while earlier frames are still being
+    /// written, and are then collected and written together in a single call
+    /// to Config::async_write() when the write in progress completes. See
+    /// Socket::async_write_frame(). As the completion handler of a frame may
+    /// then be called before the frame is written, this must not be enabled
+    /// by users which act on the underlying stream once a frame is sent, for
+    /// example to shut it down after a final message.
+    bool coalesce_writes = false;
+
+    /// Once the collected frames reach this size, no more frames are added to
+    /// them before they are written.
+    size_t max_coalesced_write_size = 16 * 1024;
+};
+
+
 class Socket {
 public:
-    Socket(Config&);
+    Socket(Config&, const Options& = {});
     Socket(Socket&&) noexcept;
     ~Socket() noexcept;
 
@@ -122,10 +161,22 @@ public:
     /// HTTP response itself.
     void initiate_server_websocket_after_handshake();
 
+    /// Same as above, but also enables the extensions accepted by the
+    /// handshake response, as given by \a sec_websocket_extensions, the value
+    /// of the Sec-WebSocket-Extensions header of the response made by
+    /// make_http_response(), or empty if there was none.
+    void initiate_server_websocket_after_handshake(std::string_view sec_websocket_extensions);
+
     /// The async_write_* functions send frames. Only one frame should be sent at a time,
     /// meaning that the user must wait for the handler to be called before sending the next frame.
     /// The handler is type util::UniqueFunction<void()> and is called when the frame has been successfully
     /// sent. In case of errors, the Config::websocket_write_error_handler() is called.
+    ///
+    /// If Options::coalesce_writes is set, frames may also be sent while earlier frames are
+    /// still being written. Such frames are written together once the write in progress
+    /// completes, and the handler of a frame which had to wait may be called as soon as that
+    /// happens, before the frame itself is written, so that a user sending one frame at a time
+    /// can add more frames to the same write.
 
     /// async_write_frame() sends a single frame with this content:
     /// \param fin The fin bit set to 0 or 1
@@ -189,6 +240,12 @@ util::Optional<std::string> read_sec_websocket_protocol(const HTTPRequest& reque
 util::Optional<HTTPResponse> make_http_response(const HTTPRequest& request, const std::string& sec_websocket_protocol,
                                                 std::error_code& ec);
 
+/// Same as above, but the response also accepts the extensions offered in \a
+/// request which are enabled in \a options. The Socket must then be started
+/// with initiate_server_websocket_after_handshake(std::string_view).
+util::Optional<HTTPResponse> make_http_response(const HTTPRequest& request, const std::string& sec_websocket_protocol,
+                                                const Options& options, std::error_code& ec);
+
 enum class HttpError {
     bad_request_malformed_http,
     bad_request_header_upgrade,
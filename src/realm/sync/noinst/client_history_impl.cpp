@@ -34,10 +34,83 @@
 #include <algorithm>
 #include <ctime>
 #include <cstring>
+#include <thread>
 #include <utility>
 
 namespace realm::sync {
 
+namespace {
+
+// Changesets are parsed independently of each other, so when a download is
+// large (e.g. during the initial sync of a large Realm), the parsing is spread
+// over several threads, each taking a contiguous range of about the same
+// number of bytes.
+constexpr std::size_t s_min_parse_bytes_per_thread = 256 * 1024;
+constexpr std::size_t s_max_parse_threads = 8;
+
+void parse_remote_changesets(util::Span<const RemoteChangeset> incoming_changesets,
+                             std::vector<Changeset>& changesets)
+{
+    auto parse_range = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            parse_remote_changeset(incoming_changesets[i], changesets[i]); // Throws
+            changesets[i].transform_sequence = i;
+        }
+    };
+
+    std::size_t total_size = 0;
+    for (const RemoteChangeset& changeset : incoming_changesets)
+        total_size += changeset.data.size();
+    std::size_t num_threads = std::min({std::size_t(std::thread::hardware_concurrency()), s_max_parse_threads,
+                                        incoming_changesets.size(), total_size / s_min_parse_bytes_per_thread});
+    if (num_threads <= 1) {
+        parse_range(0, incoming_changesets.size()); // Throws
+        return;
+    }
+
+    std::vector<std::size_t> bounds = {0};
+    std::size_t range_size = 0;
+    for (std::size_t i = 0; i < incoming_changesets.size() && bounds.size() < num_threads; ++i) {
+        range_size += incoming_changesets[i].data.size();
+        if (range_size >= total_size / num_threads) {
+            bounds.push_back(i + 1);
+            range_size = 0;
+        }
+    }
+    bounds.push_back(incoming_changesets.size());
+
+    std::size_t num_ranges = bounds.size() - 1;
+    std::vector<std::exception_ptr> errors(num_ranges);
+    auto run = [&](std::size_t range) noexcept {
+        try {
+            parse_range(bounds[range], bounds[range + 1]); // Throws
+        }
+        catch (...) {
+            errors[range] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_ranges - 1);
+    for (std::size_t range = 1; range < num_ranges; ++range) {
+        try {
+            threads.emplace_back(run, range);
+        }
+        catch (const std::system_error&) {
+            run(range); // Could not start a thread
+        }
+    }
+    run(0);
+    for (auto& thread : threads)
+        thread.join();
+    // Report the error of the first bad changeset as a sequential parse would
+    for (auto& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+} // unnamed namespace
+
 void ClientHistory::set_history_adjustments(
     util::Logger& logger, version_type current_version, SaltedFileIdent client_file_ident,
     SaltedVersion server_version, const std::vector<_impl::client_reset::RecoveredChange>& recovered_changesets)
@@ -356,6 +429,33 @@ void ClientHistory::set_sync_progress(const SyncProgress& progress, Downloadable
 void ClientHistory::find_uploadable_changesets(UploadCursor& upload_progress, version_type end_version,
                                                std::vector<UploadChangeset>& uploadable_changesets,
                                                version_type& locked_server_version) const
+{
+    auto handler = [&](const UploadChangeset& compressed) {
+        util::AppendBuffer<char> decompressed;
+        ChunkedBinaryInputStream is(compressed.changeset);
+        auto ec = util::compression::decompress_nonportable(is, decompressed);
+        if (ec == util::compression::error::decompress_unsupported) {
+            REALM_TERMINATE(
+                "Synchronized Realm files with unuploaded local changes cannot be copied between platforms.");
+        }
+        REALM_ASSERT_3(ec, ==, std::error_code{});
+
+        UploadChangeset uc;
+        uc.origin_timestamp = compressed.origin_timestamp;
+        uc.origin_file_ident = compressed.origin_file_ident;
+        uc.progress = compressed.progress;
+        uc.changeset = BinaryData{decompressed.data(), decompressed.size()};
+        uc.buffer = decompressed.release().release();
+        uploadable_changesets.push_back(std::move(uc)); // Throws
+    };
+    find_uploadable_changesets(upload_progress, end_version, handler, locked_server_version); // Throws
+}
+
+
+void ClientHistory::find_uploadable_changesets(UploadCursor& upload_progress, version_type end_version,
+                                               util::FunctionRef<void(const UploadChangeset&)> handler,
+                                               version_type& locked_server_version,
+                                               std::size_t accum_byte_size_soft_limit) const
 {
     TransactionRef rt = m_db->start_read(); // Throws
     auto& alloc = m_db->get_alloc();
@@ -367,9 +467,9 @@ void ClientHistory::find_uploadable_changesets(UploadCursor& upload_progress, ve
     const auto sync_history_size = arrays.changesets.size();
     const auto sync_history_base_version = rt->get_version() - sync_history_size;
 
-    std::size_t accum_byte_size_soft_limit = 131072;   // 128 KB
     std::size_t accum_byte_size_hard_limit = 16777216; // server-imposed limit
     std::size_t accum_byte_size = 0;
+    std::size_t num_changesets = 0;
 
     version_type begin_version_2 = std::max(upload_progress.client_version, sync_history_base_version);
     version_type end_version_2 = std::max(end_version, sync_history_base_version);
@@ -389,28 +489,19 @@ void ClientHistory::find_uploadable_changesets(UploadCursor& upload_progress, ve
 
         ChunkedBinaryInputStream is(entry.changeset);
         size_t size = util::compression::get_uncompressed_size_from_header(is);
-        if (accum_byte_size + size >= accum_byte_size_hard_limit && !uploadable_changesets.empty())
+        if (accum_byte_size + size >= accum_byte_size_hard_limit && num_changesets != 0)
             break;
         accum_byte_size += size;
         last_integrated_upstream_version = last_integrated_upstream_version_2;
         begin_version_2 = version;
 
         UploadChangeset uc;
-        util::AppendBuffer<char> decompressed;
-        ChunkedBinaryInputStream is_2(entry.changeset);
-        auto ec = util::compression::decompress_nonportable(is_2, decompressed);
-        if (ec == util::compression::error::decompress_unsupported) {
-            REALM_TERMINATE(
-                "Synchronized Realm files with unuploaded local changes cannot be copied between platforms.");
-        }
-        REALM_ASSERT_3(ec, ==, std::error_code{});
-
         uc.origin_timestamp = entry.origin_timestamp;
         uc.origin_file_ident = entry.origin_file_ident;
         uc.progress = UploadCursor{version, entry.remote_version};
-        uc.changeset = BinaryData{decompressed.data(), decompressed.size()};
-        uc.buffer = decompressed.release().release();
-        uploadable_changesets.push_back(std::move(uc)); // Throws
+        uc.changeset = entry.changeset;
+        handler(uc); // Throws
+        ++num_changesets;
     }
 
     upload_progress = {std::min(begin_version_2, end_version), last_integrated_upstream_version};
@@ -432,18 +523,30 @@ void ClientHistory::integrate_server_changesets(
     std::vector<Changeset> changesets;
     changesets.resize(incoming_changesets.size()); // Throws
 
+    // When no local changes need to be merged with the incoming changesets,
+    // they are applied as they are parsed rather than being fully parsed up
+    // front. Whether that is the case is only known up front if the write
+    // transaction is already open, as it is during bootstraps.
+    bool parse_while_applying = false;
+    if (transact->get_transact_stage() == DB::transact_Writing && m_replication.apply_server_changes()) {
+        version_type local_version = transact->get_version_of_current_transaction().version;
+        ensure_updated(local_version); // Throws
+        parse_while_applying = !has_local_changes_to_merge(incoming_changesets, local_version);
+        if (parse_while_applying)
+            logger.debug(util::LogCategory::changeset, "No local changes to merge, applying %1 changesets as parsed",
+                         incoming_changesets.size());
+    }
+
     // Parse incoming changesets without holding the write lock unless 'transact' is specified.
-    try {
-        for (std::size_t i = 0; i < incoming_changesets.size(); ++i) {
-            const RemoteChangeset& changeset = incoming_changesets[i];
-            parse_remote_changeset(changeset, changesets[i]); // Throws
-            changesets[i].transform_sequence = i;
+    if (!parse_while_applying) {
+        try {
+            parse_remote_changesets(incoming_changesets, changesets); // Throws
+        }
+        catch (const BadChangesetError& e) {
+            throw IntegrationException(ErrorCodes::BadChangeset,
+                                       util::format("Failed to parse received changeset: %1", e.what()),
+                                       ProtocolError::bad_changeset);
         }
-    }
-    catch (const BadChangesetError& e) {
-        throw IntegrationException(ErrorCodes::BadChangeset,
-                                   util::format("Failed to parse received changeset: %1", e.what()),
-                                   ProtocolError::bad_changeset);
     }
 
     VersionID new_version{0, 0};
@@ -468,8 +571,12 @@ void ClientHistory::integrate_server_changesets(
         prepare_for_write();           // Throws
 
         std::uint64_t downloaded_bytes_in_transaction = 0;
-        auto changesets_transformed_count = transform_and_apply_server_changesets(
-            changesets_to_integrate, transact, logger, downloaded_bytes_in_transaction, allow_lock_release);
+        auto changesets_transformed_count =
+            parse_while_applying
+                ? parse_and_apply_server_changesets(incoming_changesets, changesets_to_integrate, transact,
+                                                    downloaded_bytes_in_transaction)
+                : transform_and_apply_server_changesets(changesets_to_integrate, transact, logger,
+                                                        downloaded_bytes_in_transaction, allow_lock_release);
 
         // downloaded_bytes always contains the total number of downloaded bytes
         // from the Realm. downloaded_bytes must be persisted in the Realm, since
@@ -610,6 +717,64 @@ size_t ClientHistory::transform_and_apply_server_changesets(util::Span<Changeset
 }
 
 
+size_t ClientHistory::parse_and_apply_server_changesets(util::Span<const RemoteChangeset> incoming_changesets,
+                                                        util::Span<Changeset> changesets_to_integrate,
+                                                        TransactionRef transact, std::uint64_t& downloaded_bytes)
+{
+    REALM_ASSERT(transact->get_transact_stage() == DB::transact_Writing);
+    REALM_ASSERT(incoming_changesets.size() == changesets_to_integrate.size());
+
+    version_type local_version = transact->get_version_of_current_transaction().version;
+    auto sync_file_id = transact->get_sync_file_id();
+
+    for (size_t i = 0; i < incoming_changesets.size(); ++i) {
+        const RemoteChangeset& remote_changeset = incoming_changesets[i];
+        REALM_ASSERT(remote_changeset.last_integrated_local_version <= local_version);
+        REALM_ASSERT(remote_changeset.origin_file_ident > 0 && remote_changeset.origin_file_ident != sync_file_id);
+
+        // Only the metadata is stored in the changeset, so that it can be
+        // passed to the caller afterwards.
+        Changeset& changeset = changesets_to_integrate[i];
+        changeset.version = remote_changeset.remote_version;
+        changeset.last_integrated_remote_version = remote_changeset.last_integrated_local_version;
+        changeset.origin_timestamp = remote_changeset.origin_timestamp;
+        changeset.origin_file_ident = remote_changeset.origin_file_ident;
+        changeset.original_changeset_size = remote_changeset.original_changeset_size;
+        changeset.transform_sequence = i;
+
+        try {
+            ChunkedBinaryInputStream in{remote_changeset.data};
+            InstructionApplier applier{*transact};
+            TempShortCircuitReplication tscr{m_replication};
+            applier.parse_and_apply(in, changeset); // Throws
+        }
+        catch (const BadChangesetError& e) {
+            throw IntegrationException(ErrorCodes::BadChangeset,
+                                       util::format("Failed to apply received changeset: %1", e.what()),
+                                       ProtocolError::bad_changeset);
+        }
+        downloaded_bytes += changeset.original_changeset_size;
+    }
+    return incoming_changesets.size();
+}
+
+
+bool ClientHistory::has_local_changes_to_merge(util::Span<const RemoteChangeset> incoming_changesets,
+                                               version_type local_version) const noexcept
+{
+    // The transformer merges each incoming changeset with the local changesets
+    // produced after its last integrated local version, skipping those that
+    // are empty or of remote origin, just like find_history_entry() does.
+    version_type begin_version = local_version;
+    for (const RemoteChangeset& changeset : incoming_changesets)
+        begin_version = std::min(begin_version, changeset.last_integrated_local_version);
+    begin_version = std::max(begin_version, m_sync_history_base_version);
+
+    HistoryEntry entry;
+    return find_history_entry(begin_version, local_version, entry) != 0;
+}
+
+
 void ClientHistory::get_upload_download_state(Transaction& rt, Allocator& alloc, std::uint_fast64_t& downloaded_bytes,
                                               DownloadableProgress& downloadable_bytes,
                                               std::uint_fast64_t& uploaded_bytes,
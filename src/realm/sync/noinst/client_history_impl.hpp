@@ -24,6 +24,7 @@
 #include <realm/sync/history.hpp>
 #include <realm/sync/instruction_replication.hpp>
 #include <realm/sync/transform.hpp>
+#include <realm/util/function_ref.hpp>
 #include <realm/util/functional.hpp>
 #include <realm/util/optional.hpp>
 
@@ -215,6 +216,20 @@ public:
                                     std::vector<UploadChangeset>& uploadable_changesets,
                                     version_type& locked_server_version) const;
 
+    /// Same as above, but rather than decompressing every changeset into a
+    /// buffer of its own, \a handler is called for each found changeset while
+    /// the read transaction is still open. UploadChangeset::changeset then
+    /// refers to the changeset in its compressed form as stored in the history
+    /// (see util::compression::decompress_nonportable()), and is only valid
+    /// for the duration of the call. UploadChangeset::buffer is left empty.
+    ///
+    /// The scan ends once the combined uncompressed size of the found
+    /// changesets reaches \a accum_byte_size_soft_limit.
+    void find_uploadable_changesets(UploadCursor& upload_progress, version_type end_version,
+                                    util::FunctionRef<void(const UploadChangeset&)> handler,
+                                    version_type& locked_server_version,
+                                    std::size_t accum_byte_size_soft_limit = 131072) const;
+
     /// \brief Integrate a sequence of changesets received from the server using
     /// a single Realm transaction.
     ///
@@ -417,6 +432,11 @@ private:
     size_t transform_and_apply_server_changesets(util::Span<Changeset> changesets_to_integrate, TransactionRef,
                                                  util::Logger&, std::uint64_t& downloaded_bytes,
                                                  bool allow_lock_release);
+    size_t parse_and_apply_server_changesets(util::Span<const RemoteChangeset> incoming_changesets,
+                                             util::Span<Changeset> changesets_to_integrate, TransactionRef,
+                                             std::uint64_t& downloaded_bytes);
+    bool has_local_changes_to_merge(util::Span<const RemoteChangeset> incoming_changesets,
+                                    version_type local_version) const noexcept;
 
     void prepare_for_write();
     Replication::version_type add_changeset(BinaryData changeset, BinaryData sync_changeset);
@@ -2028,12 +2028,67 @@ void Session::send_upload_message()
     bool server_version_to_ack =
         m_upload_progress.last_integrated_server_version < m_download_progress.server_version;
 
-    std::vector<UploadChangeset> uploadable_changesets;
+    // The changesets are decompressed straight from the history into the
+    // body of the message while the read transaction is open, rather than
+    // into a separate buffer per changeset.
+    ClientProtocol& protocol = m_conn.get_client_protocol();
+    ClientProtocol::UploadMessageBuilder upload_message_builder = protocol.make_upload_message_builder(); // Throws
+    std::size_t num_changesets = 0;
+    auto add_changeset = [&](const UploadChangeset& uc) {
+        if (logger.would_log(util::LogCategory::changeset, util::Logger::Level::debug)) {
+            ChunkedBinaryInputStream in{uc.changeset};
+            logger.debug(util::LogCategory::changeset,
+                         "Fetching changeset for upload (client_version=%1, server_version=%2, "
+                         "changeset_size=%3, origin_timestamp=%4, origin_file_ident=%5)",
+                         uc.progress.client_version, uc.progress.last_integrated_server_version,
+                         util::compression::get_uncompressed_size_from_header(in), uc.origin_timestamp,
+                         uc.origin_file_ident); // Throws
+        }
+        if (logger.would_log(util::LogCategory::changeset, util::Logger::Level::trace)) {
+            util::AppendBuffer<char> decompressed;
+            ChunkedBinaryInputStream is{uc.changeset};
+            if (!util::compression::decompress_nonportable(is, decompressed)) {
+                BinaryData changeset_data{decompressed.data(), decompressed.size()};
+                if (changeset_data.size() < 1024) {
+                    logger.trace(util::LogCategory::changeset, "Changeset: %1",
+                                 _impl::clamped_hex_dump(changeset_data)); // Throws
+                }
+                else {
+                    logger.trace(util::LogCategory::changeset, "Changeset(comp): %1 %2", changeset_data.size(),
+                                 protocol.compressed_hex_dump(changeset_data));
+                }
+
+#if REALM_DEBUG
+                ChunkedBinaryInputStream in{changeset_data};
+                Changeset log;
+                try {
+                    parse_changeset(in, log);
+                    std::stringstream ss;
+                    log.print(ss);
+                    logger.trace(util::LogCategory::changeset, "Changeset (parsed):\n%1", ss.str());
+                }
+                catch (const BadChangesetError& err) {
+                    logger.error(util::LogCategory::changeset, "Unable to parse changeset: %1", err.what());
+                }
+#endif
+            }
+        }
+
+        std::error_code ec = upload_message_builder.add_compressed_changeset(
+            uc.progress.client_version, uc.progress.last_integrated_server_version, uc.origin_timestamp,
+            uc.origin_file_ident, uc.changeset); // Throws
+        if (ec == util::compression::error::decompress_unsupported) {
+            REALM_TERMINATE(
+                "Synchronized Realm files with unuploaded local changes cannot be copied between platforms.");
+        }
+        REALM_ASSERT_3(ec, ==, std::error_code{});
+        ++num_changesets;
+    };
     version_type locked_server_version = 0;
-    get_history().find_uploadable_changesets(m_upload_progress, target_upload_version, uploadable_changesets,
+    get_history().find_uploadable_changesets(m_upload_progress, target_upload_version, add_changeset,
                                              locked_server_version); // Throws
 
-    if (uploadable_changesets.empty()) {
+    if (num_changesets == 0) {
         // Nothing more to upload right now if:
         //  1. We need to limit upload up to some version other than the last client version
         //     available and there are no changes to upload
@@ -2058,7 +2113,7 @@ void Session::send_upload_message()
         logger.trace("UPLOAD not allowed (progress_client_version=%1, progress_server_version=%2, "
                      "locked_server_version=%3, num_changesets=%4)",
                      progress_client_version, progress_server_version, locked_server_version,
-                     uploadable_changesets.size()); // Throws
+                     num_changesets); // Throws
         // Other messages may be waiting to be sent
         return enlist_to_send(); // Throws
     }
@@ -2066,50 +2121,7 @@ void Session::send_upload_message()
     logger.debug("Sending: UPLOAD(progress_client_version=%1, progress_server_version=%2, "
                  "locked_server_version=%3, num_changesets=%4)",
                  progress_client_version, progress_server_version, locked_server_version,
-                 uploadable_changesets.size()); // Throws
-
-    ClientProtocol& protocol = m_conn.get_client_protocol();
-    ClientProtocol::UploadMessageBuilder upload_message_builder = protocol.make_upload_message_builder(); // Throws
-
-    for (const UploadChangeset& uc : uploadable_changesets) {
-        logger.debug(util::LogCategory::changeset,
-                     "Fetching changeset for upload (client_version=%1, server_version=%2, "
-                     "changeset_size=%3, origin_timestamp=%4, origin_file_ident=%5)",
-                     uc.progress.client_version, uc.progress.last_integrated_server_version, uc.changeset.size(),
-                     uc.origin_timestamp, uc.origin_file_ident); // Throws
-        if (logger.would_log(util::Logger::Level::trace)) {
-            BinaryData changeset_data = uc.changeset.get_first_chunk();
-            if (changeset_data.size() < 1024) {
-                logger.trace(util::LogCategory::changeset, "Changeset: %1",
-                             _impl::clamped_hex_dump(changeset_data)); // Throws
-            }
-            else {
-                logger.trace(util::LogCategory::changeset, "Changeset(comp): %1 %2", changeset_data.size(),
-                             protocol.compressed_hex_dump(changeset_data));
-            }
-
-#if REALM_DEBUG
-            ChunkedBinaryInputStream in{changeset_data};
-            Changeset log;
-            try {
-                parse_changeset(in, log);
-                std::stringstream ss;
-                log.print(ss);
-                logger.trace(util::LogCategory::changeset, "Changeset (parsed):\n%1", ss.str());
-            }
-            catch (const BadChangesetError& err) {
-                logger.error(util::LogCategory::changeset, "Unable to parse changeset: %1", err.what());
-            }
-#endif
-        }
-
-        {
-            upload_message_builder.add_changeset(uc.progress.client_version,
-                                                 uc.progress.last_integrated_server_version, uc.origin_timestamp,
-                                                 uc.origin_file_ident,
-                                                 uc.changeset); // Throws
-        }
-    }
+                 num_changesets); // Throws
 
     int protocol_version = m_conn.get_negotiated_protocol_version();
     OutputBuffer& out = m_conn.get_output_buffer();
@@ -1,3 +1,5 @@
+#include <charconv>
+
 #include <realm/util/assert.hpp>
 #include <realm/util/base64.hpp>
 #include <realm/util/from_chars.hpp>
@@ -7,6 +9,46 @@ namespace realm::_impl {
 
 using OutputBuffer = util::ResettableExpandableBufferOutputStream;
 
+BodyCompression compress_message_body(int protocol_version, util::compression::CompressMemoryArena& arena,
+                                      util::Span<const char> body, std::vector<char>& compressed_buf)
+{
+    // Compression rarely pays off for small bodies.
+    constexpr std::size_t max_uncompressed = 1024;
+    if (body.size() <= max_uncompressed)
+        return BodyCompression::none;
+
+    BodyCompression method = BodyCompression::deflate;
+    if (protocol_version >= sync::get_zstd_body_compression_protocol_version() &&
+        util::compression::zstd_is_available()) {
+        method = BodyCompression::zstd;
+        if (auto ec = util::compression::allocate_and_compress_zstd(body, compressed_buf)) // Throws
+            throw std::system_error(ec);
+    }
+    else {
+        if (auto ec = util::compression::allocate_and_compress(arena, body, compressed_buf)) // Throws
+            throw std::system_error(ec);
+    }
+
+    // The compressed body is only sent if it is smaller than the uncompressed body.
+    if (compressed_buf.size() >= body.size())
+        return BodyCompression::none;
+    return method;
+}
+
+std::error_code decompress_message_body(BodyCompression method, util::Span<const char> compressed_buf,
+                                        util::Span<char> decompressed_buf)
+{
+    switch (method) {
+        case BodyCompression::none:
+            break;
+        case BodyCompression::deflate:
+            return util::compression::decompress(compressed_buf, decompressed_buf);
+        case BodyCompression::zstd:
+            return util::compression::decompress_zstd(compressed_buf, decompressed_buf);
+    }
+    REALM_UNREACHABLE();
+}
+
 // Client protocol
 
 void ClientProtocol::make_pbs_bind_message(int protocol_version, OutputBuffer& out, session_ident_type session_ident,
@@ -84,13 +126,13 @@ void ClientProtocol::make_test_command_message(OutputBuffer& out, session_ident_
 }
 
 ClientProtocol::UploadMessageBuilder::UploadMessageBuilder(
-    OutputBuffer& body_buffer, std::vector<char>& compression_buffer,
+    util::AppendBuffer<char>& body_buffer, std::vector<char>& compression_buffer,
     util::compression::CompressMemoryArena& compress_memory_arena)
     : m_body_buffer{body_buffer}
     , m_compression_buffer{compression_buffer}
     , m_compress_memory_arena{compress_memory_arena}
 {
-    m_body_buffer.reset();
+    m_body_buffer.clear();
 }
 
 void ClientProtocol::UploadMessageBuilder::add_changeset(version_type client_version, version_type server_version,
@@ -98,12 +140,68 @@ void ClientProtocol::UploadMessageBuilder::add_changeset(version_type client_ver
                                                          file_ident_type origin_file_ident,
                                                          ChunkedBinaryData changeset)
 {
-    m_body_buffer << client_version << " " << server_version << " " << origin_timestamp << " " << origin_file_ident
-                  << " " << changeset.size() << " "; // Throws
-    changeset.write_to(m_body_buffer);               // Throws
-    REALM_ASSERT(!m_body_buffer.fail());
+    add_changeset_header(client_version, server_version, origin_timestamp, origin_file_ident,
+                         changeset.size()); // Throws
+    ChunkedBinaryInputStream in{changeset};
+    for (auto block = in.next_block(); block.size() != 0; block = in.next_block())
+        m_body_buffer.append(block.data(), block.size()); // Throws
+
+    ++m_num_changesets;
+}
+
+std::error_code ClientProtocol::UploadMessageBuilder::add_compressed_changeset(
+    version_type client_version, version_type server_version, timestamp_type origin_timestamp,
+    file_ident_type origin_file_ident, ChunkedBinaryData compressed_changeset)
+{
+    std::size_t changeset_size;
+    {
+        ChunkedBinaryInputStream in{compressed_changeset};
+        changeset_size = util::compression::get_uncompressed_size_from_header(in);
+    }
+    if (changeset_size == std::numeric_limits<std::size_t>::max())
+        return util::compression::error::out_of_memory;
+
+    std::size_t orig_size = m_body_buffer.size();
+    add_changeset_header(client_version, server_version, origin_timestamp, origin_file_ident,
+                         changeset_size); // Throws
+    std::size_t offset = m_body_buffer.size();
+    m_body_buffer.resize(offset + changeset_size); // Throws
+
+    ChunkedBinaryInputStream in{compressed_changeset};
+    std::error_code ec = util::compression::decompress_nonportable(
+        in, util::Span<char>{m_body_buffer.data() + offset, changeset_size});
+    if (REALM_UNLIKELY(ec)) {
+        m_body_buffer.resize(orig_size);
+        return ec;
+    }
 
     ++m_num_changesets;
+    return std::error_code{};
+}
+
+void ClientProtocol::UploadMessageBuilder::add_changeset_header(version_type client_version,
+                                                                version_type server_version,
+                                                                timestamp_type origin_timestamp,
+                                                                file_ident_type origin_file_ident,
+                                                                std::size_t changeset_size)
+{
+    // Formatted by hand rather than through a stream, as the body is written
+    // to directly when changesets are decompressed into it.
+    char buffer[5 * 21];
+    char* begin = buffer;
+    char* end = buffer + sizeof buffer;
+    auto put = [&](auto value) {
+        auto res = std::to_chars(begin, end, value);
+        REALM_ASSERT(res.ec == std::errc{});
+        *res.ptr = ' ';
+        begin = res.ptr + 1;
+    };
+    put(client_version);
+    put(server_version);
+    put(origin_timestamp);
+    put(origin_file_ident);
+    put(changeset_size);
+    m_body_buffer.append(buffer, std::size_t(begin - buffer)); // Throws
 }
 
 void ClientProtocol::UploadMessageBuilder::make_upload_message(int protocol_version, OutputBuffer& out,
@@ -112,23 +210,15 @@ void ClientProtocol::UploadMessageBuilder::make_upload_message(int protocol_vers
                                                                version_type progress_server_version,
                                                                version_type locked_server_version)
 {
-    static_cast<void>(protocol_version);
-    BinaryData body = {m_body_buffer.data(), std::size_t(m_body_buffer.size())};
+    BinaryData body = {m_body_buffer.data(), m_body_buffer.size()};
 
-    constexpr std::size_t g_max_uncompressed = 1024;
-
-    bool is_body_compressed = false;
-    if (body.size() > g_max_uncompressed) {
-        util::compression::allocate_and_compress(m_compress_memory_arena, body,
-                                                 m_compression_buffer); // Throws
-        is_body_compressed = m_compression_buffer.size() < body.size();
-    }
-
-    // The compressed body is only sent if it is smaller than the uncompressed body.
+    BodyCompression body_compression =
+        compress_message_body(protocol_version, m_compress_memory_arena, body, m_compression_buffer); // Throws
+    bool is_body_compressed = (body_compression != BodyCompression::none);
     std::size_t compressed_body_size = is_body_compressed ? m_compression_buffer.size() : 0;
 
     // The header of the upload message.
-    out << "upload " << session_ident << " " << int(is_body_compressed) << " " << body.size() << " "
+    out << "upload " << session_ident << " " << int(body_compression) << " " << body.size() << " "
         << compressed_body_size;
     out << " " << progress_client_version << " " << progress_server_version << " " << locked_server_version; // Throws
     out << "\n";                                                                                             // Throws
@@ -143,7 +233,7 @@ void ClientProtocol::UploadMessageBuilder::make_upload_message(int protocol_vers
 
 ClientProtocol::UploadMessageBuilder ClientProtocol::make_upload_message_builder()
 {
-    return UploadMessageBuilder{m_output_buffer, m_buffer, m_compress_memory_arena};
+    return UploadMessageBuilder{m_upload_body_buffer, m_buffer, m_compress_memory_arena};
 }
 
 void ClientProtocol::make_unbind_message(OutputBuffer& out, session_ident_type session_ident)
@@ -235,27 +325,28 @@ void ServerProtocol::make_download_message(int protocol_version, OutputBuffer& o
                                            version_type upload_client_version, version_type upload_server_version,
                                            std::uint_fast64_t downloadable_bytes, std::size_t num_changesets,
                                            const char* body, std::size_t uncompressed_body_size,
-                                           std::size_t compressed_body_size, bool body_is_compressed,
+                                           std::size_t compressed_body_size, BodyCompression body_compression,
                                            util::Logger& logger)
 {
-    static_cast<void>(protocol_version);
+    REALM_ASSERT(body_compression != BodyCompression::zstd ||
+                 protocol_version >= sync::get_zstd_body_compression_protocol_version());
     // The header of the download message.
     out << "download " << session_ident << " " << download_server_version << " " << download_client_version << " "
         << latest_server_version << " " << latest_server_version_salt << " " << upload_client_version << " "
-        << upload_server_version << " " << downloadable_bytes << " " << int(body_is_compressed) << " "
+        << upload_server_version << " " << downloadable_bytes << " " << int(body_compression) << " "
         << uncompressed_body_size << " " << compressed_body_size << "\n"; // Throws
 
-    std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
+    std::size_t body_size = (body_compression != BodyCompression::none ? compressed_body_size : uncompressed_body_size);
     out.write(body, body_size);
 
     logger.detail(util::LogCategory::changeset,
                   "Sending: DOWNLOAD(download_server_version=%1, download_client_version=%2, "
                   "latest_server_version=%3, latest_server_version_salt=%4, "
                   "upload_client_version=%5, upload_server_version=%6, "
-                  "num_changesets=%7, is_body_compressed=%8, body_size=%9, "
+                  "num_changesets=%7, body_compression=%8, body_size=%9, "
                   "compressed_body_size=%10)",
                   download_server_version, download_client_version, latest_server_version, latest_server_version_salt,
-                  upload_client_version, upload_server_version, num_changesets, body_is_compressed,
+                  upload_client_version, upload_server_version, num_changesets, int(body_compression),
                   uncompressed_body_size, compressed_body_size); // Throws
 }
 
@@ -28,6 +28,31 @@ namespace realm::_impl {
 struct ProtocolCodecException : public std::runtime_error {
     using std::runtime_error::runtime_error;
 };
+
+/// The compression method of the body of an UPLOAD or DOWNLOAD message, as
+/// carried by the `<is body compressed>` header field. zstd is only used when
+/// the negotiated protocol version is at least
+/// sync::get_zstd_body_compression_protocol_version().
+enum class BodyCompression { none = 0, deflate = 1, zstd = 2 };
+
+/// compress_message_body() compresses \a body into \a compressed_buf with
+/// the best method allowed by \a protocol_version, and returns the method
+/// used. BodyCompression::none is returned, and \a compressed_buf is left in
+/// an unspecified state, if the body is too small to be worth compressing, or
+/// if compression would not make it smaller.
+BodyCompression compress_message_body(int protocol_version, util::compression::CompressMemoryArena& arena,
+                                      util::Span<const char> body, std::vector<char>& compressed_buf);
+
+/// decompress_message_body() decompresses a message body compressed with \a
+/// method into \a decompressed_buf, which must have exactly the uncompressed
+/// body size.
+std::error_code decompress_message_body(BodyCompression method, util::Span<const char> compressed_buf,
+                                        util::Span<char> decompressed_buf);
+
+inline bool is_valid_body_compression(int value) noexcept
+{
+    return value >= int(BodyCompression::none) && value <= int(BodyCompression::zstd);
+}
 class HeaderLineParser {
 public:
     explicit HeaderLineParser(std::string_view line)
@@ -197,19 +222,33 @@ public:
 
     class UploadMessageBuilder {
     public:
-        UploadMessageBuilder(OutputBuffer& body_buffer, std::vector<char>& compression_buffer,
+        UploadMessageBuilder(util::AppendBuffer<char>& body_buffer, std::vector<char>& compression_buffer,
                              util::compression::CompressMemoryArena& compress_memory_arena);
 
         void add_changeset(version_type client_version, version_type server_version, timestamp_type origin_timestamp,
                            file_ident_type origin_file_ident, ChunkedBinaryData changeset);
 
+        /// Same as add_changeset(), but \a compressed_changeset is a changeset
+        /// in the form stored in the client history (see
+        /// util::compression::decompress_nonportable()). It is decompressed
+        /// directly into the message body, so no intermediate buffer is needed.
+        /// If decompression fails, the body is left unchanged and the error is
+        /// returned.
+        std::error_code add_compressed_changeset(version_type client_version, version_type server_version,
+                                                 timestamp_type origin_timestamp, file_ident_type origin_file_ident,
+                                                 ChunkedBinaryData compressed_changeset);
+
         void make_upload_message(int protocol_version, OutputBuffer&, session_ident_type session_ident,
                                  version_type progress_client_version, version_type progress_server_version,
                                  version_type locked_server_version);
 
     private:
+        void add_changeset_header(version_type client_version, version_type server_version,
+                                  timestamp_type origin_timestamp, file_ident_type origin_file_ident,
+                                  std::size_t changeset_size);
+
         std::size_t m_num_changesets = 0;
-        OutputBuffer& m_body_buffer;
+        util::AppendBuffer<char>& m_body_buffer;
         std::vector<char>& m_compression_buffer;
         util::compression::CompressMemoryArena& m_compress_memory_arena;
     };
@@ -455,7 +494,7 @@ private:
         else
             message.downloadable = uint64_t(msg.read_next<int64_t>());
 
-        auto is_body_compressed = msg.read_next<bool>();
+        auto body_compression = msg.read_next<int>();
         auto uncompressed_body_size = msg.read_next<size_t>();
         auto compressed_body_size = msg.read_next<size_t>('\n');
 
@@ -463,14 +502,19 @@ private:
             auto header = msg_with_header.substr(0, msg_with_header.size() - msg.remaining().size());
             return report_error(ErrorCodes::LimitExceeded, "Limits exceeded in input message '%1'", header);
         }
+        if (!is_valid_body_compression(body_compression)) {
+            return report_error(ErrorCodes::SyncProtocolInvariantFailed, "Bad body compression method: %1",
+                                body_compression);
+        }
 
         std::unique_ptr<char[]> uncompressed_body_buffer;
-        // if is_body_compressed == true, we must decompress the received body.
-        if (is_body_compressed) {
+        // if the body is compressed, we must decompress the received body.
+        if (body_compression != int(BodyCompression::none)) {
             uncompressed_body_buffer = std::make_unique<char[]>(uncompressed_body_size);
             std::error_code ec =
-                util::compression::decompress({msg.remaining().data(), compressed_body_size},
-                                              {uncompressed_body_buffer.get(), uncompressed_body_size});
+                decompress_message_body(BodyCompression(body_compression),
+                                        {msg.remaining().data(), compressed_body_size},
+                                        {uncompressed_body_buffer.get(), uncompressed_body_size});
 
             if (ec) {
                 return report_error(ErrorCodes::RuntimeError, "compression::inflate: %1", ec.message());
@@ -480,9 +524,9 @@ private:
         }
 
         logger.debug(util::LogCategory::changeset,
-                     "Download message compression: session_ident=%1, is_body_compressed=%2, "
+                     "Download message compression: session_ident=%1, body_compression=%2, "
                      "compressed_body_size=%3, uncompressed_body_size=%4",
-                     session_ident, is_body_compressed, compressed_body_size, uncompressed_body_size);
+                     session_ident, body_compression, compressed_body_size, uncompressed_body_size);
 
         // Loop through the body and find the changesets.
         while (!msg.at_end()) {
@@ -623,8 +667,8 @@ private:
 
     static constexpr std::size_t s_max_body_size = std::numeric_limits<std::size_t>::max();
 
-    // Permanent buffer to use for building messages.
-    OutputBuffer m_output_buffer;
+    // Permanent buffer to use for building the body of UPLOAD messages.
+    util::AppendBuffer<char> m_upload_body_buffer;
 
     // Permanent buffers to use for internal purposes such as compression.
     std::vector<char> m_buffer;
@@ -673,7 +717,7 @@ public:
                                version_type upload_client_version, version_type upload_server_version,
                                std::uint_fast64_t downloadable_bytes, std::size_t num_changesets, const char* body,
                                std::size_t uncompressed_body_size, std::size_t compressed_body_size,
-                               bool body_is_compressed, util::Logger&);
+                               BodyCompression body_compression, util::Logger&);
 
     void make_mark_message(OutputBuffer&, session_ident_type session_ident, request_ident_type request_ident);
 
@@ -742,13 +786,18 @@ public:
             if (message_type == "upload") {
                 auto msg_with_header = msg.remaining();
                 auto session_ident = msg.read_next<session_ident_type>();
-                auto is_body_compressed = msg.read_next<bool>();
+                auto body_compression = msg.read_next<int>();
                 auto uncompressed_body_size = msg.read_next<size_t>();
                 auto compressed_body_size = msg.read_next<size_t>();
                 auto progress_client_version = msg.read_next<version_type>();
                 auto progress_server_version = msg.read_next<version_type>();
                 auto locked_server_version = msg.read_next<version_type>('\n');
 
+                if (!is_valid_body_compression(body_compression)) {
+                    return report_error(ErrorCodes::SyncProtocolInvariantFailed, "Bad body compression method: %1",
+                                        body_compression);
+                }
+                bool is_body_compressed = (body_compression != int(BodyCompression::none));
                 std::size_t body_size = (is_body_compressed ? compressed_body_size : uncompressed_body_size);
                 if (body_size > s_max_body_size) {
                     auto header = msg_with_header.substr(0, msg_with_header.size() - msg.bytes_remaining());
@@ -764,8 +813,9 @@ public:
                     uncompressed_body_buffer = std::make_unique<char[]>(uncompressed_body_size);
                     auto compressed_body = msg.read_sized_data<BinaryData>(compressed_body_size);
 
-                    std::error_code ec = util::compression::decompress(
-                        compressed_body, {uncompressed_body_buffer.get(), uncompressed_body_size});
+                    std::error_code ec =
+                        decompress_message_body(BodyCompression(body_compression), compressed_body,
+                                                {uncompressed_body_buffer.get(), uncompressed_body_size});
 
                     if (ec) {
                         return report_error(ErrorCodes::RuntimeError, "compression::inflate: %1", ec.message());
@@ -775,11 +825,11 @@ public:
                 }
 
                 logger.debug(util::LogCategory::changeset,
-                             "Upload message compression: is_body_compressed = %1, "
+                             "Upload message compression: body_compression=%1, "
                              "compressed_body_size=%2, uncompressed_body_size=%3, "
                              "progress_client_version=%4, progress_server_version=%5, "
                              "locked_server_version=%6",
-                             is_body_compressed, compressed_body_size, uncompressed_body_size,
+                             body_compression, compressed_body_size, uncompressed_body_size,
                              progress_client_version, progress_server_version, locked_server_version); // Throws
 
 
@@ -46,6 +46,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <locale>
 #include <map>
@@ -72,6 +73,7 @@ using namespace realm::util;
 // clang-format off
 using ServerHistory         = _impl::ServerHistory;
 using ServerProtocol        = _impl::ServerProtocol;
+using BodyCompression       = _impl::BodyCompression;
 using ServerFileAccessCache = _impl::ServerFileAccessCache;
 using ServerImplBase = _impl::ServerImplBase;
 
@@ -80,6 +82,7 @@ using IntegratableChangesetList = ServerHistory::IntegratableChangesetList;
 using IntegratableChangesets = ServerHistory::IntegratableChangesets;
 using IntegrationResult = ServerHistory::IntegrationResult;
 using BootstrapError = ServerHistory::BootstrapError;
+using ClientAccess = ServerHistory::ClientAccess;
 using ExtendedIntegrationError = ServerHistory::ExtendedIntegrationError;
 using ClientType = ServerHistory::ClientType;
 using FileIdentAllocSlot = ServerHistory::FileIdentAllocSlot;
@@ -110,6 +113,15 @@ constexpr std::string_view get_old_pbs_websocket_protocol_prefix() noexcept
     return "com.mongodb.realm-sync/";
 }
 
+websocket::Options make_websocket_options(const Server::Config& config)
+{
+    websocket::Options options;
+    options.permessage_deflate = config.websocket_permessage_deflate;
+    options.deflate_context_takeover = config.websocket_deflate_context_takeover;
+    options.max_inflated_message_size = config.websocket_max_inflated_message_size;
+    return options;
+}
+
 std::string short_token_fmt(const std::string& str, size_t cutoff = 30)
 {
     if (str.size() > cutoff) {
@@ -190,6 +202,7 @@ bool determine_try_again(ProtocolError error_code) noexcept
 
 class ServerFile;
 class ServerImpl;
+class Worker;
 class HTTPConnection;
 class SyncConnection;
 class Session;
@@ -222,7 +235,7 @@ struct DownloadCache {
     std::unique_ptr<char[]> body;
     std::size_t uncompressed_body_size;
     std::size_t compressed_body_size;
-    bool body_is_compressed;
+    BodyCompression body_compression;
     version_type end_version;
     DownloadCursor download_progress;
     std::uint_fast64_t downloadable_bytes;
@@ -261,6 +274,11 @@ public:
     // Result of integration of changesets from downstream clients
     IntegrationResult integration_result;
 
+    // Session activity of downstream clients to be recorded in the history by
+    // the next compaction, and whether that happened.
+    std::vector<ClientAccess> client_accesses;
+    bool recorded_client_accesses = false;
+
     void reset() noexcept
     {
         has_primary_work = false;
@@ -278,6 +296,9 @@ public:
 
         version_info = {};
         integration_result = {};
+
+        client_accesses.clear();
+        recorded_client_accesses = false;
     }
 };
 
@@ -438,11 +459,31 @@ public:
     void initialize();
     void activate();
 
+    // Open the Realm file on a background thread (see
+    // ServerFileAccessCache::Slot::async_open()), and then call initialize().
+    // Until then, is_opening() returns true.
+    void initialize_async();
+
+    bool is_opening() const noexcept
+    {
+        return m_is_opening;
+    }
+
+    // Have the specified connection hold back the handling of incoming
+    // messages until this file is open. Must only be called while
+    // is_opening() returns true.
+    void add_waiting_connection(SyncConnection&);
+
     ServerImpl& get_server() noexcept
     {
         return m_server;
     }
 
+    Worker& get_worker() noexcept
+    {
+        return m_worker;
+    }
+
     const std::string& get_real_path() const noexcept
     {
         return m_file.realm_path;
@@ -537,8 +578,16 @@ public:
 
 private:
     ServerImpl& m_server;
+    // The worker thread integrating the changes uploaded to this file
+    Worker& m_worker;
     ServerFileAccessCache::Slot m_file;
 
+    bool m_is_opening = false;
+
+    // Identifiers of the connections that are waiting for the background open
+    // of this file to complete (see add_waiting_connection()).
+    std::vector<std::int_fast64_t> m_waiting_connections;
+
     // In general, `m_version_info` refers to the last snapshot of the Realm
     // file that is supposed to be visible to remote peers engaging in regular
     // Realm file synchronization.
@@ -554,6 +603,10 @@ private:
     // for which an IDENT message has been received.
     std::map<file_ident_type, Session*> m_identified_sessions;
 
+    // The time of the latest session activity of each client file that has not
+    // yet been recorded in the history (see register_client_access()).
+    std::map<file_ident_type, std::time_t> m_client_access_times;
+
     // Used when a file used as partial view wants to allocate a client file
     // identifier from the reference Realm.
     file_ident_request_type m_file_ident_request = 0;
@@ -650,6 +703,11 @@ private:
 
     DownloadCache m_download_cache;
 
+    // Must only be accessed by the worker thread. The time of the last
+    // compaction attempt, which allows worker_compact_history() to skip the
+    // write transaction while the compaction interval has not yet passed.
+    std::time_t m_last_compaction_attempt_at = 0;
+
     void on_changesets_from_downstream_added(std::size_t num_changesets, std::size_t num_bytes);
     void on_work_added();
     void group_unblock_work();
@@ -662,6 +720,7 @@ private:
     // NOTE: These functions are executed by the worker thread
     void worker_allocate_file_identifiers();
     bool worker_integrate_changes_from_downstream(WorkerState&);
+    void worker_compact_history(WorkerState&);
     ServerHistory& get_client_file_history(WorkerState& state, std::unique_ptr<ServerHistory>& hist_ptr,
                                            DBRef& sg_ptr);
     ServerHistory& get_reference_file_history(WorkerState& state);
@@ -672,6 +731,8 @@ private:
     void group_finalize_work_stage_2();
     void finalize_work_stage_1();
     void finalize_work_stage_2();
+
+    void handle_file_opened(std::exception_ptr);
 };
 
 
@@ -706,7 +767,7 @@ public:
     std::shared_ptr<util::Logger> logger_ptr;
     util::Logger& logger;
 
-    explicit Worker(ServerImpl&);
+    Worker(ServerImpl&, const std::string& logger_prefix);
 
     ServerFileAccessCache& get_file_access_cache() noexcept;
 
@@ -826,9 +887,11 @@ public:
         return m_scratch_memory;
     }
 
-    Worker& get_worker() noexcept
+    // Each file is handled by the same worker for the life of the server
+    Worker& get_worker(const std::string& virt_path) noexcept
     {
-        return m_worker;
+        std::size_t i = std::hash<std::string>{}(virt_path) % m_workers.size();
+        return *m_workers[i];
     }
 
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section)
@@ -837,6 +900,11 @@ public:
         sequential_section = m_seq_time;
     }
 
+    ServerFileAccessCache::Metrics get_file_access_metrics() const noexcept
+    {
+        return m_file_access_cache.get_metrics();
+    }
+
     ServerImpl(const std::string& root_dir, util::Optional<sync::PKey>, Server::Config);
     ~ServerImpl() noexcept;
 
@@ -903,15 +971,23 @@ public:
                                       disable_sync_to_disk)); // Throws
         }
 
-        file->initialize();
-        m_files[virt_path] = file; // Throws
-        file->activate();          // Throws
+        if (m_file_access_cache.can_open_async()) {
+            m_files[virt_path] = file; // Throws
+            file->initialize_async();  // Throws
+        }
+        else {
+            file->initialize();
+            m_files[virt_path] = file; // Throws
+        }
+        file->activate(); // Throws
         return file;
     }
 
-    std::unique_ptr<ServerHistory> make_history_for_path()
+    // The history draws random numbers from \a context, which must therefore
+    // not be shared with other threads. Worker threads pass their Worker.
+    std::unique_ptr<ServerHistory> make_history_for_path(ServerHistory::Context& context)
     {
-        return std::make_unique<ServerHistory>(*this);
+        return std::make_unique<ServerHistory>(context);
     }
 
     util::bind_ptr<ServerFile> get_file(const std::string& virt_path) noexcept
@@ -922,6 +998,21 @@ public:
         return {};
     }
 
+    // Forget a file that could not be opened, such that the next session
+    // binding to it makes a new attempt.
+    void remove_file(const std::string& virt_path) noexcept
+    {
+        m_files.erase(virt_path);
+    }
+
+    SyncConnection* get_sync_connection(int_fast64_t connection_id) noexcept
+    {
+        auto i = m_sync_connections.find(connection_id);
+        if (REALM_LIKELY(i != m_sync_connections.end()))
+            return i->second.get();
+        return nullptr;
+    }
+
     // Returns the number of seconds since the Epoch of
     // std::chrono::system_clock.
     std::chrono::system_clock::time_point token_expiration_clock_now() const noexcept
@@ -997,7 +1088,7 @@ private:
 
     std::unique_ptr<network::ssl::Context> m_ssl_context;
     ServerFileAccessCache m_file_access_cache;
-    Worker m_worker;
+    std::vector<std::unique_ptr<Worker>> m_workers;
     std::map<std::string, util::bind_ptr<ServerFile>> m_files; // Key is virtual path
     network::Acceptor m_acceptor;
     std::int_fast64_t m_next_conn_id = 0;
@@ -1032,6 +1123,8 @@ private:
     void initiate_accept();
     void handle_accept(std::error_code);
 
+    void prefetch_files();
+
     void reap_connections();
     void initiate_connection_reaper_timer(milliseconds_type timeout);
     void do_close_connections();
@@ -1043,6 +1136,18 @@ private:
         return config.max_upload_backlog;
     }
 
+    // Used by the background threads of `m_file_access_cache` to have the
+    // completion of opening a file executed by the event loop thread.
+    ServerFileAccessCache::PostFunc make_file_access_cache_post_func()
+    {
+        return [this](util::UniqueFunction<void()> func) {
+            m_service.post([func = std::move(func)](Status status) mutable {
+                if (status != ErrorCodes::OperationAborted)
+                    func(); // Throws
+            }); // Throws
+        };
+    }
+
     static ProtocolVersionRange determine_protocol_version_range(Server::Config& config)
     {
         const int actual_min = ServerImplBase::get_oldest_supported_protocol_version();
@@ -1079,7 +1184,8 @@ public:
     SyncConnection(ServerImpl& serv, std::int_fast64_t id, std::unique_ptr<network::Socket>&& socket,
                    std::unique_ptr<network::ssl::Stream>&& ssl_stream,
                    std::unique_ptr<network::ReadAheadBuffer>&& read_ahead_buffer, int client_protocol_version,
-                   std::string client_user_agent, std::string remote_endpoint, std::string appservices_request_id)
+                   std::string client_user_agent, std::string remote_endpoint, std::string appservices_request_id,
+                   std::string websocket_extensions)
         : logger_ptr{std::make_shared<util::PrefixLogger>(util::LogCategory::server, make_logger_prefix(id),
                                                           serv.logger_ptr)} // Throws
         , logger{*logger_ptr}
@@ -1088,11 +1194,12 @@ public:
         , m_socket{std::move(socket)}
         , m_ssl_stream{std::move(ssl_stream)}
         , m_read_ahead_buffer{std::move(read_ahead_buffer)}
-        , m_websocket{*this}
+        , m_websocket{*this, make_websocket_options(serv.get_config())}
         , m_client_protocol_version{client_protocol_version}
         , m_client_user_agent{std::move(client_user_agent)}
         , m_remote_endpoint{std::move(remote_endpoint)}
         , m_appservices_request_id{std::move(appservices_request_id)}
+        , m_websocket_extensions{std::move(websocket_extensions)}
     {
         // Make the output buffer stream throw std::bad_alloc if it fails to
         // expand the buffer
@@ -1239,6 +1346,25 @@ public:
         return m_id;
     }
 
+    bool is_closing() const noexcept
+    {
+        return m_is_closing;
+    }
+
+    // Hold back the handling of incoming messages, as a session has been bound
+    // to a Realm file that is still being opened in the background (see
+    // ServerFile::add_waiting_connection()). Pings are still answered. The
+    // held back messages count towards the upload backlog limit (see
+    // Server::Config::max_upload_backlog), and the connection is closed if
+    // they exceed it.
+    void defer_message_processing() noexcept
+    {
+        m_is_awaiting_file = true;
+    }
+
+    // Handle the messages received since defer_message_processing() was called.
+    void resume_message_processing();
+
     network::Socket& get_socket() noexcept
     {
         return *m_socket;
@@ -1325,6 +1451,10 @@ private:
 
     const std::string m_appservices_request_id;
 
+    // The value of the Sec-WebSocket-Extensions header of the handshake
+    // response, or empty if no extensions were accepted.
+    const std::string m_websocket_extensions;
+
     // A queue of sessions that have enlisted for an opportunity to send a
     // message. Sessions will be served in the order that they enlist. A session
     // can only occur once in this queue (linked list). If the queue is not
@@ -1344,6 +1474,11 @@ private:
     bool m_is_sending = false;
     bool m_is_closing = false;
 
+    // See defer_message_processing().
+    bool m_is_awaiting_file = false;
+    std::deque<std::string> m_deferred_messages;
+    std::size_t m_deferred_messages_byte_size = 0;
+
     bool m_send_pong = false;
     bool m_sending_pong = false;
 
@@ -1837,8 +1972,8 @@ private:
         }
 
         std::error_code ec;
-        util::Optional<HTTPResponse> response =
-            websocket::make_http_response(request, sec_websocket_protocol_2, ec); // Throws
+        util::Optional<HTTPResponse> response = websocket::make_http_response(
+            request, sec_websocket_protocol_2, make_websocket_options(m_server.get_config()), ec); // Throws
 
         if (ec) {
             if (ec == websocket::HttpError::bad_request_header_upgrade) {
@@ -1870,8 +2005,15 @@ private:
                 user_agent = i->second; // Throws (copy)
         }
 
+        std::string websocket_extensions;
+        {
+            auto i = response->headers.find("Sec-WebSocket-Extensions");
+            if (i != response->headers.end())
+                websocket_extensions = i->second; // Throws (copy)
+        }
+
         auto handler = [protocol_version = m_negotiated_protocol_version, user_agent = std::move(user_agent),
-                        this](std::error_code ec) {
+                        websocket_extensions = std::move(websocket_extensions), this](std::error_code ec) {
             // If the operation is aborted, the socket object may have been destroyed.
             if (ec != util::error::operation_aborted) {
                 if (ec) {
@@ -1882,7 +2024,7 @@ private:
                 std::unique_ptr<SyncConnection> sync_conn = std::make_unique<SyncConnection>(
                     m_server, m_id, std::move(m_socket), std::move(m_ssl_stream), std::move(m_read_ahead_buffer),
                     protocol_version, std::move(user_agent), std::move(m_remote_endpoint),
-                    get_appservices_request_id()); // Throws
+                    get_appservices_request_id(), std::move(websocket_extensions)); // Throws
                 SyncConnection& sync_conn_ref = *sync_conn;
                 m_server.add_sync_connection(m_id, std::move(sync_conn));
                 m_server.remove_http_connection(m_id);
@@ -2293,6 +2435,10 @@ public:
 
         m_server_file->add_unidentified_session(this); // Throws
 
+        // The messages that follow require the file to be open
+        if (m_server_file->is_opening())
+            m_server_file->add_waiting_connection(m_connection); // Throws
+
         logger.info("Client info: (path='%1', from=%2, protocol=%3) %4", path, m_connection.get_remote_endpoint(),
                     m_connection.get_client_protocol_version(),
                     m_connection.get_client_user_agent()); // Throws
@@ -2704,6 +2850,7 @@ public:
 
         logger.debug("Received: MARK(request_ident=%1)", request_ident); // Throws
 
+        m_server_file->register_client_access(m_client_file_ident); // Throws
         m_download_completion_request = request_ident;
 
         ensure_enlisted_to_send();
@@ -2860,7 +3007,7 @@ private:
             const char* body;
             std::size_t uncompressed_body_size;
             std::size_t compressed_body_size = 0;
-            bool body_is_compressed = false;
+            BodyCompression body_compression = BodyCompression::none;
             version_type end_version = last_server_version.version;
             DownloadCursor download_progress;
             UploadCursor upload_progress = {0, 0};
@@ -2871,13 +3018,20 @@ private:
             ServerProtocol& protocol = get_server_protocol();
             bool enable_cache = (config.enable_download_bootstrap_cache && m_download_progress.server_version == 0 &&
                                  m_upload_progress.client_version == 0 && m_upload_threshold.client_version == 0);
+            int protocol_version = m_connection.get_client_protocol_version();
             DownloadCache& cache = m_server_file->get_download_cache();
-            bool fetch_from_cache = (enable_cache && cache.body && end_version == cache.end_version);
+            // A cached body compressed with zstd cannot be sent to a client
+            // which negotiated an older protocol version.
+            bool cache_is_usable =
+                (cache.body_compression != BodyCompression::zstd ||
+                 protocol_version >= sync::get_zstd_body_compression_protocol_version());
+            bool fetch_from_cache =
+                (enable_cache && cache.body && end_version == cache.end_version && cache_is_usable);
             if (fetch_from_cache) {
                 body = cache.body.get();
                 uncompressed_body_size = cache.uncompressed_body_size;
                 compressed_body_size = cache.compressed_body_size;
-                body_is_compressed = cache.body_is_compressed;
+                body_compression = cache.body_compression;
                 download_progress = cache.download_progress;
                 downloadable_bytes = cache.downloadable_bytes;
                 num_changesets = cache.num_changesets;
@@ -2918,16 +3072,13 @@ private:
                     uncompressed_body_size = out.size();
                     BinaryData uncompressed = {out.data(), uncompressed_body_size};
                     body = uncompressed.data();
-                    std::size_t max_uncompressed = 1024;
-                    if (uncompressed.size() > max_uncompressed) {
-                        compression::CompressMemoryArena& arena = server.get_compress_memory_arena();
-                        std::vector<char>& buffer = server.get_misc_buffers().compress;
-                        compression::allocate_and_compress(arena, uncompressed, buffer); // Throws
-                        if (buffer.size() < uncompressed.size()) {
-                            body = buffer.data();
-                            compressed_body_size = buffer.size();
-                            body_is_compressed = true;
-                        }
+                    compression::CompressMemoryArena& arena = server.get_compress_memory_arena();
+                    std::vector<char>& buffer = server.get_misc_buffers().compress;
+                    body_compression =
+                        _impl::compress_message_body(protocol_version, arena, uncompressed, buffer); // Throws
+                    if (body_compression != BodyCompression::none) {
+                        body = buffer.data();
+                        compressed_body_size = buffer.size();
                     }
                     num_changesets = handler.num_changesets;
                     accum_original_size = handler.accum_original_size;
@@ -2942,12 +3093,13 @@ private:
                         return;
                     }
                     REALM_ASSERT(upload_progress.client_version == 0);
+                    bool body_is_compressed = (body_compression != BodyCompression::none);
                     std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
                     cache.body = std::make_unique<char[]>(body_size); // Throws
                     std::copy(body, body + body_size, cache.body.get());
                     cache.uncompressed_body_size = uncompressed_body_size;
                     cache.compressed_body_size = compressed_body_size;
-                    cache.body_is_compressed = body_is_compressed;
+                    cache.body_compression = body_compression;
                     cache.end_version = end_version;
                     cache.download_progress = download_progress;
                     cache.downloadable_bytes = downloadable_bytes;
@@ -2967,11 +3119,11 @@ private:
 
             OutputBuffer& out = m_connection.get_output_buffer();
             protocol.make_download_message(
-                m_connection.get_client_protocol_version(), out, m_session_ident, download_progress.server_version,
+                protocol_version, out, m_session_ident, download_progress.server_version,
                 download_progress.last_integrated_client_version, last_server_version.version,
                 last_server_version.salt, upload_progress.client_version,
                 upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets, body,
-                uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+                uncompressed_body_size, compressed_body_size, body_compression, logger); // Throws
 
             m_download_progress = download_progress;
             logger.debug("Setting of m_download_progress.server_version = %1",
@@ -3189,11 +3341,13 @@ void SessionQueue::clear() noexcept
 
 ServerFile::ServerFile(ServerImpl& server, ServerFileAccessCache& cache, const std::string& virt_path,
                        std::string real_path, bool disable_sync_to_disk)
-    : logger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.logger_ptr}               // Throws
-    , wlogger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.get_worker().logger_ptr} // Throws
+    : logger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.logger_ptr} // Throws
+    , wlogger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ",
+              server.get_worker(virt_path).logger_ptr} // Throws
     , m_server{server}
+    , m_worker{server.get_worker(virt_path)}
     , m_file{cache, real_path, virt_path, false, disable_sync_to_disk} // Throws
-    , m_worker_file{server.get_worker().get_file_access_cache(), real_path, virt_path, true, disable_sync_to_disk}
+    , m_worker_file{m_worker.get_file_access_cache(), real_path, virt_path, true, disable_sync_to_disk}
 {
 }
 
@@ -3222,10 +3376,85 @@ void ServerFile::initialize()
 void ServerFile::activate() {}
 
 
+void ServerFile::initialize_async()
+{
+    REALM_ASSERT(!m_is_opening);
+    m_is_opening = true;
+    // ServerFile objects are kept by the server until it is destroyed, and the
+    // handler is only executed while the server is running.
+    m_file.async_open([this](std::exception_ptr error) {
+        handle_file_opened(error); // Throws
+    });                            // Throws
+}
+
+
+void ServerFile::add_waiting_connection(SyncConnection& conn)
+{
+    REALM_ASSERT(m_is_opening);
+    m_waiting_connections.push_back(conn.get_id()); // Throws
+    conn.defer_message_processing();
+}
+
+
+void ServerFile::handle_file_opened(std::exception_ptr error)
+{
+    REALM_ASSERT(m_is_opening);
+    m_is_opening = false;
+
+    // Keep this file alive, as it is forgotten by the server if it could not
+    // be opened.
+    util::bind_ptr<ServerFile> protect{this};
+    if (REALM_LIKELY(!error)) {
+        initialize(); // Throws
+    }
+    else {
+        try {
+            std::rethrow_exception(error);
+        }
+        catch (const std::exception& e) {
+            logger.error("Failed to open Realm file: %1", e.what()); // Throws
+        }
+        m_server.remove_file(get_virt_path());
+
+        // The waiting sessions are all unidentified, as the IDENT messages
+        // are among the held back messages. Deactivating a session detaches
+        // it from this file.
+        std::vector<Session*> sessions{m_unidentified_sessions.begin(), m_unidentified_sessions.end()}; // Throws
+        for (Session* sess : sessions) {
+            SyncConnection& conn = sess->get_connection();
+            if (REALM_LIKELY(!conn.is_closing()))
+                conn.protocol_error(ProtocolError::other_session_error, sess); // Throws
+        }
+    }
+
+    // The connections are looked up one at a time, as connections may be
+    // closed while the messages of another one are handled.
+    std::vector<std::int_fast64_t> connections = std::move(m_waiting_connections);
+    m_waiting_connections.clear();
+    for (std::int_fast64_t connection_id : connections) {
+        if (SyncConnection* conn = m_server.get_sync_connection(connection_id))
+            conn->resume_message_processing(); // Throws
+    }
+
+    // Work requested while the file was being opened, such as the
+    // allocation of client file identifiers, was held back.
+    if (m_has_blocked_work && !m_has_work_in_progress && !error)
+        group_unblock_work(); // Throws
+}
+
+
 // This function must be called only after a completed invocation of
 // initialize(). Both functinos must only ever be called by the network event
 // loop thread.
-void ServerFile::register_client_access(file_ident_type) {}
+//
+// The access is recorded in the history by the next compaction, such that a
+// client which is connected, but does not upload anything, is not expired.
+void ServerFile::register_client_access(file_ident_type client_file_ident)
+{
+    if (m_server.get_config().history_compaction_interval == 0)
+        return;
+    m_client_access_times[client_file_ident] = std::time(nullptr); // Throws
+}
 
 
 auto ServerFile::request_file_ident(FileIdentReceiver& receiver, file_ident_type proxy_file,
@@ -3398,8 +3627,11 @@ void ServerFile::worker_process_work_unit(WorkerState& state)
         if (REALM_UNLIKELY(!m_work.file_ident_alloc_slots.empty()))
             worker_allocate_file_identifiers(); // Throws
 
-        if (!m_work.changesets_from_downstream.empty())
-            worker_integrate_changes_from_downstream(state); // Throws
+        if (!m_work.changesets_from_downstream.empty()) {
+            bool produced_new_sync_version = worker_integrate_changes_from_downstream(state); // Throws
+            if (produced_new_sync_version && m_server.get_config().history_compaction_interval > 0)
+                worker_compact_history(state); // Throws
+        }
     }
 
     wlogger.debug("Work unit execution completed"); // Throws
@@ -3440,7 +3672,7 @@ void ServerFile::on_work_added()
         return;
     m_has_blocked_work = true;
     // Reference file
-    if (m_has_work_in_progress)
+    if (m_has_work_in_progress || m_is_opening)
         return;
     group_unblock_work(); // Throws
 }
@@ -3455,8 +3687,7 @@ void ServerFile::group_unblock_work()
         if (REALM_LIKELY(work.has_primary_work)) {
             logger.trace("Work unit unblocked"); // Throws
             m_has_work_in_progress = true;
-            Worker& worker = m_server.get_worker();
-            worker.enqueue(this); // Throws
+            m_worker.enqueue(this); // Throws
         }
     }
 }
@@ -3513,6 +3744,15 @@ void ServerFile::unblock_work()
 
     m_num_changesets_from_downstream = 0;
     m_has_blocked_work = false;
+
+    if (m_server.get_config().history_compaction_interval > 0) {
+        // Every identified session counts as active, even when it is idle.
+        for (const auto& entry : m_identified_sessions)
+            register_client_access(entry.first); // Throws
+        m_work.client_accesses.reserve(m_client_access_times.size()); // Throws
+        for (const auto& [client_file_ident, timestamp] : m_client_access_times)
+            m_work.client_accesses.push_back({client_file_ident, timestamp});
+    }
 }
 
 
@@ -3581,13 +3821,46 @@ bool ServerFile::worker_integrate_changes_from_downstream(WorkerState& state)
     return produced_new_sync_version;
 }
 
+
+// Discards instructions without effect from the part of the history that no
+// client will merge against again. This produces a new Realm version, but not
+// a new sync version.
+//
+// NOTE: This function is executed by the worker thread
+void ServerFile::worker_compact_history(WorkerState& state)
+{
+    std::time_t min_interval = std::time_t(m_server.get_config().history_compaction_interval);
+    std::time_t now = std::time(nullptr);
+    if (m_last_compaction_attempt_at != 0 && now - m_last_compaction_attempt_at < min_interval)
+        return;
+    m_last_compaction_attempt_at = now;
+
+    std::unique_ptr<ServerHistory> hist_ptr;
+    DBRef sg_ptr;
+    ServerHistory& hist = get_client_file_history(state, hist_ptr, sg_ptr);
+    std::time_t client_ttl = std::time_t(m_server.get_config().history_ttl);
+    ServerHistory::CompactionResult result;
+    sync::VersionInfo version_info;
+    if (hist.compact_history(min_interval, client_ttl, m_work.client_accesses, result, version_info,
+                             wlogger)) { // Throws
+        m_work.recorded_client_accesses = true;
+        REALM_ASSERT(version_info.sync_version.version == m_work.version_info.sync_version.version);
+        m_work.version_info = version_info;
+        m_work.produced_new_realm_version = true;
+        if (result.num_bytes_reclaimed > 0) {
+            wlogger.detail("Reclaimed %1 bytes of history through server version %2",
+                           result.num_bytes_reclaimed, result.compacted_until_version); // Throws
+        }
+    }
+}
+
 ServerHistory& ServerFile::get_client_file_history(WorkerState& state, std::unique_ptr<ServerHistory>& hist_ptr,
                                                    DBRef& sg_ptr)
 {
     if (state.use_file_cache)
         return worker_access().history; // Throws
     const std::string& path = m_worker_file.realm_path;
-    hist_ptr = m_server.make_history_for_path();                   // Throws
+    hist_ptr = m_server.make_history_for_path(m_worker);           // Throws
     DBOptions options = m_worker_file.make_shared_group_options(); // Throws
     sg_ptr = DB::create(*hist_ptr, path, options);                 // Throws
     sg_ptr->claim_sync_agent();                                    // Throws
@@ -3628,6 +3901,15 @@ void ServerFile::group_postprocess_stage_3()
 
 void ServerFile::finalize_work_stage_1()
 {
+    if (m_work.recorded_client_accesses) {
+        // Keep the accesses that happened while the work was in progress
+        for (const ClientAccess& access : m_work.client_accesses) {
+            auto i = m_client_access_times.find(access.client_file_ident);
+            if (i != m_client_access_times.end() && i->second <= access.timestamp)
+                m_client_access_times.erase(i);
+        }
+    }
+
     if (m_unblocked_changesets_from_downstream_byte_size > 0) {
         // Report the byte size of completed downstream changesets.
         std::size_t byte_size = m_unblocked_changesets_from_downstream_byte_size;
@@ -3724,8 +4006,8 @@ void ServerFile::finalize_work_stage_2()
 
 // ============================ Worker implementation ============================
 
-Worker::Worker(ServerImpl& server)
-    : logger_ptr{std::make_shared<util::PrefixLogger>(util::LogCategory::server, "Worker: ", server.logger_ptr)}
+Worker::Worker(ServerImpl& server, const std::string& logger_prefix)
+    : logger_ptr{std::make_shared<util::PrefixLogger>(util::LogCategory::server, logger_prefix, server.logger_ptr)}
     // Throws
     , logger(*logger_ptr)
     , m_server{server}
@@ -3789,12 +4071,19 @@ ServerImpl::ServerImpl(const std::string& root_dir, util::Optional<sync::PKey> p
     , m_root_dir{root_dir} // Throws
     , m_access_control{std::move(pkey)}
     , m_protocol_version_range{determine_protocol_version_range(config)}                 // Throws
-    , m_file_access_cache{m_config.max_open_files, logger, *this, config.encryption_key} // Throws
-    , m_worker{*this}                                                                    // Throws
+    , m_file_access_cache{m_config.max_open_files, logger, *this, config.encryption_key,
+                          m_config.num_file_open_threads, make_file_access_cache_post_func()} // Throws
     , m_acceptor{get_service()}
     , m_server_protocol{}       // Throws
     , m_compress_memory_arena{} // Throws
 {
+    int num_workers = std::max(m_config.num_worker_threads, 1);
+    m_workers.reserve(num_workers); // Throws
+    for (int i = 0; i < num_workers; ++i) {
+        std::string logger_prefix = (num_workers == 1 ? "Worker: " : util::format("Worker[%1]: ", i + 1)); // Throws
+        m_workers.push_back(std::make_unique<Worker>(*this, logger_prefix));                           // Throws
+    }
+
     if (m_config.ssl) {
         m_ssl_context = std::make_unique<network::ssl::Context>();                // Throws
         m_ssl_context->use_certificate_chain_file(m_config.ssl_certificate_path); // Throws
@@ -3835,8 +4124,11 @@ void ServerImpl::start()
         logger.warn("Build mode is Debug! CAN SEVERELY IMPACT PERFORMANCE - "
                     "NOT RECOMMENDED FOR PRODUCTION"); // Throws
     }
-    logger.info("Directory holding persistent state: %1", m_root_dir);        // Throws
-    logger.info("Maximum number of open files: %1", m_config.max_open_files); // Throws
+    logger.info("Directory holding persistent state: %1", m_root_dir);              // Throws
+    logger.info("Maximum number of open files: %1", m_config.max_open_files);       // Throws
+    logger.info("Number of worker threads: %1", m_workers.size());                  // Throws
+    logger.info("Number of file open threads: %1", m_config.num_file_open_threads); // Throws
+    logger.info("Number of prefetched files: %1", m_config.num_prefetched_files);   // Throws
     {
         const char* lead_text = "Encryption";
         if (m_config.encryption_key) {
@@ -3873,6 +4165,9 @@ void ServerImpl::start()
 
     m_realm_names = _impl::find_realm_files(m_root_dir); // Throws
 
+    if (m_config.num_prefetched_files > 0)
+        prefetch_files(); // Throws
+
     initiate_connection_reaper_timer(m_config.connection_reaper_interval); // Throws
 
     listen(); // Throws
@@ -3884,19 +4179,27 @@ void ServerImpl::run()
     auto ta = util::make_temp_assign(m_running, true);
 
     {
-        auto worker_thread = util::make_thread_exec_guard(m_worker, *this); // Throws
+        std::vector<util::ThreadExecGuardWithParent<Worker, ServerImpl>> worker_threads;
+        worker_threads.reserve(m_workers.size()); // Throws
         std::string name;
-        if (util::Thread::get_name(name)) {
-            name += "-worker";
-            worker_thread.start_with_signals_blocked(name); // Throws
-        }
-        else {
-            worker_thread.start_with_signals_blocked(); // Throws
+        bool has_name = util::Thread::get_name(name);
+        for (std::size_t i = 0; i < m_workers.size(); ++i) {
+            auto& worker_thread = worker_threads.emplace_back(*m_workers[i], *this); // Throws
+            if (has_name) {
+                std::string worker_name = name + "-worker";
+                if (m_workers.size() > 1)
+                    worker_name += "-" + std::to_string(i + 1); // Throws
+                worker_thread.start_with_signals_blocked(worker_name); // Throws
+            }
+            else {
+                worker_thread.start_with_signals_blocked(); // Throws
+            }
         }
 
         m_service.run(); // Throws
 
-        worker_thread.stop_and_rethrow(); // Throws
+        for (auto& worker_thread : worker_threads)
+            worker_thread.stop_and_rethrow(); // Throws
     }
 
     logger.info("Realm sync server stopped");
@@ -3941,6 +4244,32 @@ std::mt19937_64& ServerImpl::server_history_get_random() noexcept
 }
 
 
+// Open the most recently modified Realm files ahead of the first client
+// connecting to them, such that clients reconnecting after a restart of the
+// server do not all have to wait for their files to be opened.
+void ServerImpl::prefetch_files()
+{
+    std::vector<std::pair<std::time_t, const std::string*>> files;
+    files.reserve(m_realm_names.size()); // Throws
+    for (const std::string& virt_path : m_realm_names) {
+        _impl::VirtualPathComponents virt_path_components =
+            _impl::parse_virtual_path(m_root_dir, virt_path); // Throws
+        REALM_ASSERT(virt_path_components.is_valid);
+        std::time_t last_write_time = util::File::last_write_time(virt_path_components.real_realm_path); // Throws
+        files.emplace_back(last_write_time, &virt_path);
+    }
+    std::size_t n = std::min({files.size(), std::size_t(m_config.num_prefetched_files),
+                              std::size_t(m_config.max_open_files)});
+    std::partial_sort(files.begin(), files.begin() + n, files.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+    for (std::size_t i = 0; i < n; ++i) {
+        logger.detail("Prefetching Realm file: %1", *files[i].second); // Throws
+        get_or_create_file(*files[i].second);                         // Throws
+    }
+}
+
+
 void ServerImpl::listen()
 {
     network::Resolver resolver{get_service()};
@@ -4186,7 +4515,7 @@ void SyncConnection::initiate()
 {
     m_last_activity_at = steady_clock_now();
     logger.debug("Sync Connection initiated");
-    m_websocket.initiate_server_websocket_after_handshake();
+    m_websocket.initiate_server_websocket_after_handshake(m_websocket_extensions);
     send_log_message(util::Logger::Level::info, "Client connection established with server", 0,
                      m_appservices_request_id);
 }
@@ -4472,6 +4801,22 @@ void SyncConnection::message_before_ident(const char* message_type, session_iden
 
 void SyncConnection::handle_message_received(const char* data, size_t size)
 {
+    if (REALM_UNLIKELY(m_is_awaiting_file)) {
+        if (REALM_UNLIKELY(m_is_closing))
+            return;
+        // FIXME: Part of a very poor man's substitute for a proper
+        // backpressure scheme (see ServerFile::can_add_changesets_from_downstream()).
+        if (REALM_UNLIKELY(size > m_server.get_max_upload_backlog() - m_deferred_messages_byte_size)) {
+            logger.debug("Closing connection because too many messages were received while waiting for a "
+                         "Realm file to be opened"); // Throws
+            protocol_error(ProtocolError::connection_closed); // Throws
+            return;
+        }
+        m_deferred_messages.emplace_back(data, size); // Throws
+        m_deferred_messages_byte_size += size;
+        return;
+    }
+
     // parse_message_received() parses the message and calls the
     // proper handler on the SyncConnection object (this).
     get_server_protocol().parse_message_received<SyncConnection>(*this, std::string_view(data, size));
@@ -4479,6 +4824,23 @@ void SyncConnection::handle_message_received(const char* data, size_t size)
 }
 
 
+void SyncConnection::resume_message_processing()
+{
+    REALM_ASSERT(m_is_awaiting_file);
+    m_is_awaiting_file = false;
+
+    // A deferred BIND message may refer to another file that is still being
+    // opened, in which case the remaining messages are held back again.
+    while (!m_is_awaiting_file && !m_deferred_messages.empty()) {
+        std::string message = std::move(m_deferred_messages.front());
+        m_deferred_messages.pop_front();
+        m_deferred_messages_byte_size -= message.size();
+        if (REALM_LIKELY(!m_is_closing))
+            handle_message_received(message.data(), message.size()); // Throws
+    }
+}
+
+
 void SyncConnection::handle_ping_received(const char* data, size_t size)
 {
     // parse_message_received() parses the message and calls the
@@ -4842,3 +5204,16 @@ void Server::get_workunit_timers(milliseconds_type& parallel_section, millisecon
 {
     m_impl->get_workunit_timers(parallel_section, sequential_section);
 }
+
+
+auto Server::get_file_access_metrics() const noexcept -> FileAccessMetrics
+{
+    _impl::ServerFileAccessCache::Metrics metrics = m_impl->get_file_access_metrics();
+    FileAccessMetrics metrics_2;
+    metrics_2.num_hits = metrics.num_hits;
+    metrics_2.num_misses = metrics.num_misses;
+    metrics_2.num_async_opens = metrics.num_async_opens;
+    metrics_2.total_open_time = metrics.total_open_time;
+    metrics_2.max_open_time = metrics.max_open_time;
+    return metrics_2;
+}
@@ -1,6 +1,7 @@
 #ifndef REALM_SYNC_SERVER_HPP
 #define REALM_SYNC_SERVER_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -71,11 +72,17 @@ public:
 
         /// The maximum number of Realm files that will be kept open
         /// concurrently by each major thread inside the server. The server
-        /// currently has two major threads (foreground and background). The
-        /// server keeps a cache of open Realm files for efficiency reasons (one
-        /// for each major thread).
+        /// has one foreground thread and `num_worker_threads` background
+        /// threads. The server keeps a cache of open Realm files for
+        /// efficiency reasons (one for each major thread).
         long max_open_files = 256;
 
+        /// The number of background threads integrating uploaded changesets.
+        /// Each Realm file is handled by one of them, chosen from its virtual
+        /// path, so a file with a large backlog of uploads only delays the
+        /// integration for the files sharing its thread.
+        int num_worker_threads = 1;
+
         /// An optional custom clock to be used for token expiration checks. If
         /// no clock is specified, the server will use the system clock.
         Clock* token_expiration_clock = nullptr;
@@ -174,6 +181,34 @@ public:
         /// for the need to resend the same changes after network disconnects.
         std::size_t max_download_size = 0x1000000; // 16 MiB
 
+        /// If nonzero, the sync history of a Realm file is compacted by the
+        /// worker thread after it has integrated changesets uploaded to that
+        /// file, but no more often than once per this number of seconds. See
+        /// ServerHistory::compact_history().
+        long history_compaction_interval = 0;
+
+        /// If nonzero, history compaction expires direct clients that have not
+        /// advanced their upload progress for this number of seconds, such
+        /// that clients that stay away do not hold back the compaction. An
+        /// expired client must reset its file if it reconnects.
+        long history_ttl = 0;
+
+        /// The number of background threads used to open Realm files that
+        /// clients bind to, when they are not already open. While a file is
+        /// being opened, the connections of the binding clients hold back
+        /// their remaining messages, but the network event loop thread is free
+        /// to serve other connections. The held back messages count towards
+        /// `max_upload_backlog`. If a file cannot be opened, the sessions
+        /// bound to it fail, and the next session binding to it makes a new
+        /// attempt. If zero, files are opened by the network event loop
+        /// thread.
+        int num_file_open_threads = 0;
+
+        /// At startup, open up to this number of Realm files ahead of the
+        /// first client binding to them, picking the most recently modified
+        /// ones. Bounded by `max_open_files`.
+        long num_prefetched_files = 0;
+
         /// The maximum number of connections that can be queued up waiting to
         /// be accepted by the server. This corresponds to the `backlog`
         /// argument of the `listen()` function as described by POSIX.
@@ -191,6 +226,20 @@ public:
         /// sure to research the subject before you enable this option.
         bool tcp_no_delay = false;
 
+        /// If true, the server accepts the permessage-deflate WebSocket
+        /// extension (RFC 7692) when the client offers it, which compresses
+        /// the messages sent in both directions on the connection.
+        bool websocket_permessage_deflate = false;
+
+        /// If false, the server asks that each message is compressed on its
+        /// own when permessage-deflate is used, rather than referring back to
+        /// the previous messages on the connection.
+        bool websocket_deflate_context_takeover = true;
+
+        /// A compressed message from a client which decompresses to more than
+        /// this many bytes is treated as a protocol error.
+        std::size_t websocket_max_inflated_message_size = 64 * 1024 * 1024;
+
         /// An optional 64 byte key to encrypt all files with.
         std::optional<std::array<char, 64>> encryption_key;
 
@@ -350,6 +399,25 @@ public:
     /// of the server.
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section);
 
+    struct FileAccessMetrics {
+        /// Number of accesses to a Realm file by the network event loop thread
+        /// that found the file open, or that had to open it.
+        std::uint_fast64_t num_hits = 0;
+        std::uint_fast64_t num_misses = 0;
+
+        /// Number of Realm files opened on a background thread (see
+        /// Config::num_file_open_threads).
+        std::uint_fast64_t num_async_opens = 0;
+
+        /// Accumulated and maximum time spent opening a single Realm file.
+        std::chrono::microseconds total_open_time{0};
+        std::chrono::microseconds max_open_time{0};
+    };
+
+    /// Get statistics about the cache of open Realm files used by the network
+    /// event loop thread. This function is thread-safe.
+    FileAccessMetrics get_file_access_metrics() const noexcept;
+
 private:
     class Implementation;
     std::unique_ptr<Implementation> m_impl;
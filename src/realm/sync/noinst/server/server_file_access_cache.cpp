@@ -4,6 +4,22 @@ using namespace realm;
 using namespace _impl;
 
 
+ServerFileAccessCache::~ServerFileAccessCache() noexcept
+{
+    std::deque<util::UniqueFunction<void()>> abandoned_jobs;
+    {
+        std::lock_guard lock{m_open_mutex};
+        m_stop_open_threads = true;
+        abandoned_jobs.swap(m_open_jobs);
+    }
+    m_open_cond.notify_all();
+    for (auto& thread : m_open_threads)
+        thread.join();
+
+    REALM_ASSERT(!m_first_open_file);
+}
+
+
 void ServerFileAccessCache::proper_close_all()
 {
     while (m_first_open_file)
@@ -11,10 +27,23 @@ void ServerFileAccessCache::proper_close_all()
 }
 
 
+auto ServerFileAccessCache::get_metrics() const noexcept -> Metrics
+{
+    Metrics metrics;
+    metrics.num_hits = m_num_hits.load(std::memory_order_relaxed);
+    metrics.num_misses = m_num_misses.load(std::memory_order_relaxed);
+    metrics.num_async_opens = m_num_async_opens.load(std::memory_order_relaxed);
+    metrics.total_open_time = std::chrono::microseconds(m_total_open_time_us.load(std::memory_order_relaxed));
+    metrics.max_open_time = std::chrono::microseconds(m_max_open_time_us.load(std::memory_order_relaxed));
+    return metrics;
+}
+
+
 void ServerFileAccessCache::access(Slot& slot)
 {
     if (slot.is_open()) {
         m_logger.trace(util::LogCategory::server, "Using already open Realm file: %1", slot.realm_path); // Throws
+        m_num_hits.fetch_add(1, std::memory_order_relaxed);
 
         // Move to front
         REALM_ASSERT(m_first_open_file);
@@ -26,16 +55,66 @@ void ServerFileAccessCache::access(Slot& slot)
         return;
     }
 
-    // Close least recently accessed Realm file
+    m_num_misses.fetch_add(1, std::memory_order_relaxed);
+    close_least_recently_accessed(); // Throws
+    slot.open();                     // Throws
+}
+
+
+// Make room for one more open file
+void ServerFileAccessCache::close_least_recently_accessed()
+{
     if (m_num_open_files == m_max_open_files) {
         REALM_ASSERT(m_first_open_file);
         Slot& least_recently_accessed = *m_first_open_file->m_prev_open_file;
         least_recently_accessed.proper_close(); // Throws
     }
+}
+
+
+void ServerFileAccessCache::add_open_job(util::UniqueFunction<void()> job)
+{
+    std::lock_guard lock{m_open_mutex};
+    m_open_jobs.push_back(std::move(job)); // Throws
+    if (m_num_idle_open_threads == 0 && m_open_threads.size() < std::size_t(m_num_open_threads)) {
+        m_open_threads.emplace_back([this] {
+            open_thread();
+        }); // Throws
+    }
+    m_open_cond.notify_one();
+}
+
+
+void ServerFileAccessCache::open_thread()
+{
+    std::unique_lock lock{m_open_mutex};
+    for (;;) {
+        ++m_num_idle_open_threads;
+        m_open_cond.wait(lock, [&] {
+            return m_stop_open_threads || !m_open_jobs.empty();
+        });
+        --m_num_idle_open_threads;
+        if (m_stop_open_threads)
+            return;
+        util::UniqueFunction<void()> job = std::move(m_open_jobs.front());
+        m_open_jobs.pop_front();
+        lock.unlock();
+        job();
+        lock.lock();
+    }
+}
 
-    slot.open(); // Throws
+
+void ServerFileAccessCache::record_open_time(std::chrono::steady_clock::duration duration) noexcept
+{
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    m_total_open_time_us.fetch_add(us, std::memory_order_relaxed);
+    auto max = m_max_open_time_us.load(std::memory_order_relaxed);
+    while (us > max && !m_max_open_time_us.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
 }
 
+
 void ServerFileAccessCache::Slot::proper_close()
 {
     if (is_open()) {
@@ -51,8 +130,65 @@ void ServerFileAccessCache::Slot::open()
 
     m_cache.m_logger.detail("Opening Realm file: %1", realm_path); // Throws
 
-    m_file.reset(new File{*this}); // Throws
+    auto start_time = std::chrono::steady_clock::now();
+    std::unique_ptr<File> file{new File{*this}};                              // Throws
+    file->open(realm_path, make_shared_group_options(), m_claim_sync_agent); // Throws
+    m_cache.record_open_time(std::chrono::steady_clock::now() - start_time);
+
+    m_file = std::move(file);
+    m_cache.insert(*this);
+    m_cache.m_first_open_file = this;
+    ++m_cache.m_num_open_files;
+}
+
+
+void ServerFileAccessCache::Slot::async_open(OpenHandler handler)
+{
+    REALM_ASSERT(m_cache.can_open_async());
+    REALM_ASSERT(!is_open());
+
+    m_cache.m_logger.detail("Opening Realm file in background: %1", realm_path); // Throws
+    m_cache.m_num_misses.fetch_add(1, std::memory_order_relaxed);
+
+    // The history is constructed here, as doing so accesses the history
+    // context. The job must not access the slot, as it may run after the slot
+    // is destroyed if the owner of the cache stops processing posted
+    // functions.
+    std::unique_ptr<File> file{new File{*this}}; // Throws
+    auto job = [cache = &m_cache, slot = this, file = std::move(file), path = realm_path,
+                options = make_shared_group_options(), claim_sync_agent = m_claim_sync_agent,
+                handler = std::move(handler)]() mutable {
+        std::exception_ptr error;
+        auto start_time = std::chrono::steady_clock::now();
+        try {
+            file->open(path, options, claim_sync_agent); // Throws
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        cache->record_open_time(std::chrono::steady_clock::now() - start_time);
+        cache->m_post([slot, file = std::move(file), handler = std::move(handler), error]() mutable {
+            if (!error)
+                slot->install(std::move(file)); // Throws
+            handler(error);                     // Throws
+        });                                     // Throws
+    };
+    m_cache.add_open_job(std::move(job)); // Throws
+}
+
+
+void ServerFileAccessCache::Slot::install(std::unique_ptr<File> file)
+{
+    if (is_open()) {
+        m_cache.m_logger.detail("Discarding Realm file opened in background, as it was opened in the meantime: %1",
+                                realm_path); // Throws
+        return;
+    }
+
+    m_cache.m_num_async_opens.fetch_add(1, std::memory_order_relaxed);
+    m_cache.close_least_recently_accessed(); // Throws
 
+    m_file = std::move(file);
     m_cache.insert(*this);
     m_cache.m_first_open_file = this;
     ++m_cache.m_num_open_files;
@@ -2,12 +2,21 @@
 #ifndef REALM_NOINST_SERVER_FILE_ACCESS_CACHE_HPP
 #define REALM_NOINST_SERVER_FILE_ACCESS_CACHE_HPP
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <utility>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <random>
+#include <thread>
+#include <vector>
 
 #include <realm/util/assert.hpp>
+#include <realm/util/functional.hpp>
 #include <realm/util/logger.hpp>
 #include <realm/db.hpp>
 #include <realm/util/optional.hpp>
@@ -23,19 +32,58 @@ public:
     class Slot;
     class File;
 
+    /// Used to have a function executed by the thread that owns the cache.
+    using PostFunc = util::UniqueFunction<void(util::UniqueFunction<void()>)>;
+
+    /// Statistics about the accesses to the files of the cache.
+    struct Metrics {
+        /// Number of accesses that found the file already open.
+        std::uint_fast64_t num_hits = 0;
+
+        /// Number of accesses that had to open the file, including the ones
+        /// initiated by Slot::async_open().
+        std::uint_fast64_t num_misses = 0;
+
+        /// Number of files opened by Slot::async_open().
+        std::uint_fast64_t num_async_opens = 0;
+
+        /// Accumulated and maximum time spent opening a single file.
+        std::chrono::microseconds total_open_time{0};
+        std::chrono::microseconds max_open_time{0};
+    };
+
     /// \param max_open_files The maximum number of Realm files to keep open
     /// concurrently. Must be greater than or equal to 1.
     ///
     /// The specified history context will not be accessed on behalf of this
     /// cache object before the first invocation of Slot::access() on an
     /// associated file file slot.
+    ///
+    /// \param num_open_threads The number of background threads available to
+    /// Slot::async_open(). If zero, files can only be opened by
+    /// Slot::access(). The threads are started on demand.
+    ///
+    /// \param post Must be specified if \a num_open_threads is greater than
+    /// zero. Used by the background threads to have the completion of an
+    /// asynchronous open executed by the thread that owns the cache. Must be
+    /// thread-safe.
     ServerFileAccessCache(long max_open_files, util::Logger&, ServerHistory::Context&,
-                          util::Optional<std::array<char, 64>> encryption_key);
+                          util::Optional<std::array<char, 64>> encryption_key, int num_open_threads = 0,
+                          PostFunc post = nullptr);
 
+    /// Waits for the background threads to finish the open operation they are
+    /// currently executing. Open operations that have not yet started are
+    /// abandoned.
     ~ServerFileAccessCache() noexcept;
 
     void proper_close_all();
 
+    /// Returns true if files can be opened by Slot::async_open().
+    bool can_open_async() const noexcept;
+
+    /// This function is thread-safe.
+    Metrics get_metrics() const noexcept;
+
 private:
     /// Null if `m_num_open_files == 0`, otherwise it points to the most
     /// recently accessed open Realm file. `m_first_open_file->m_next_open_file`
@@ -53,9 +101,29 @@ private:
     util::Logger& m_logger;
     ServerHistory::Context& m_history_context;
 
+    const int m_num_open_threads;
+    const PostFunc m_post;
+
+    std::mutex m_open_mutex;
+    std::condition_variable m_open_cond;                   // Protected by `m_open_mutex`
+    std::deque<util::UniqueFunction<void()>> m_open_jobs; // Protected by `m_open_mutex`
+    std::vector<std::thread> m_open_threads;               // Protected by `m_open_mutex`
+    int m_num_idle_open_threads = 0;                       // Protected by `m_open_mutex`
+    bool m_stop_open_threads = false;                      // Protected by `m_open_mutex`
+
+    std::atomic<std::uint_fast64_t> m_num_hits{0};
+    std::atomic<std::uint_fast64_t> m_num_misses{0};
+    std::atomic<std::uint_fast64_t> m_num_async_opens{0};
+    std::atomic<std::int_fast64_t> m_total_open_time_us{0};
+    std::atomic<std::int_fast64_t> m_max_open_time_us{0};
+
     void access(Slot&);
+    void close_least_recently_accessed();
     void remove(Slot&) noexcept;
     void insert(Slot&) noexcept;
+    void add_open_job(util::UniqueFunction<void()>);
+    void open_thread();
+    void record_open_time(std::chrono::steady_clock::duration) noexcept;
 };
 
 
@@ -89,6 +157,26 @@ public:
     /// objects of the same ServerFileAccessCache object to be closed.
     File& access();
 
+    using OpenHandler = util::UniqueFunction<void(std::exception_ptr)>;
+
+    /// Open the Realm file at `realm_path` on one of the background threads of
+    /// the cache, such that the thread owning the cache is not blocked while
+    /// the file is opened. The cache must have been constructed with a nonzero
+    /// number of open threads (see can_open_async()), and the file must not be
+    /// open already.
+    ///
+    /// Once the file is open, it is added as the most recently accessed file,
+    /// and \a handler is called with a null argument. If opening the file
+    /// fails, \a handler is called with the exception. In both cases, \a
+    /// handler is executed through the post function passed to the cache
+    /// constructor. If the file was opened by access() in the meantime, the
+    /// file opened in the background is discarded.
+    ///
+    /// The caller must ensure that this slot is not destroyed while \a handler
+    /// is pending, which it can do by having \a handler keep the owner of the
+    /// slot alive.
+    void async_open(OpenHandler handler);
+
     /// Same as close() but also generates a log message. This function throws
     /// if logging throws.
     void proper_close();
@@ -109,6 +197,7 @@ private:
     std::unique_ptr<File> m_file;
 
     void open();
+    void install(std::unique_ptr<File>);
     void do_close() noexcept;
 
     friend class ServerFileAccessCache;
@@ -121,8 +210,13 @@ public:
     DBRef shared_group;
 
 private:
+    // Only constructs the history. open() must be called before the file is
+    // made available.
     File(const Slot&);
 
+    // May be called by any thread, as it only accesses the arguments.
+    void open(const std::string& realm_path, const DBOptions&, bool claim_sync_agent);
+
     friend class Slot;
 };
 
@@ -131,18 +225,23 @@ private:
 
 inline ServerFileAccessCache::ServerFileAccessCache(long max_open_files, util::Logger& logger,
                                                     ServerHistory::Context& history_context,
-                                                    util::Optional<std::array<char, 64>> encryption_key)
+                                                    util::Optional<std::array<char, 64>> encryption_key,
+                                                    int num_open_threads, PostFunc post)
     : m_max_open_files{max_open_files}
     , m_encryption_key{encryption_key}
     , m_logger{logger}
     , m_history_context{history_context}
+    , m_num_open_threads{num_open_threads}
+    , m_post{std::move(post)}
 {
     REALM_ASSERT(m_max_open_files >= 1);
+    REALM_ASSERT(m_num_open_threads >= 0);
+    REALM_ASSERT(m_num_open_threads == 0 || m_post);
 }
 
-inline ServerFileAccessCache::~ServerFileAccessCache() noexcept
+inline bool ServerFileAccessCache::can_open_async() const noexcept
 {
-    REALM_ASSERT(!m_first_open_file);
+    return (m_num_open_threads > 0);
 }
 
 inline void ServerFileAccessCache::remove(Slot& slot) noexcept
@@ -241,10 +340,15 @@ inline void ServerFileAccessCache::Slot::do_close() noexcept
 }
 
 inline ServerFileAccessCache::File::File(const Slot& slot)
-    : history{slot.m_cache.m_history_context}                                              // Throws
-    , shared_group{DB::create(history, slot.realm_path, slot.make_shared_group_options())} // Throws
+    : history{slot.m_cache.m_history_context} // Throws
+{
+}
+
+inline void ServerFileAccessCache::File::open(const std::string& realm_path, const DBOptions& options,
+                                              bool claim_sync_agent)
 {
-    if (slot.m_claim_sync_agent) {
+    shared_group = DB::create(history, realm_path, options); // Throws
+    if (claim_sync_agent) {
         shared_group->claim_sync_agent();
     }
 }
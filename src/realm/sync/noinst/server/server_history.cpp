@@ -225,6 +225,46 @@ namespace {
 constexpr ServerHistory::file_ident_type g_root_node_file_ident = 1;
 
 
+// An Update that replaces the value of a field of an object as a whole, as
+// opposed to one that creates a nested structure, or changes something inside
+// one.
+bool is_plain_field_update(const sync::Instruction::Update& instr) noexcept
+{
+    using Type = sync::Instruction::Payload::Type;
+    return instr.path.size() == 0 && instr.value.type >= Type::Null;
+}
+
+
+bool has_destructive_schema_change(const Changeset& changeset)
+{
+    return std::any_of(changeset.begin(), changeset.end(), [](const sync::Instruction* instr) {
+        return instr &&
+               (instr->get_if<sync::Instruction::EraseTable>() || instr->get_if<sync::Instruction::EraseColumn>());
+    });
+}
+
+
+util::Optional<GlobalID> get_link_target(const Changeset& changeset, const sync::Instruction& instr)
+{
+    const sync::Instruction::Payload* value = nullptr;
+    if (auto update = instr.get_if<sync::Instruction::Update>()) {
+        value = &update->value;
+    }
+    else if (auto insert = instr.get_if<sync::Instruction::ArrayInsert>()) {
+        value = &insert->value;
+    }
+    else if (auto set_insert = instr.get_if<sync::Instruction::SetInsert>()) {
+        value = &set_insert->value;
+    }
+    else if (auto set_erase = instr.get_if<sync::Instruction::SetErase>()) {
+        value = &set_erase->value;
+    }
+    if (!value || value->type != sync::Instruction::Payload::Type::Link)
+        return util::none;
+    return GlobalID{changeset.get_string(value->data.link.target_table), changeset.get_key(value->data.link.target)};
+}
+
+
 } // unnamed namespace
 
 
@@ -644,7 +684,7 @@ void ServerHistory::add_client_file(salt_type file_ident_salt, file_ident_type p
     std::int_fast64_t last_seen_timestamp = 0;
     std::int_fast64_t locked_server_version = 0;
     if (is_direct_client(client_type)) {
-        last_seen_timestamp = 1;
+        last_seen_timestamp = std::int_fast64_t(std::time(nullptr));
     }
     m_acc->cf_ident_salts.insert(realm::npos, std::int_fast64_t(file_ident_salt));  // Throws
     m_acc->cf_client_versions.insert(realm::npos, client_version);                  // Throws
@@ -932,6 +972,245 @@ std::vector<sync::Changeset> ServerHistory::get_parsed_changesets(version_type b
 }
 
 
+bool ServerHistory::compact_history(std::time_t min_interval, std::time_t client_ttl,
+                                    const std::vector<ClientAccess>& client_accesses, CompactionResult& result,
+                                    sync::VersionInfo& version_info, util::Logger& logger)
+{
+    TransactionRef tr = m_db->start_write(); // Throws
+    version_type realm_version = tr->get_version();
+    ensure_updated(realm_version); // Throws
+    prepare_for_write();           // Throws
+
+    // Changes of local origin are uploaded to the upstream server from the
+    // sync history, so it must be left as it is.
+    if (m_acc->upstream_status.is_attached() || m_acc->partial_sync.is_attached())
+        return false;
+
+    std::time_t now = std::time(nullptr);
+    auto last_compaction_at =
+        std::time_t(m_acc->root.get_as_ref_or_tagged(s_last_compaction_timestamp_iip).get_as_int());
+    if (last_compaction_at != 0 && now - last_compaction_at < min_interval)
+        return false;
+
+    // A client that is active in a session is seen, even if it has nothing
+    // to upload.
+    bool dirty = false;
+    for (const ClientAccess& access : client_accesses) {
+        std::size_t i = std::size_t(access.client_file_ident);
+        REALM_ASSERT(i < m_num_client_files);
+        if (!is_direct_client(ClientType(m_acc->cf_client_types.get(i))))
+            continue;
+        std::int_fast64_t last_seen_timestamp = m_acc->cf_last_seen_timestamps.get(i);
+        bool expired = (last_seen_timestamp == 0);
+        if (!expired && last_seen_timestamp < std::int_fast64_t(access.timestamp)) {
+            m_acc->cf_last_seen_timestamps.set(i, std::int_fast64_t(access.timestamp)); // Throws
+            dirty = true;
+        }
+    }
+
+    // Every unexpired direct client may still upload changesets that need to
+    // be merged with the entries that follow its reciprocal history base
+    // version. A client that has been neither seen nor advanced its upload
+    // progress for `client_ttl` seconds is expired first, such that it no
+    // longer holds back the compaction. It will be told to reset if it
+    // reconnects.
+    version_type end_version = get_server_version();
+    for (std::size_t i = 0; i < m_num_client_files; ++i) {
+        auto client_type = ClientType(m_acc->cf_client_types.get(i));
+        if (!is_direct_client(client_type))
+            continue;
+        std::int_fast64_t last_seen_timestamp = m_acc->cf_last_seen_timestamps.get(i);
+        bool expired = (last_seen_timestamp == 0);
+        if (expired)
+            continue;
+        if (client_ttl > 0) {
+            if (last_seen_timestamp == 1) {
+                // Recorded before timestamps were maintained, so start the
+                // clock now.
+                m_acc->cf_last_seen_timestamps.set(i, std::int_fast64_t(now)); // Throws
+                dirty = true;
+            }
+            else if (now - std::time_t(last_seen_timestamp) >= client_ttl) {
+                expire_client_file(i); // Throws
+                ++result.num_expired_client_files;
+                dirty = true;
+                continue;
+            }
+        }
+        auto rh_base_version = version_type(m_acc->cf_rh_base_versions.get(i));
+        auto locked_server_version = version_type(m_acc->cf_locked_server_versions.get(i));
+        end_version = std::min(end_version, rh_base_version);
+        if (locked_server_version != 0)
+            end_version = std::min(end_version, locked_server_version);
+    }
+    auto compacted_until_version =
+        version_type(m_acc->root.get_as_ref_or_tagged(s_compacted_until_version_iip).get_as_int());
+    version_type begin_version = std::max(compacted_until_version, m_history_base_version);
+    if (end_version <= begin_version) {
+        if (!dirty)
+            return false;
+        // Commit the changes to the client file entries, leaving the history
+        // entries as they are.
+        end_version = begin_version;
+    }
+
+    std::size_t begin_ndx = std::size_t(begin_version - m_history_base_version);
+    std::vector<Changeset> changesets;
+    changesets.reserve(std::size_t(end_version - begin_version)); // Throws
+    std::size_t num_analyzed = 0;
+    for (version_type version = begin_version + 1; version <= end_version; ++version) {
+        std::size_t ndx = std::size_t(version - m_history_base_version - 1);
+        Changeset changeset;
+        ChunkedBinaryData binary{m_acc->sh_changesets, ndx};
+        ChunkedBinaryInputStream stream{binary};
+        parse_changeset(stream, changeset); // Throws
+        bool destructive = has_destructive_schema_change(changeset);
+        changesets.push_back(std::move(changeset)); // Throws
+        if (destructive) {
+            // Included in the compacted range, but left untouched, such that
+            // the next compaction can proceed past it.
+            end_version = version;
+            break;
+        }
+        num_analyzed = changesets.size();
+    }
+
+    // An instruction is identified by the index of its changeset among those
+    // being compacted, and its index within that changeset.
+    using Instruction = realm::sync::Instruction;
+    using InstructionPosition = std::pair<std::size_t, std::size_t>;
+    struct ObjectState {
+        bool created_first = false;
+        bool erased_last = false;
+        bool is_link_target = false;
+        std::vector<InstructionPosition> instructions;
+    };
+    struct FieldState {
+        InstructionPosition last_instruction;
+        bool last_is_plain_update = false;
+        bool last_is_default = false;
+    };
+    std::map<GlobalID, ObjectState> objects;
+    std::map<std::pair<GlobalID, StringData>, FieldState> fields;
+    std::vector<std::vector<bool>> discard(changesets.size());
+
+    for (std::size_t i = 0; i < changesets.size(); ++i)
+        discard[i].resize(changesets[i].size());
+    for (std::size_t i = 0; i < num_analyzed; ++i) {
+        const Changeset& changeset = changesets[i];
+        std::size_t j = 0;
+        for (auto it = changeset.begin(); it != changeset.end(); ++it, ++j) {
+            const Instruction& instr = **it;
+            auto obj_instr = instr.get_if<Instruction::ObjectInstruction>();
+            if (!obj_instr)
+                continue;
+            InstructionPosition position = {i, j};
+            GlobalID id{changeset.get_string(obj_instr->table), changeset.get_key(obj_instr->object)};
+            ObjectState& object = objects[id];
+            if (object.instructions.empty())
+                object.created_first = (instr.get_if<Instruction::CreateObject>() != nullptr);
+            object.erased_last = (instr.get_if<Instruction::EraseObject>() != nullptr);
+            object.instructions.push_back(position);
+            if (auto target = get_link_target(changeset, instr))
+                objects[*target].is_link_target = true;
+
+            auto path_instr = instr.get_if<Instruction::PathInstruction>();
+            if (!path_instr)
+                continue;
+            FieldState& field = fields[{id, changeset.get_string(path_instr->field)}];
+            auto update = instr.get_if<Instruction::Update>();
+            bool is_plain_update = (update && is_plain_field_update(*update));
+            bool is_default = (is_plain_update && update->is_default);
+            if (is_plain_update && field.last_is_plain_update && (field.last_is_default || !is_default)) {
+                auto [k, l] = field.last_instruction;
+                discard[k][l] = true;
+            }
+            field.last_instruction = position;
+            field.last_is_plain_update = is_plain_update;
+            field.last_is_default = is_default;
+        }
+    }
+
+    for (const auto& entry : objects) {
+        const ObjectState& object = entry.second;
+        if (!object.created_first || !object.erased_last || object.is_link_target)
+            continue;
+        for (std::size_t k = 0; k + 1 < object.instructions.size(); ++k) {
+            auto [i, j] = object.instructions[k];
+            discard[i][j] = true;
+        }
+    }
+
+    // Re-encode the changesets with discarded instructions, and adjust the
+    // cumulative byte sizes of all subsequent history entries.
+    std::int_fast64_t num_bytes_reclaimed = 0;
+    for (std::size_t i = 0; i < changesets.size(); ++i) {
+        std::size_t ndx = begin_ndx + i;
+        Changeset& changeset = changesets[i];
+        std::size_t num_discarded = 0;
+        std::size_t j = 0;
+        for (auto it = changeset.begin(); it != changeset.end(); ++j) {
+            if (discard[i][j]) {
+                it = changeset.erase_stable(it);
+                ++num_discarded;
+            }
+            else {
+                ++it;
+            }
+        }
+        if (num_discarded > 0) {
+            ChangesetEncoder::Buffer buffer;
+            encode_changeset(changeset, buffer); // Throws
+            std::size_t orig_size = ChunkedBinaryData(m_acc->sh_changesets, ndx).size();
+            // See comment in add_sync_history_entry() on BinaryData(0,0).
+            BinaryData data = (buffer.size() == 0 ? BinaryData{"", 0} : BinaryData{buffer.data(), buffer.size()});
+            m_acc->sh_changesets.set(ndx, data); // Throws
+            num_bytes_reclaimed += std::int_fast64_t(orig_size) - std::int_fast64_t(data.size());
+            result.num_discarded_instructions += num_discarded;
+            if (changeset.empty())
+                ++result.num_emptied_changesets;
+        }
+        if (num_bytes_reclaimed != 0) {
+            std::int_fast64_t cumul_byte_size = m_acc->sh_cumul_byte_sizes.get(ndx);
+            m_acc->sh_cumul_byte_sizes.set(ndx, cumul_byte_size - num_bytes_reclaimed); // Throws
+        }
+    }
+    if (num_bytes_reclaimed != 0) {
+        for (std::size_t ndx = begin_ndx + changesets.size(); ndx < m_history_size; ++ndx) {
+            std::int_fast64_t cumul_byte_size = m_acc->sh_cumul_byte_sizes.get(ndx);
+            m_acc->sh_cumul_byte_sizes.set(ndx, cumul_byte_size - num_bytes_reclaimed); // Throws
+        }
+    }
+
+    m_acc->root.set(s_compacted_until_version_iip, RefOrTagged::make_tagged(end_version)); // Throws
+    m_acc->root.set(s_last_compaction_timestamp_iip, RefOrTagged::make_tagged(std::uint_fast64_t(now))); // Throws
+
+    version_info.realm_version = tr->commit(); // Throws
+    version_info.sync_version = get_salted_server_version();
+    result.compacted_until_version = end_version;
+    result.num_bytes_reclaimed = std::uint_fast64_t(num_bytes_reclaimed);
+    if (result.num_expired_client_files > 0)
+        logger.debug("Expired %1 client files during history compaction", result.num_expired_client_files); // Throws
+    logger.debug("Compacted history entries for server versions %1 through %2: Discarded %3 instructions, "
+                 "emptied %4 changesets, and reclaimed %5 bytes",
+                 begin_version + 1, end_version, result.num_discarded_instructions, result.num_emptied_changesets,
+                 result.num_bytes_reclaimed); // Throws
+    return true;
+}
+
+
+void ServerHistory::expire_client_file(std::size_t client_file_index)
+{
+    // The reciprocal history is only needed for merging changesets that the
+    // client may still upload.
+    if (ref_type ref = m_acc->cf_recip_hist_refs.get(client_file_index)) {
+        m_acc->cf_recip_hist_refs.set(client_file_index, 0); // Throws
+        Array::destroy_deep(ref, m_db->get_alloc());
+    }
+    m_acc->cf_last_seen_timestamps.set(client_file_index, 0); // Throws
+}
+
+
 class ServerHistory::ReciprocalHistory : private ArrayParent {
 public:
     ReciprocalHistory(BPlusTree<ref_type>& cf_recip_hist_refs, std::size_t remote_file_index,
@@ -1200,7 +1479,7 @@ bool ServerHistory::integrate_remote_changesets(file_ident_type remote_file_iden
     }
 
     if (from_downstream && dirty) {
-        m_acc->cf_last_seen_timestamps.set(remote_file_index, 1);
+        m_acc->cf_last_seen_timestamps.set(remote_file_index, std::int_fast64_t(std::time(nullptr))); // Throws
     }
 
     return dirty;
@@ -406,6 +406,64 @@ public:
 
     std::vector<sync::Changeset> get_parsed_changesets(version_type begin, version_type end) const;
 
+    struct CompactionResult {
+        /// The last server version covered by the compaction.
+        version_type compacted_until_version = 0;
+        std::size_t num_discarded_instructions = 0;
+        std::size_t num_emptied_changesets = 0;
+        std::uint_fast64_t num_bytes_reclaimed = 0;
+        std::size_t num_expired_client_files = 0;
+    };
+
+    /// The time of the most recent session activity of a direct client, such
+    /// as identifying itself, or being sent a DOWNLOAD or a MARK message.
+    struct ClientAccess {
+        file_ident_type client_file_ident;
+        std::time_t timestamp;
+    };
+
+    /// \brief Discard instructions from the sync history that have no effect
+    /// on the resulting state.
+    ///
+    /// Only history entries that are older than the upload cursor of every
+    /// unexpired direct client (and older than any nonzero locked server
+    /// version) are considered, as no client will ever need to merge against
+    /// them again, and only entries that were not considered by a previous
+    /// compaction. The range ends before the first changeset that erases a
+    /// table or a column.
+    ///
+    /// Within that range, an Update of a field is discarded when the next
+    /// instruction touching the same field is another Update overwriting it,
+    /// and for an object that is created and later erased, every instruction
+    /// touching it, except the final EraseObject, is discarded unless the
+    /// object is the target of a link. The EraseObject is kept, as erasure
+    /// always wins against modifications of the object.
+    ///
+    /// The affected changesets are re-encoded in place, such that every
+    /// history entry retains its server version, origin, and timestamp.
+    /// Entries left without instructions become empty, and are therefore
+    /// skipped during download. The cumulative byte sizes are updated
+    /// accordingly.
+    ///
+    /// \param min_interval The minimum number of seconds that must have passed
+    /// since the previous compaction of this history.
+    ///
+    /// \param client_ttl If nonzero, direct clients that have been neither
+    /// active in a session nor advanced their upload progress for this number
+    /// of seconds are expired before the range is determined. Otherwise, a
+    /// client that stays away holds back the compaction indefinitely.
+    ///
+    /// \param client_accesses Session activity of direct clients since the
+    /// previous compaction. Their last seen timestamps are brought forward
+    /// before any client is expired, such that a client which only downloads
+    /// is not expired while it stays connected.
+    ///
+    /// \return True if, and only if a new Realm version was produced, in
+    /// which case \a version_info will have been updated.
+    bool compact_history(std::time_t min_interval, std::time_t client_ttl,
+                         const std::vector<ClientAccess>& client_accesses, CompactionResult&,
+                         sync::VersionInfo& version_info, util::Logger&);
+
     // History inspection for debugging purposes and for testing the
     // backup.
     struct HistoryContents {
@@ -725,6 +783,10 @@ private:
     bool update_upload_progress(version_type orig_client_version, ReciprocalHistory& recip_hist,
                                 UploadCursor upload_progress);
 
+    // Mark the specified direct client file entry as expired, and discard its
+    // reciprocal history.
+    void expire_client_file(std::size_t client_file_index);
+
     void fixup_state_and_changesets_for_assigned_file_ident(Transaction&, file_ident_type);
 
     void record_current_schema_version();
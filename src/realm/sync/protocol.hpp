@@ -63,6 +63,11 @@ namespace sync {
 //   14 Support for server initiated bootstraps, including bootstraps for role/
 //      permissions changes instead of performing a client reset when changed.
 //
+//   15 Support for zstd compressed UPLOAD and DOWNLOAD message bodies. The
+//      `<is body compressed>` header field becomes a compression method, where
+//      0 is none, 1 is zlib, and 2 is zstd. This version is only offered by
+//      builds with zstd support (REALM_HAVE_ZSTD).
+//
 //  XX Changes:
 //     - TBD
 //
@@ -70,7 +75,18 @@ constexpr int get_current_protocol_version() noexcept
 {
     // Also update the "flx: verify websocket protocol number and prefixes" test
     // in flx_sync.cpp when updating this value
+#if REALM_HAVE_ZSTD
+    return 15;
+#else
     return 14;
+#endif
+}
+
+/// The first protocol version in which the body of UPLOAD and DOWNLOAD
+/// messages may be compressed with zstd.
+constexpr int get_zstd_body_compression_protocol_version() noexcept
+{
+    return 15;
 }
 
 constexpr std::string_view get_pbs_websocket_protocol_prefix() noexcept
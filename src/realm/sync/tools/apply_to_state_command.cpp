@@ -105,7 +105,7 @@ DownloadMessage DownloadMessage::parse(HeaderLineParser& msg, Logger& logger, bo
         ret.batch_state = sync::DownloadBatchState::SteadyState;
     }
     ret.downloadable_bytes = msg.read_next<int64_t>();
-    auto is_body_compressed = msg.read_next<bool>();
+    auto body_compression = msg.read_next<int>();
     auto uncompressed_body_size = msg.read_next<size_t>();
     auto compressed_body_size = msg.read_next<size_t>('\n');
 
@@ -117,10 +117,14 @@ DownloadMessage DownloadMessage::parse(HeaderLineParser& msg, Logger& logger, bo
                  ret.latest_server_version.version);
 
     std::string_view body_str;
-    if (is_body_compressed) {
+    if (!is_valid_body_compression(body_compression)) {
+        throw ProtocolCodecException(util::format("bad body compression method %1", body_compression));
+    }
+    if (body_compression != int(BodyCompression::none)) {
         ret.uncompressed_body_buffer.set_size(uncompressed_body_size);
         auto compressed_body = msg.read_sized_data<BinaryData>(compressed_body_size);
-        std::error_code ec = util::compression::decompress(compressed_body, ret.uncompressed_body_buffer);
+        std::error_code ec = decompress_message_body(BodyCompression(body_compression), compressed_body,
+                                                     ret.uncompressed_body_buffer);
 
         if (ec) {
             throw ProtocolCodecException("error decompressing download message");
@@ -162,19 +166,23 @@ UploadMessage UploadMessage::parse(HeaderLineParser& msg, Logger& logger)
     UploadMessage ret;
 
     ret.session_ident = msg.read_next<sync::session_ident_type>();
-    auto is_body_compressed = msg.read_next<bool>();
+    auto body_compression = msg.read_next<int>();
     auto uncompressed_body_size = msg.read_next<size_t>();
     auto compressed_body_size = msg.read_next<size_t>();
     ret.upload_progress.client_version = msg.read_next<sync::version_type>();
     ret.upload_progress.last_integrated_server_version = msg.read_next<sync::version_type>();
     ret.locked_server_version = msg.read_next<sync::version_type>('\n');
 
-    // if is_body_compressed == true, we must decompress the received body.
+    // if the body is compressed, we must decompress the received body.
     std::string_view body_str;
-    if (is_body_compressed) {
+    if (!is_valid_body_compression(body_compression)) {
+        throw ProtocolCodecException(util::format("bad body compression method %1", body_compression));
+    }
+    if (body_compression != int(BodyCompression::none)) {
         ret.uncompressed_body_buffer.set_size(uncompressed_body_size);
         auto compressed_body = msg.read_sized_data<BinaryData>(compressed_body_size);
-        std::error_code ec = util::compression::decompress(compressed_body, ret.uncompressed_body_buffer);
+        std::error_code ec = decompress_message_body(BodyCompression(body_compression), compressed_body,
+                                                     ret.uncompressed_body_buffer);
 
         if (ec) {
             throw ProtocolCodecException("error decompressing upload message");
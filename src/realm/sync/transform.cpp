@@ -2376,6 +2376,56 @@ void TransformerImpl::merge_instructions(MajorSide& their_side, MinorSide& our_s
     }
 }
 
+// Returns true if merging the specified changesets cannot modify any of them,
+// because no instruction on one side touches an object touched by the other.
+//
+// Object instructions are only ever transformed against instructions in the
+// same conflict group, and conflict groups are formed from the objects (and
+// link targets) referenced by the instructions, so instructions that touch
+// disjoint sets of objects never meet. The exceptions are local schema
+// instructions, which are merged against everything, and incoming
+// EraseTable/EraseColumn instructions, which collapse the index into a single
+// conflict group.
+bool changesets_are_disjoint(util::Span<Changeset> their_changesets, util::Span<Changeset*> our_changesets)
+{
+    using GlobalID = _impl::ChangesetIndex::GlobalID;
+    std::vector<GlobalID> their_ids;
+
+    for (Changeset& changeset : their_changesets) {
+        for (auto it = changeset.begin(); it != changeset.end(); ++it) {
+            if (!*it)
+                continue;
+            const Instruction& instr = **it;
+            if (instr.get_if<Instruction::EraseTable>() || instr.get_if<Instruction::EraseColumn>())
+                return false;
+            if (_impl::is_schema_change(instr))
+                continue;
+            GlobalID ids[2];
+            size_t num_ids = _impl::get_object_ids_in_instruction(changeset, instr, ids, 2);
+            their_ids.insert(their_ids.end(), ids, ids + num_ids);
+        }
+    }
+    std::sort(their_ids.begin(), their_ids.end());
+    their_ids.erase(std::unique(their_ids.begin(), their_ids.end()), their_ids.end());
+
+    for (Changeset* changeset : our_changesets) {
+        for (auto it = changeset->begin(); it != changeset->end(); ++it) {
+            if (!*it)
+                continue;
+            const Instruction& instr = **it;
+            if (_impl::is_schema_change(instr))
+                return false;
+            GlobalID ids[2];
+            size_t num_ids = _impl::get_object_ids_in_instruction(*changeset, instr, ids, 2);
+            for (size_t i = 0; i < num_ids; ++i) {
+                if (std::binary_search(their_ids.begin(), their_ids.end(), ids[i]))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
 } // anonymous namespace
 
 namespace realm::sync {
@@ -2557,7 +2607,17 @@ size_t Transformer::transform_remote_changesets(TransformHistory& history, file_
         bool must_apply_all = false;
 
         if (!our_changesets.empty()) {
-            merge_changesets(local_file_ident, {&*p, same_base_range_end}, our_changesets, logger); // Throws
+            util::Span<Changeset> their_changesets{&*p, same_base_range_end};
+            if (changesets_are_disjoint(their_changesets, our_changesets)) {
+                // Nothing to transform, so skip building the conflict index.
+                ++m_num_skipped_merges;
+                logger.debug(util::LogCategory::changeset,
+                             "Skipped merge of %1 incoming and %2 local changeset(s) touching disjoint objects",
+                             their_changesets.size(), our_changesets.size());
+            }
+            else {
+                merge_changesets(local_file_ident, their_changesets, our_changesets, logger); // Throws
+            }
             // We need to apply all transformed changesets if at least one reciprocal changeset was modified
             // during OT.
             must_apply_all = std::any_of(our_changesets.begin(), our_changesets.end(), [](const Changeset* c) {
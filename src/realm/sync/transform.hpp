@@ -177,8 +177,17 @@ public:
                                        util::Span<Changeset>,
                                        util::FunctionRef<bool(const Changeset*)> changeset_applier, util::Logger&);
 
+    /// The number of times transform_remote_changesets() skipped operational
+    /// transformation because the incoming and the causally unrelated local
+    /// changesets touched disjoint sets of objects.
+    size_t get_num_skipped_merges() const noexcept
+    {
+        return m_num_skipped_merges;
+    }
+
 private:
     std::map<version_type, Changeset> m_reciprocal_transform_cache;
+    size_t m_num_skipped_merges = 0;
 
     Changeset& get_reciprocal_transform(TransformHistory&, file_ident_type local_file_ident, version_type version,
                                         const HistoryEntry&);
@@ -2080,6 +2080,24 @@ void Table::flush_for_commit()
             m_top.set(top_position_for_version, rot_version);
         }
     }
+
+    // An integer leaf keeps its width when the values requiring it are overwritten or
+    // their objects removed. Re-pack the leaves modified in this transaction, so that a
+    // single outlier does not keep a leaf at 64 bits once it is gone. The modified
+    // clusters are visited once, with every integer column narrowed per cluster.
+    if (m_top.is_attached() && !m_top.is_read_only()) {
+        std::vector<ColKey> int_cols;
+        for_each_public_column([&](ColKey col_key) {
+            if (col_key.get_type() == col_type_Int && !col_key.is_nullable() && !col_key.is_collection())
+                int_cols.push_back(col_key);
+            return IteratorControl::AdvanceToNext;
+        });
+        if (!int_cols.empty()) {
+            m_clusters.update_writable([&int_cols](Cluster* cluster) {
+                cluster->reduce_int_leaf_widths(int_cols);
+            });
+        }
+    }
 }
 
 void Table::refresh_content_version()
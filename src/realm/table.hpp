@@ -359,6 +359,11 @@ public:
         return m_clusters.traverse(func);
     }
 
+    bool traverse_clusters(ObjKey begin, ClusterTree::TraverseFromFunction func) const
+    {
+        return m_clusters.traverse(begin, func);
+    }
+
     /// remove_object() removes the specified object from the table.
     /// Any links from the specified object into objects residing in an embedded
     /// table will cause those objects to be deleted as well, and so on recursively.
@@ -21,6 +21,7 @@
 #include <realm/index_string.hpp>
 #include <realm/transaction.hpp>
 
+#include <algorithm>
 #include <unordered_set>
 
 using namespace realm;
@@ -335,6 +336,29 @@ void TableView::sync_if_needed() const
     }
 }
 
+ObjKey TableView::find_more(ObjKey begin, size_t count)
+{
+    REALM_ASSERT(m_query && m_descriptor_ordering.is_empty() && m_limit == size_t(-1));
+    if (begin != ObjKey(0) && has_changed()) {
+        do_sync();
+        return ObjKey();
+    }
+
+    util::CriticalSection cs(m_race_detector);
+    m_query->m_table.check();
+    if (begin == ObjKey(0)) {
+        if (m_key_values.is_attached())
+            m_key_values.clear();
+        else
+            m_key_values.create();
+        m_last_seen_versions.clear();
+        if (m_query->m_view)
+            m_query->m_view->sync_if_needed();
+        get_dependencies(m_last_seen_versions);
+    }
+    return m_query->do_find_more(m_key_values, begin, count);
+}
+
 void TableView::update_query(const Query& q)
 {
     REALM_ASSERT(m_query);
@@ -345,6 +369,42 @@ void TableView::update_query(const Query& q)
     do_sync();
 }
 
+void TableView::sync_changed_objects(const std::vector<ObjKey>& previous, std::vector<ObjKey> changed)
+{
+    util::CriticalSection cs(m_race_detector);
+    REALM_ASSERT(m_query && !m_query->m_view);
+    REALM_ASSERT(m_descriptor_ordering.is_empty() && m_limit == size_t(-1));
+    m_query->m_table.check();
+    m_query->init();
+
+    std::sort(changed.begin(), changed.end());
+    changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+    // Both the previous result and the changed objects are in table order, so
+    // the new result is a merge of the unchanged objects of the previous result
+    // and the changed objects which match the query now
+    m_key_values.clear();
+    m_key_values.reserve(previous.size() + changed.size());
+    auto add_if_match = [&](ObjKey key) {
+        if (auto obj = m_table->try_get_object(key); obj && m_query->eval_object(obj))
+            m_key_values.add(key);
+    };
+    auto it = changed.begin();
+    for (auto key : previous) {
+        for (; it != changed.end() && *it < key; ++it)
+            add_if_match(*it);
+        if (it != changed.end() && *it == key)
+            add_if_match(*it++);
+        else
+            m_key_values.add(key);
+    }
+    for (; it != changed.end(); ++it)
+        add_if_match(*it);
+
+    m_last_seen_versions.clear();
+    get_dependencies(m_last_seen_versions);
+}
+
 void TableView::clear()
 {
     m_table.check();
@@ -259,6 +259,13 @@ public:
     // queries points to the same Table
     void update_query(const Query& q);
 
+    // Synchronize a TableView backed by a query without descriptors or limit by
+    // only evaluating the objects in 'changed' against the query. 'previous' must
+    // be the result of the query at an earlier version, and 'changed' must contain
+    // every object created, modified or removed since then. Only valid if the
+    // query does not depend on any other table than its own.
+    void sync_changed_objects(const std::vector<ObjKey>& previous, std::vector<ObjKey> changed);
+
     std::unique_ptr<TableView> clone() const
     {
         return std::unique_ptr<TableView>(new TableView(*this));
@@ -342,6 +349,15 @@ public:
     // before any of the other access-methods whenever the view may have become
     // outdated.
     void sync_if_needed() const final;
+
+    // Find the next 'count' objects of a view created by Query::find_all() with no
+    // sort, distinct or limit applied, starting from the object with key 'begin'.
+    // Pass ObjKey(0) to find the first part of the view. Returns the key to pass
+    // to the next call, or a null key once the view holds all matching objects.
+    // If the table has changed since the previous call, all matches are found at
+    // once as the objects found earlier may no longer match.
+    ObjKey find_more(ObjKey begin, size_t count);
+
     // Return the version of the source it was created from.
     TableVersions get_dependency_versions() const
     {
@@ -216,7 +216,8 @@ DB::version_type Transaction::commit()
     // before committing, allow any accessors at group level or below to sync
     flush_accessors_for_commit();
 
-    DB::version_type new_version = db->do_commit(*this); // Throws
+    bool group_commit = db->use_group_commit();
+    DB::version_type new_version = db->do_commit(*this, !group_commit); // Throws
 
     // We need to set m_read_lock in order for wait_for_change to work.
     // To set it, we grab a readlock on the latest available snapshot
@@ -226,6 +227,23 @@ DB::version_type Transaction::commit()
 
     db->end_write_on_correct_thread();
 
+    if (group_commit) {
+        // Our read lock still protects the last durable snapshot until the
+        // new one has been synced to disk
+        try {
+            db->wait_for_group_commit(*this, new_version); // Throws
+        }
+        catch (...) {
+            // The new version is already visible to everyone, so leave the
+            // transaction as if the commit had succeeded. The caller can tell
+            // this failure from one before the commit by the transaction no
+            // longer being in the writing stage.
+            do_end_read();
+            m_read_lock = lock_after_commit;
+            throw;
+        }
+    }
+
     do_end_read();
     m_read_lock = lock_after_commit;
 
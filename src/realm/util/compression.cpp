@@ -31,6 +31,11 @@
 #include <os/availability.h>
 #endif
 
+#if REALM_HAVE_ZSTD
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
 using namespace realm;
 using namespace util;
 
@@ -82,6 +87,10 @@ public:
                 return "Decompression error";
             case error::decompress_unsupported:
                 return "Decompression failed due to unsupported input compression";
+            case error::decompressed_size_too_large:
+                return "Decompressed data size exceeds the limit";
+            case error::compress_unsupported:
+                return "Compression failed due to unsupported compression algorithm";
         }
         REALM_UNREACHABLE();
     }
@@ -830,6 +839,19 @@ std::error_code compression::decompress_nonportable(InputStream& compressed, App
     return ::decompress(compressed, compressed_buf, decompressed, header.algorithm, false);
 }
 
+std::error_code compression::decompress_nonportable(InputStream& compressed, Span<char> decompressed)
+{
+    auto compressed_buf = compressed.next_block();
+    auto header = read_header(compressed, compressed_buf);
+    if (header.size == std::numeric_limits<size_t>::max())
+        return error::out_of_memory;
+    if (header.size != decompressed.size())
+        return error::incorrect_decompressed_size;
+    if (header.size == 0)
+        return std::error_code{};
+    return ::decompress(compressed, compressed_buf, decompressed, header.algorithm, false);
+}
+
 std::error_code compression::allocate_and_compress(CompressMemoryArena& compress_memory_arena,
                                                    Span<const char> uncompressed_buf,
                                                    std::vector<char>& compressed_buf)
@@ -866,6 +888,73 @@ std::error_code compression::allocate_and_compress(CompressMemoryArena& compress
     return std::error_code{};
 }
 
+bool compression::zstd_is_available() noexcept
+{
+#if REALM_HAVE_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::error_code compression::allocate_and_compress_zstd(Span<const char> uncompressed_buf,
+                                                        std::vector<char>& compressed_buf, int compression_level)
+{
+#if REALM_HAVE_ZSTD
+    compressed_buf.resize(ZSTD_compressBound(uncompressed_buf.size())); // Throws
+    size_t compressed_size = ZSTD_compress(compressed_buf.data(), compressed_buf.size(), uncompressed_buf.data(),
+                                           uncompressed_buf.size(), compression_level);
+    if (ZSTD_isError(compressed_size)) {
+        switch (ZSTD_getErrorCode(compressed_size)) {
+            case ZSTD_error_memory_allocation:
+                return error::out_of_memory;
+            case ZSTD_error_srcSize_wrong:
+                return error::compress_input_too_long;
+            default:
+                return error::compress_error;
+        }
+    }
+    compressed_buf.resize(compressed_size);
+    return std::error_code{};
+#else
+    static_cast<void>(uncompressed_buf);
+    static_cast<void>(compressed_buf);
+    static_cast<void>(compression_level);
+    return error::compress_unsupported;
+#endif
+}
+
+std::error_code compression::decompress_zstd(Span<const char> compressed_buf, Span<char> decompressed_buf)
+{
+#if REALM_HAVE_ZSTD
+    unsigned long long content_size = ZSTD_getFrameContentSize(compressed_buf.data(), compressed_buf.size());
+    if (content_size == ZSTD_CONTENTSIZE_ERROR)
+        return error::corrupt_input;
+    if (content_size != ZSTD_CONTENTSIZE_UNKNOWN && content_size != decompressed_buf.size())
+        return error::incorrect_decompressed_size;
+
+    size_t decompressed_size = ZSTD_decompress(decompressed_buf.data(), decompressed_buf.size(),
+                                               compressed_buf.data(), compressed_buf.size());
+    if (ZSTD_isError(decompressed_size)) {
+        switch (ZSTD_getErrorCode(decompressed_size)) {
+            case ZSTD_error_memory_allocation:
+                return error::out_of_memory;
+            case ZSTD_error_dstSize_tooSmall:
+                return error::incorrect_decompressed_size;
+            default:
+                return error::corrupt_input;
+        }
+    }
+    if (decompressed_size != decompressed_buf.size())
+        return error::incorrect_decompressed_size;
+    return std::error_code{};
+#else
+    static_cast<void>(compressed_buf);
+    static_cast<void>(decompressed_buf);
+    return error::decompress_unsupported;
+#endif
+}
+
 void compression::allocate_and_compress_nonportable(CompressMemoryArena& arena, Span<const char> uncompressed,
                                                     util::AppendBuffer<char>& compressed)
 {
@@ -945,3 +1034,148 @@ size_t compression::get_uncompressed_size_from_header(InputStream& source)
     auto first_block = source.next_block();
     return read_header(source, first_block).size;
 }
+
+
+struct compression::MessageDeflater::Impl {
+    z_stream strm = {};
+};
+
+compression::MessageDeflater::MessageDeflater(int window_bits, int compression_level)
+    : m_impl(std::make_unique<Impl>()) // Throws
+{
+    REALM_ASSERT(window_bits >= 9 && window_bits <= 15);
+    // A negative number of window bits selects raw DEFLATE
+    int rc = deflateInit2(&m_impl->strm, compression_level, Z_DEFLATED, -window_bits, 8, Z_DEFAULT_STRATEGY);
+    if (rc != Z_OK)
+        throw std::system_error(make_error_code(rc == Z_MEM_ERROR ? error::out_of_memory : error::compress_error));
+}
+
+compression::MessageDeflater::~MessageDeflater() noexcept
+{
+    deflateEnd(&m_impl->strm);
+}
+
+std::error_code compression::MessageDeflater::compress(Span<const char> message, AppendBuffer<char>& compressed)
+{
+    // zlib emits nothing for a sync flush without new input, so produce the
+    // empty stored block by hand. The stream is always byte aligned between
+    // messages, so this is a single zero byte once the trailer is stripped.
+    if (message.empty()) {
+        compressed.append("\x00", 1); // Throws
+        return std::error_code{};
+    }
+
+    z_stream& strm = m_impl->strm;
+    const size_t original_size = compressed.size();
+    size_t compressed_size = original_size;
+    // Enough for the whole message in the common case
+    size_t chunk_size = std::min<size_t>(compress_bound(message.size()), 1024 * 1024);
+    strm.next_in = to_bytef(message.data());
+    size_t remaining = message.size();
+    for (;;) {
+        strm.avail_in = bounded_avail(remaining);
+        remaining -= strm.avail_in;
+        int flush = (remaining == 0 ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        // Repeat until deflate() leaves some of the output buffer unused, as
+        // that means that it has consumed all the input and completed the
+        // flush.
+        do {
+            compressed.resize(compressed_size + chunk_size); // Throws
+            strm.next_out = to_bytef(compressed.data() + compressed_size);
+            strm.avail_out = bounded_avail(chunk_size);
+            int rc = deflate(&strm, flush);
+            compressed_size += chunk_size - strm.avail_out;
+            if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                compressed.resize(original_size);
+                return error::compress_error;
+            }
+        } while (strm.avail_out == 0);
+        if (remaining == 0)
+            break;
+    }
+
+    // Strip the empty stored block emitted by the sync flush, as the receiver
+    // adds it back before decompressing
+    REALM_ASSERT(compressed_size >= original_size + 4);
+    REALM_ASSERT(std::memcmp(compressed.data() + compressed_size - 4, "\x00\x00\xFF\xFF", 4) == 0);
+    compressed.resize(compressed_size - 4);
+    return std::error_code{};
+}
+
+void compression::MessageDeflater::reset() noexcept
+{
+    deflateReset(&m_impl->strm);
+}
+
+
+struct compression::MessageInflater::Impl {
+    z_stream strm = {};
+};
+
+compression::MessageInflater::MessageInflater()
+    : m_impl(std::make_unique<Impl>()) // Throws
+{
+    int rc = inflateInit2(&m_impl->strm, -15);
+    if (rc != Z_OK)
+        throw std::system_error(make_error_code(rc == Z_MEM_ERROR ? error::out_of_memory : error::decompress_error));
+}
+
+compression::MessageInflater::~MessageInflater() noexcept
+{
+    inflateEnd(&m_impl->strm);
+}
+
+std::error_code compression::MessageInflater::decompress(Span<const char> compressed, AppendBuffer<char>& message,
+                                                         size_t max_size)
+{
+    z_stream& strm = m_impl->strm;
+    const size_t original_size = message.size();
+    size_t message_size = original_size;
+    size_t chunk_size = std::clamp<size_t>(compressed.size() * 4, 1024, 1024 * 1024);
+
+    // The message is followed by the empty stored block which the sender
+    // stripped off
+    static const char tail[] = {'\x00', '\x00', '\xFF', '\xFF'};
+    for (Span<const char> input : {compressed, Span<const char>(tail, sizeof tail)}) {
+        strm.next_in = to_bytef(input.data());
+        size_t remaining = input.size();
+        for (;;) {
+            if (strm.avail_in == 0) {
+                strm.avail_in = bounded_avail(remaining);
+                remaining -= strm.avail_in;
+            }
+            if (message.size() == message_size) {
+                // Never make room for more than one byte beyond the limit, so
+                // that a small input cannot make us allocate without bound
+                size_t room = max_size - (message_size - original_size);
+                message.resize(message_size + (room < chunk_size ? room + 1 : chunk_size)); // Throws
+            }
+            size_t avail = message.size() - message_size;
+            strm.next_out = to_bytef(message.data() + message_size);
+            strm.avail_out = bounded_avail(avail);
+            int rc = inflate(&strm, Z_SYNC_FLUSH);
+            message_size += avail - strm.avail_out;
+            message.resize(message_size);
+            if (message_size - original_size > max_size) {
+                inflateReset(&strm);
+                message.resize(original_size);
+                return error::decompressed_size_too_large;
+            }
+            if (rc == Z_STREAM_END) {
+                // The sender ended the DEFLATE stream with a final block, so
+                // whatever follows starts a new one
+                inflateReset(&strm);
+            }
+            else if (rc == Z_MEM_ERROR) {
+                return error::out_of_memory;
+            }
+            else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                inflateReset(&strm);
+                return error::corrupt_input;
+            }
+            if (strm.avail_in == 0 && remaining == 0 && strm.avail_out != 0)
+                break;
+        }
+    }
+    return std::error_code{};
+}
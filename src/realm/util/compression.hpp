@@ -25,6 +25,7 @@
 #include <realm/util/span.hpp>
 
 #include <array>
+#include <limits>
 #include <memory>
 #include <system_error>
 #include <stdint.h>
@@ -49,6 +50,8 @@ enum class error {
     incorrect_decompressed_size = 6,
     decompress_error = 7,
     decompress_unsupported = 8,
+    decompressed_size_too_large = 9,
+    compress_unsupported = 10,
 };
 
 const std::error_category& error_category() noexcept;
@@ -158,6 +161,28 @@ std::error_code decompress(InputStream& compressed, Span<char> decompressed_buf)
 std::error_code allocate_and_compress(CompressMemoryArena& compress_memory_arena, Span<const char> uncompressed_buf,
                                       std::vector<char>& compressed_buf);
 
+/// zstd_is_available() returns true if this build of Realm includes zstd
+/// support. If it does not, allocate_and_compress_zstd() fails with
+/// error::compress_unsupported and decompress_zstd() fails with
+/// error::decompress_unsupported.
+bool zstd_is_available() noexcept;
+
+/// allocate_and_compress_zstd() compresses the data in \a uncompressed_buf
+/// into a single zstd frame, storing the result in \a compressed_buf. \a
+/// compressed_buf is resized to the compressed size. \a compression_level is
+/// zstd's compression level, where 1 is the fastest. All errors other than
+/// std::bad_alloc are returned as an error code of category
+/// compression::error_category.
+std::error_code allocate_and_compress_zstd(Span<const char> uncompressed_buf, std::vector<char>& compressed_buf,
+                                           int compression_level = 1);
+
+/// decompress_zstd() decompresses the zstd frame in \a compressed_buf into \a
+/// decompressed_buf, which must have exactly the size of the decompressed
+/// data. error::incorrect_decompressed_size is returned if the sizes differ.
+/// All errors other than std::bad_alloc are returned as an error code of
+/// category compression::error_category.
+std::error_code decompress_zstd(Span<const char> compressed_buf, Span<char> decompressed_buf);
+
 /// decompress() decompresses data produced by
 /// allocate_and_compress_nonportable() in \a compressed into \a decompressed.
 /// \a decompressed is resized to the required size, and on non-error return
@@ -165,6 +190,13 @@ std::error_code allocate_and_compress(CompressMemoryArena& compress_memory_arena
 /// are returned as an error code of categrory compression::error_code.
 std::error_code decompress_nonportable(InputStream& compressed, AppendBuffer<char>& decompressed);
 
+/// Same as above, but decompresses directly into \a decompressed, which must
+/// have exactly the size recorded in the header of the compressed data (see
+/// get_uncompressed_size_from_header()). This allows the caller to decompress
+/// into a buffer it already owns without an intermediate copy.
+/// error::incorrect_decompressed_size is returned if the sizes differ.
+std::error_code decompress_nonportable(InputStream& compressed, Span<char> decompressed);
+
 /// decompress_nonportable_input_stream() returns an input stream which wraps
 /// the \a source input stream and decompresses data produced by
 /// allocate_and_compress_nonportable(). The returned input stream will be
@@ -208,6 +240,62 @@ util::AppendBuffer<char> allocate_and_compress_nonportable(Span<const char> unco
 /// allocate_and_compress_nonportable() which is stored in \a source.
 size_t get_uncompressed_size_from_header(InputStream& source);
 
+/// MessageDeflater compresses a sequence of messages with raw DEFLATE (RFC
+/// 1951, without the zlib header and trailer), as used by the WebSocket
+/// permessage-deflate extension (RFC 7692). Each message is terminated by a
+/// sync flush, and the empty stored block which that produces (0x00 0x00 0xFF
+/// 0xFF) is removed from the output.
+///
+/// Unless reset() is called in between, a message may refer back to the
+/// content of the messages compressed before it ("context takeover"), which
+/// improves the compression of small messages with recurring content, but
+/// requires that the messages are decompressed in order by the same
+/// MessageInflater.
+class MessageDeflater {
+public:
+    /// \a window_bits is the base two logarithm of the size of the sliding
+    /// window, and must be in the range [9, 15]. Throws std::system_error if
+    /// the compressor cannot be initialized.
+    explicit MessageDeflater(int window_bits = 15, int compression_level = 1);
+    ~MessageDeflater() noexcept;
+
+    /// compress() appends the compressed form of \a message to \a compressed.
+    /// Errors other than std::bad_alloc are returned as an error code of
+    /// category compression::error_category.
+    std::error_code compress(Span<const char> message, AppendBuffer<char>& compressed);
+
+    /// reset() discards the content of the previously compressed messages, so
+    /// that the next message can be decompressed on its own.
+    void reset() noexcept;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// MessageInflater decompresses messages produced by MessageDeflater, or by
+/// any other permessage-deflate compressor, in the order they were
+/// compressed.
+class MessageInflater {
+public:
+    /// Throws std::system_error if the decompressor cannot be initialized.
+    MessageInflater();
+    ~MessageInflater() noexcept;
+
+    /// decompress() appends the decompressed form of \a compressed to \a
+    /// message. Errors other than std::bad_alloc are returned as an error code
+    /// of category compression::error_category. If the decompressed message
+    /// would be larger than \a max_size, decompression stops with
+    /// error::decompressed_size_too_large, and nothing is appended. The
+    /// messages that follow can then no longer be decompressed.
+    std::error_code decompress(Span<const char> compressed, AppendBuffer<char>& message,
+                               size_t max_size = std::numeric_limits<size_t>::max());
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
 } // namespace realm::util::compression
 
 #endif // REALM_UTIL_COMPRESSION_HPP
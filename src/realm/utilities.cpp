@@ -38,29 +38,31 @@
 #ifdef REALM_COMPILER_SSE
 #ifdef _MSC_VER
 #include <intrin.h>
+#else
+#include <cpuid.h>
 #endif
 #endif
 
 namespace {
 
 #ifdef REALM_COMPILER_SSE
-#if !defined __clang__ && ((defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219) || defined __GNUC__)
-#if defined REALM_COMPILER_AVX && defined __GNUC__
-#define _XCR_XFEATURE_ENABLED_MASK 0
+#if (defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219) || defined __GNUC__
+#define REALM_HAVE_XGETBV
 
-inline unsigned long long _xgetbv(unsigned index)
+// Read an extended control register. Inline assembly rather than the _xgetbv()
+// intrinsic, as GCC and Clang only allow the intrinsic in functions compiled
+// for XSAVE.
+inline unsigned long long read_xcr(unsigned index)
 {
-#if REALM_HAVE_AT_LEAST_GCC(4, 4)
+#ifdef _MSC_VER
+    return _xgetbv(index);
+#else
     unsigned int eax, edx;
     __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
     return (static_cast<unsigned long long>(edx) << 32) | eax;
-#else
-    static_cast<void>(index);
-    return 0;
 #endif
 }
 
-#endif
 #endif
 #endif
 
@@ -104,27 +106,40 @@ void cpuid_init()
 
     bool avxSupported = false;
 
-// seems like in jenkins builds, __GNUC__ is defined for clang?! todo fixme
-#if !defined __clang__ && ((defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219) || defined __GNUC__)
+#ifdef REALM_HAVE_XGETBV
     bool osUsesXSAVE_XRSTORE = cret & (1 << 27) || false;
     bool cpuAVXSuport = cret & (1 << 28) || false;
 
     if (osUsesXSAVE_XRSTORE && cpuAVXSuport) {
-        // Check if the OS will save the YMM registers
-        unsigned long long xcrFeatureMask = _xgetbv(_XCR_XFEATURE_ENABLED_MASK);
-        avxSupported = (xcrFeatureMask & 0x6) || false;
+        // Check that the OS saves both the XMM (bit 1) and the YMM (bit 2)
+        // register state
+        unsigned long long xcrFeatureMask = read_xcr(0);
+        avxSupported = (xcrFeatureMask & 0x6) == 0x6;
     }
 #endif
 
     if (avxSupported) {
         avx_support = 0; // AVX1 supported
+
+        // AVX2 is reported in bit 5 of EBX for CPUID leaf 7, sub-leaf 0. The OS support
+        // for saving the YMM registers was checked above.
+        int ebx7;
+#ifdef _MSC_VER
+        __cpuidex(CPUInfo, 7, 0);
+        ebx7 = CPUInfo[1];
+#else
+        unsigned int eax7, ebx, ecx7, edx7;
+        __cpuid_count(7, 0, eax7, ebx, ecx7, edx7);
+        ebx7 = int(ebx);
+#endif
+        if (ebx7 & (1 << 5)) {
+            avx_support = 1; // AVX2 supported
+        }
     }
     else {
         avx_support = -1; // No AVX supported
     }
 
-    // 1 is reserved for AVX2
-
 #endif
 }
 } // namespace realm
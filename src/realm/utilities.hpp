@@ -73,6 +73,14 @@ typedef SSIZE_T ssize_t;
 #define REALM_COMPILER_AVX
 #endif
 
+// Lets a single function use AVX2 intrinsics without allowing the compiler to emit
+// AVX2 instructions elsewhere. Such functions may only be called if sseavx<2>() is true.
+#if defined(REALM_COMPILER_AVX) && defined(__GNUC__)
+#define REALM_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define REALM_TARGET_AVX2
+#endif
+
 namespace realm {
 
 using StringCompareCallback = util::UniqueFunction<bool(const char* string1, const char* string2)>;
@@ -93,7 +101,7 @@ REALM_FORCEINLINE bool sseavx()
 
     avx_support = -1: No AVX support
     avx_support = 0: AVX1 supported
-    sse_support = 1: AVX2 supported (not yet implemented for detection in our cpuid_init(), todo)
+    avx_support = 1: AVX2 supported
 
     This lets us test very rapidly at runtime because we just need 1 compare instruction (with 0) to test both for
     SSE 3 and 4.2 by caller (compiler optimizes if calls are concecutive), and can decide branch with ja/jl/je because
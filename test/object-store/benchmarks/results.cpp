@@ -29,6 +29,7 @@
 #include <realm/object-store/results.hpp>
 #include <realm/object-store/schema.hpp>
 #include <realm/object-store/sectioned_results.hpp>
+#include <realm/object-store/impl/collection_change_builder.hpp>
 #include <realm/object-store/impl/realm_coordinator.hpp>
 
 using namespace realm;
@@ -335,6 +336,57 @@ TEST_CASE("Benchmark results notifier", "[benchmark][results]") {
     }
 }
 
+TEST_CASE("Benchmark collection change calculation", "[benchmark][results]") {
+    static const size_t object_count = 1'000'000;
+    ObjKeys prev;
+    prev.reserve(object_count);
+    for (size_t i = 0; i < object_count; ++i)
+        prev.push_back(ObjKey(int64_t(i)));
+    auto none_modified = [](ObjKey) {
+        return false;
+    };
+    auto calculate = [&](const ObjKeys& next) {
+        return _impl::CollectionChangeBuilder::calculate(prev, next, none_modified, false);
+    };
+
+    ObjKeys unchanged = prev;
+    BENCHMARK("unchanged") {
+        return calculate(unchanged);
+    };
+
+    ObjKeys appended = prev;
+    appended.push_back(ObjKey(int64_t(object_count)));
+    BENCHMARK("appended") {
+        return calculate(appended);
+    };
+
+    // A few objects changed their sort position
+    ObjKeys moved = prev;
+    for (size_t i = 0; i < 1000; ++i)
+        std::swap(moved[(i * 7919) % object_count], moved[(i * 104729) % object_count]);
+    BENCHMARK("1000 swaps") {
+        return calculate(moved);
+    };
+
+    // The sort order of half of the objects was inverted
+    ObjKeys reversed = prev;
+    std::reverse(reversed.begin() + object_count / 2, reversed.end());
+    BENCHMARK("half reversed") {
+        return calculate(reversed);
+    };
+
+    // Every object was moved
+    ObjKeys interleaved;
+    interleaved.reserve(object_count);
+    for (size_t i = 0; i < object_count / 2; ++i) {
+        interleaved.push_back(prev[object_count / 2 + i]);
+        interleaved.push_back(prev[i]);
+    }
+    BENCHMARK("interleaved") {
+        return calculate(interleaved);
+    };
+}
+
 TEST_CASE("aggregates", "[benchmark][aggregate]") {
     InMemoryTestFile config;
     config.schema = Schema{
@@ -649,6 +649,21 @@ TEST_CASE("collection_change: calculate() sorted", "[collection change]") {
         REQUIRE_INDICES(c.insertions, 0, 3, 7, 10);
     }
 
+    SECTION("reports modifications and moves around an unchanged prefix and suffix of objects") {
+        auto modified = [](ObjKey key) {
+            return key.value == 1 || key.value == 4 || key.value == 7;
+        };
+        c = _impl::CollectionChangeBuilder::calculate({1, 2, 3, 4, 5, 6, 7}, {1, 2, 5, 3, 4, 6, 7}, modified, false);
+        REQUIRE_INDICES(c.deletions, 4);
+        REQUIRE_INDICES(c.insertions, 2);
+        REQUIRE_INDICES(c.modifications, 0, 4, 6);
+
+        c = _impl::CollectionChangeBuilder::calculate({1, 2, 3}, {1, 2, 3, 4}, modified, false);
+        REQUIRE(c.deletions.empty());
+        REQUIRE_INDICES(c.insertions, 3);
+        REQUIRE_INDICES(c.modifications, 0);
+    }
+
     SECTION("produces diffs which let merge collapse insert -> move -> delete to no-op") {
         auto four_modified = [](auto ndx) {
             return ndx == 4;
@@ -3347,6 +3347,349 @@ TEST_CASE("results: notifier with no callbacks", "[notifications][results]") {
     }
 }
 
+TEST_CASE("results: notifier updates results from the changed objects", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+         }},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+
+    // Enough objects that changing a few of them doesn't rerun the query
+    r->begin_transaction();
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 200; ++i)
+        keys.push_back(table->create_object().set(col_value, i % 10).get_key());
+    r->commit_transaction();
+
+    Results results(r, table->where().less(col_value, 5));
+    CollectionChangeSet change;
+    auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+        change = c;
+    });
+    advance_and_notify(*r);
+    REQUIRE(results.size() == 100);
+
+    auto write = [&](auto&& f) {
+        r->begin_transaction();
+        f();
+        r->commit_transaction();
+        advance_and_notify(*r);
+        // The results must be the same as when running the query from scratch
+        auto expected = table->where().less(col_value, 5).find_all();
+        REQUIRE(results.size() == expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            REQUIRE(results.get(i).get_key() == expected.get_key(i));
+    };
+
+    SECTION("modifying objects to match and to not match") {
+        write([&] {
+            table->get_object(keys[7]).set(col_value, 0);
+            table->get_object(keys[3]).set(col_value, 9);
+        });
+        REQUIRE_INDICES(change.insertions, 4);
+        REQUIRE_INDICES(change.deletions, 3);
+        REQUIRE(results.size() == 100);
+    }
+
+    SECTION("modifying matching objects") {
+        write([&] {
+            table->get_object(keys[2]).set(col_value, 4);
+        });
+        REQUIRE_INDICES(change.modifications, 2);
+        REQUIRE(change.insertions.empty());
+        REQUIRE(change.deletions.empty());
+    }
+
+    SECTION("creating and deleting objects") {
+        ObjKey created;
+        write([&] {
+            created = table->create_object().set(col_value, 1).get_key();
+            table->create_object().set(col_value, 6);
+            table->remove_object(keys[0]);
+            table->remove_object(keys[5]);
+        });
+        REQUIRE_INDICES(change.insertions, 99);
+        REQUIRE_INDICES(change.deletions, 0);
+        REQUIRE(results.get(99).get_key() == created);
+    }
+
+    SECTION("changes made while there was no callback") {
+        token = {};
+        write([&] {
+            table->get_object(keys[1]).set(col_value, 8);
+        });
+        token = results.add_notification_callback([&](CollectionChangeSet c) {
+            change = c;
+        });
+        write([&] {
+            table->get_object(keys[9]).set(col_value, 3);
+        });
+        REQUIRE(results.size() == 100);
+    }
+
+    SECTION("changes to most of the table") {
+        write([&] {
+            for (auto key : keys)
+                table->get_object(key).set(col_value, table->get_object(key).get<Int>(col_value) + 1);
+        });
+        REQUIRE(results.size() == 80);
+    }
+}
+
+TEST_CASE("notifications: notifiers run on several threads", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    // A single thread runs the notifiers without the worker pool
+    config.notifier_threads = GENERATE(1, 2, 4);
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+             {"link", PropertyType::Object | PropertyType::Nullable, "target"},
+         }},
+        {"parent",
+         {
+             {"list", PropertyType::Array | PropertyType::Object, "object"},
+         }},
+        {"target",
+         {
+             {"value", PropertyType::Int},
+         }},
+    });
+
+    auto coordinator = _impl::RealmCoordinator::get_coordinator(config.path);
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+    auto col_link = table->get_column_key("link");
+    auto target_table = r->read_group().get_table("class_target");
+    auto col_target_value = target_table->get_column_key("value");
+    auto parent_table = r->read_group().get_table("class_parent");
+    auto col_list = parent_table->get_column_key("list");
+
+    r->begin_transaction();
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(table->create_object().set(col_value, i).get_key());
+    Obj parent = parent_table->create_object();
+    auto list_keys = parent.get_linklist(col_list);
+    for (int i = 0; i < 10; ++i)
+        list_keys.add(keys[i]);
+    r->commit_transaction();
+
+    // Results with different queries and orderings, each with its own notifier
+    struct Observed {
+        Results results;
+        size_t size = 0;
+        int calls = 0;
+        CollectionChangeSet changes;
+        NotificationToken token;
+    };
+    std::vector<std::unique_ptr<Observed>> observed;
+    for (int i = 0; i < 16; ++i) {
+        Results results(r, table->where().less(col_value, (i + 1) * 10));
+        if (i % 2)
+            results = results.sort({{"value", false}});
+        observed.push_back(std::make_unique<Observed>(Observed{std::move(results)}));
+        auto& o = *observed.back();
+        o.token = o.results.add_notification_callback([&o](CollectionChangeSet c) {
+            ++o.calls;
+            o.changes = std::move(c);
+        });
+    }
+
+    List list(r, parent, col_list);
+    CollectionChangeSet list_changes;
+    auto list_token = list.add_notification_callback([&](CollectionChangeSet c) {
+        list_changes = std::move(c);
+    });
+
+    Object object(r, table->get_object(keys[5]));
+    CollectionChangeSet object_changes;
+    auto object_token = object.add_notification_callback([&](CollectionChangeSet c) {
+        object_changes = std::move(c);
+    });
+
+    advance_and_notify(*r);
+    for (auto& o : observed) {
+        REQUIRE(o->calls == 1);
+        o->size = o->results.size();
+    }
+
+    // Each Results must match the query run from scratch, and the change sets
+    // must take it from its previous size to its new size
+    auto check = [&] {
+        for (size_t i = 0; i < observed.size(); ++i) {
+            auto& o = *observed[i];
+            auto expected = table->where().less(col_value, int64_t(i + 1) * 10).count();
+            REQUIRE(o.results.size() == expected);
+            REQUIRE(o.size - o.changes.deletions.count() + o.changes.insertions.count() == expected);
+            o.size = expected;
+        }
+    };
+
+    SECTION("changes to matching objects") {
+        r->begin_transaction();
+        table->get_object(keys[5]).set(col_value, 55);
+        table->get_object(keys[60]).set(col_value, 1);
+        table->remove_object(keys[99]);
+        table->create_object().set(col_value, 0);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+        REQUIRE_INDICES(observed[0]->changes.deletions, 5);
+        REQUIRE(observed[0]->changes.insertions.count() == 2);
+        REQUIRE_INDICES(list_changes.modifications, 5);
+        REQUIRE_INDICES(object_changes.modifications, 0);
+    }
+
+    SECTION("notifiers added after the first run") {
+        Results results(r, table->where().greater(col_value, 90));
+        CollectionChangeSet changes;
+        auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+            changes = std::move(c);
+        });
+        r->begin_transaction();
+        table->get_object(keys[0]).set(col_value, 95);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+        REQUIRE(results.size() == 10);
+        REQUIRE_INDICES(observed[0]->changes.deletions, 0);
+        REQUIRE_INDICES(list_changes.modifications, 0);
+    }
+
+    SECTION("skipped changes are not reported") {
+        r->begin_transaction();
+        table->create_object().set(col_value, 0);
+        observed[0]->token.suppress_next();
+        r->commit_transaction();
+
+        auto r2 = coordinator->get_realm(util::Scheduler::make_frozen(VersionID()));
+        r2->begin_transaction();
+        r2->read_group().get_table("class_object")->create_object().set(col_value, 1);
+        r2->commit_transaction();
+
+        advance_and_notify(*r);
+        REQUIRE(observed[0]->results.size() == 12);
+        REQUIRE(observed[0]->changes.insertions.count() == 1);
+        REQUIRE(observed[1]->results.size() == 22);
+        REQUIRE(observed[1]->changes.insertions.count() == 2);
+    }
+
+    SECTION("modifications of linked objects") {
+        r->begin_transaction();
+        ObjKey target = target_table->create_object().get_key();
+        for (size_t i = 0; i < keys.size(); i += 3)
+            table->get_object(keys[i]).set(col_link, target);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+
+        // All notifiers find the modified object over the same links, sharing
+        // the results of their checks when they run on several threads
+        r->begin_transaction();
+        target_table->get_object(target).set(col_target_value, 1);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+        for (size_t i = 0; i < observed.size(); ++i) {
+            // Every third object of the results links to the target
+            size_t size = std::min<size_t>((i + 1) * 10, keys.size());
+            REQUIRE(observed[i]->changes.modifications.count() == (size + 2) / 3);
+            REQUIRE(observed[i]->changes.insertions.empty());
+            REQUIRE(observed[i]->changes.deletions.empty());
+        }
+        REQUIRE_INDICES(list_changes.modifications, 0, 3, 6, 9);
+    }
+
+    SECTION("deleting the observed object and list") {
+        r->begin_transaction();
+        table->remove_object(keys[5]);
+        parent.remove();
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+        REQUIRE_INDICES(object_changes.deletions, 0);
+        REQUIRE(list_changes.collection_root_was_deleted);
+
+        // The deleted notifiers keep running without their object
+        r->begin_transaction();
+        table->get_object(keys[6]).set(col_value, 66);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        check();
+    }
+}
+
+TEST_CASE("results: notifier reruns queries over links within the table", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object",
+         {
+             {"value", PropertyType::Int},
+             {"link", PropertyType::Object | PropertyType::Nullable, "object"},
+         }},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+    auto col_link = table->get_column_key("link");
+
+    // Every object links to the next one
+    r->begin_transaction();
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 200; ++i)
+        keys.push_back(table->create_object().set(col_value, i % 10).get_key());
+    for (int i = 0; i < 199; ++i)
+        table->get_object(keys[i]).set(col_link, keys[i + 1]);
+    r->commit_transaction();
+
+    auto make_query = [&] {
+        return table->link(col_link).column<Int>(col_value) < 5;
+    };
+    Results results(r, make_query());
+    CollectionChangeSet change;
+    auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+        change = c;
+    });
+    advance_and_notify(*r);
+    // The last object has no link, so it never matches
+    REQUIRE(results.size() == 99);
+
+    // Changing the target of a link changes whether the object linking to it
+    // matches, even though that object itself is unchanged
+    r->begin_transaction();
+    table->get_object(keys[3]).set(col_value, 9);
+    table->get_object(keys[8]).set(col_value, 0);
+    r->commit_transaction();
+    advance_and_notify(*r);
+
+    auto expected = make_query().find_all();
+    REQUIRE(results.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        REQUIRE(results.get(i).get_key() == expected.get_key(i));
+    REQUIRE(results.index_of(table->get_object(keys[2])) == npos);
+    REQUIRE(results.index_of(table->get_object(keys[7])) != npos);
+    REQUIRE_FALSE(change.insertions.empty());
+    REQUIRE_FALSE(change.deletions.empty());
+}
+
 TEST_CASE("results: snapshots", "[results]") {
     InMemoryTestFile config;
     config.automatic_change_notifications = false;
@@ -4908,6 +5251,114 @@ TEST_CASE("results: limit", "[results][limit]") {
     }
 }
 
+TEST_CASE("results: windowed", "[results]") {
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    config.schema = Schema{
+        {"object",
+         {
+             {"value", PropertyType::Int},
+         }},
+    };
+
+    auto realm = Realm::get_shared_realm(config);
+    auto table = realm->read_group().get_table("class_object");
+    auto col = table->get_column_key("value");
+
+    // Enough objects to span several leaves of the table
+    realm->begin_transaction();
+    for (int i = 0; i < 2000; ++i) {
+        table->create_object().set(col, i % 3);
+    }
+    realm->commit_transaction();
+
+    Results full(realm, table->where().equal(col, 0));
+    REQUIRE(full.size() == 667);
+    Results r = full.windowed(10);
+
+    SECTION("objects are found as they are accessed") {
+        REQUIRE(r.get(0).get_key() == full.get(0).get_key());
+        REQUIRE(r.get_mode() == Results::Mode::TableView);
+        REQUIRE(r.size() == 667);
+        for (size_t i = 0; i < 667; ++i) {
+            REQUIRE(r.get(i).get_key() == full.get(i).get_key());
+        }
+        REQUIRE(r.size() == 667);
+        REQUIRE_EXCEPTION(r.get(667), OutOfBounds,
+                          "Requested index 667 calling get() on Results when max is 666");
+    }
+
+    SECTION("accessing a later object finds all objects before it") {
+        REQUIRE(r.get(500).get_key() == full.get(500).get_key());
+        REQUIRE(r.get(20).get_key() == full.get(20).get_key());
+        REQUIRE(r.get(666).get_key() == full.get(666).get_key());
+    }
+
+    SECTION("results without conditions") {
+        Results all(realm, table);
+        auto windowed = all.windowed(10);
+        REQUIRE(windowed.get(0).get_key() == all.get(0).get_key());
+        REQUIRE(windowed.get(1999).get_key() == all.get(1999).get_key());
+        REQUIRE(windowed.size() == 2000);
+    }
+
+    SECTION("operations needing all objects find the rest of them") {
+        REQUIRE(r.get(0).get_key() == full.get(0).get_key());
+        REQUIRE(r.index_of(full.get(500)) == 500);
+        REQUIRE(r.get_tableview().size() == 667);
+        REQUIRE(r.snapshot().size() == 667);
+    }
+
+    SECTION("frozen copy holds all objects") {
+        REQUIRE(r.get(0).get_key() == full.get(0).get_key());
+        auto frozen = r.freeze(realm->freeze());
+        REQUIRE(frozen.size() == 667);
+        REQUIRE(frozen.get(666).get_key() == full.get(666).get_key());
+    }
+
+    SECTION("modifying the table reruns the query") {
+        auto last = full.get(666).get_key();
+        REQUIRE(r.get(0).get_key() == full.get(0).get_key());
+        realm->begin_transaction();
+        auto obj = table->get_object(1);
+        obj.set(col, 0);
+        REQUIRE(r.get(1).get_key() == obj.get_key());
+        REQUIRE(r.size() == 668);
+        REQUIRE(r.get(667).get_key() == last);
+        realm->cancel_transaction();
+    }
+
+    SECTION("sorted results are found all at once") {
+        auto sorted = full.sort({{"value", true}}).windowed(10);
+        REQUIRE(sorted.get(0).get_key() == full.get(0).get_key());
+        REQUIRE(sorted.size() == 667);
+        REQUIRE(sorted.get(666).get_key() == full.get(666).get_key());
+    }
+
+    SECTION("window is replaced by the results of the notifier") {
+        int notification_calls = 0;
+        CollectionChangeSet change;
+        auto token = r.add_notification_callback([&](CollectionChangeSet c) {
+            change = c;
+            ++notification_calls;
+        });
+        REQUIRE(r.get(0).get_key() == full.get(0).get_key());
+        advance_and_notify(*realm);
+        REQUIRE(notification_calls == 1);
+        REQUIRE(r.size() == 667);
+        REQUIRE(r.get(666).get_key() == full.get(666).get_key());
+
+        realm->begin_transaction();
+        auto obj = table->create_object().set(col, 0);
+        realm->commit_transaction();
+        advance_and_notify(*realm);
+        REQUIRE(notification_calls == 2);
+        REQUIRE_INDICES(change.insertions, 667);
+        REQUIRE(r.size() == 668);
+        REQUIRE(r.get(667).get_key() == obj.get_key());
+    }
+}
+
 TEST_CASE("results: filter", "[results]") {
     InMemoryTestFile config;
     config.automatic_change_notifications = false;
@@ -807,7 +807,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.modifications[5], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.deletions.empty());
-        REQUIRE(algo_run_count == 11);
+        REQUIRE(algo_run_count == 1);
 
         algo_run_count = 0;
         // Deletions
@@ -825,7 +825,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.deletions[2], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.modifications.empty());
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 0);
 
         // Test moving objects from one section to a new one.
         // delete all objects starting with 'S'
@@ -850,7 +850,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions[2].empty());
         REQUIRE_INDICES(changes.insertions[3], 0, 1);
         REQUIRE_INDICES(changes.insertions[4], 0);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 3);
 
         // Test moving objects from one section to an existing one.
         // move all objects starting with 'E'
@@ -867,7 +867,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions.size() == 1);
         REQUIRE(changes.modifications.empty());
         REQUIRE_INDICES(changes.insertions[0], 0, 5);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 2);
 
         // Test clearing all from the table
         algo_run_count = 0;
@@ -1232,7 +1232,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         auto o1 = table->create_object().set(name_col, "any");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
@@ -1253,7 +1253,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[1], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Modifications
@@ -1267,7 +1267,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.modifications[0], 0);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         // Modify the column value to now be in a diff section
         r->begin_transaction();
@@ -1279,7 +1279,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE_INDICES(section1_changes.deletions[0], 0);
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Deletions
@@ -1294,7 +1294,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.deletions[1], 1);
         REQUIRE(section2_changes.insertions.empty());
         REQUIRE(section2_changes.modifications.empty());
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
 
         r->begin_transaction();
@@ -1307,7 +1307,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.deletions[0], 1);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
-        REQUIRE(algo_run_count == 5);
+        REQUIRE(algo_run_count == 0);
     }
 
     SECTION("notifications on section where section is deleted") {
@@ -1351,17 +1351,17 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE_INDICES(section1_changes.sections_to_delete, 0);
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
 
         r->begin_transaction();
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
         table->create_object().set(name_col, "book");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 0);
         REQUIRE(section2_notification_calls == 1);
@@ -1370,12 +1370,12 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[0], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2.index() == 0);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         // Insert values back into section1
         REQUIRE_FALSE(section1.is_valid());
         r->begin_transaction();
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
@@ -1383,7 +1383,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         r->commit_transaction();
         advance_and_notify(*r);
 
-        REQUIRE(algo_run_count == 4);
+        REQUIRE(algo_run_count == 1);
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
         REQUIRE(section1_changes.deletions.empty());
@@ -1395,6 +1395,166 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1.is_valid());
     }
 
+    SECTION("notifications only recalculate the section keys of changed objects") {
+        SectionedResultsChangeSet changes;
+        auto token = sectioned_results.add_notification_callback([&](SectionedResultsChangeSet c) {
+            changes = c;
+        });
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 5);
+
+        auto check_sections = [&](std::vector<std::vector<std::string>> expected) {
+            REQUIRE(sectioned_results.size() == expected.size());
+            for (size_t i = 0; i < expected.size(); i++) {
+                auto section = sectioned_results[i];
+                REQUIRE(section.size() == expected[i].size());
+                for (size_t y = 0; y < section.size(); y++) {
+                    auto val = Object(r, section[y].get_link()).get_column_value<StringData>("name_col");
+                    REQUIRE(expected[i][y] == val);
+                }
+            }
+        };
+
+        // Only the inserted and the modified object are passed to the callback
+        algo_run_count = 0;
+        r->begin_transaction();
+        table->create_object().set(name_col, "cherry");
+        o5.set(name_col, "berry");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 2);
+        REQUIRE_INDICES(changes.sections_to_insert, 2);
+        check_sections({{"apple", "apricot"}, {"banana", "berry"}, {"cherry"}, {"orange"}});
+        REQUIRE(algo_run_count == 2);
+
+        // Deleting objects doesn't require running the callback at all
+        algo_run_count = 0;
+        r->begin_transaction();
+        table->remove_object(o5.get_key());
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 0);
+        check_sections({{"apple", "apricot"}, {"banana"}, {"cherry"}, {"orange"}});
+
+        // Sections read inside a write transaction don't match the changes
+        // reported for it, so the next notification recalculates every key
+        algo_run_count = 0;
+        r->begin_transaction();
+        table->create_object().set(name_col, "kiwi");
+        check_sections({{"apple", "apricot"}, {"banana"}, {"cherry"}, {"kiwi"}, {"orange"}});
+        REQUIRE(algo_run_count == 6);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 6);
+
+        algo_run_count = 0;
+        r->begin_transaction();
+        table->create_object().set(name_col, "avocado");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 7);
+        check_sections({{"apple", "apricot", "avocado"}, {"banana"}, {"cherry"}, {"kiwi"}, {"orange"}});
+
+        algo_run_count = 0;
+        r->begin_transaction();
+        table->create_object().set(name_col, "date");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(algo_run_count == 1);
+        check_sections({{"apple", "apricot", "avocado"}, {"banana"}, {"cherry"}, {"date"}, {"kiwi"}, {"orange"}});
+    }
+
+    SECTION("notifications filtered by key path") {
+        auto int_col = table->get_column_key("int_col");
+        KeyPathArray key_path_array = {{{table->get_key(), int_col}}};
+        int notification_calls = 0;
+        SectionedResultsChangeSet changes;
+        auto token = sectioned_results.add_notification_callback(
+            [&](SectionedResultsChangeSet c) {
+                changes = c;
+                ++notification_calls;
+            },
+            key_path_array);
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 1);
+        REQUIRE(algo_run_count == 5);
+
+        // Changing the column the section key is calculated from isn't reported
+        // to a callback filtered on another column, but the sections still
+        // move the object. It keeps its position in the sorted results.
+        auto banana = table->get_object(table->find_first_string(name_col, "banana"));
+        notification_calls = 0;
+        algo_run_count = 0;
+        r->begin_transaction();
+        banana.set(name_col, "cherry");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 0);
+        REQUIRE(sectioned_results.size() == 3);
+        REQUIRE(sectioned_results[1].key().get_string() == "c");
+        REQUIRE(algo_run_count == 5);
+
+        // The changes reported to a filtered callback don't include every
+        // modification, so they can't tell which section keys are unchanged
+        algo_run_count = 0;
+        r->begin_transaction();
+        banana.set(int_col, 10);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 1);
+        REQUIRE(changes.modifications.size() == 2);
+        REQUIRE_INDICES(changes.modifications[1], 0);
+        REQUIRE(algo_run_count == 5);
+    }
+
+    SECTION("notifications covering several commits") {
+        int notification_calls = 0;
+        auto token = sectioned_results.add_notification_callback([&](SectionedResultsChangeSet) {
+            ++notification_calls;
+        });
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 1);
+        REQUIRE(algo_run_count == 5);
+
+        // The commits made by another Realm since the previous notification
+        // are delivered together, and only the changed objects are sectioned
+        auto r2 = Realm::get_shared_realm(config);
+        auto table2 = r2->read_group().get_table("class_object");
+        algo_run_count = 0;
+        r2->begin_transaction();
+        table2->create_object().set_all("cherry", 4);
+        r2->commit_transaction();
+        r2->begin_transaction();
+        table2->get_object(table2->find_first_string(name_col, "orange")).set(name_col, "blueberry");
+        r2->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 2);
+        REQUIRE(algo_run_count == 2);
+        REQUIRE(sectioned_results.size() == 3);
+        REQUIRE(sectioned_results[1].size() == 2);
+        REQUIRE(sectioned_results[2].key().get_string() == "c");
+
+        // The changes of a commit whose notification was suppressed are not
+        // delivered, so every section key is calculated again
+        r->begin_transaction();
+        table->get_object(table->find_first_string(name_col, "cherry")).set(name_col, "date");
+        token.suppress_next();
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 2);
+
+        algo_run_count = 0;
+        r2->begin_transaction();
+        table2->create_object().set_all("elderberry", 5);
+        r2->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(notification_calls == 3);
+        REQUIRE(algo_run_count == 7);
+        REQUIRE(sectioned_results.size() == 4);
+        REQUIRE(sectioned_results[2].key().get_string() == "d");
+        REQUIRE(sectioned_results[3].key().get_string() == "e");
+    }
+
     SECTION("snapshot") {
         auto sr_snapshot = sectioned_results.snapshot();
 
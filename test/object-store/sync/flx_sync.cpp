@@ -2626,7 +2626,13 @@ TEST_CASE("flx: writes work without waiting for sync", "[sync][flx][baas]") {
 TEST_CASE("flx: verify websocket protocol number and prefixes", "[sync][protocol]") {
     // Update the expected value whenever the protocol version is updated - this ensures
     // that the current protocol version does not change unexpectedly.
+    // Builds with zstd support additionally offer the version which adds zstd
+    // compressed message bodies.
+#if REALM_HAVE_ZSTD
+    REQUIRE(15 == sync::get_current_protocol_version());
+#else
     REQUIRE(14 == sync::get_current_protocol_version());
+#endif
     // This was updated in Protocol V8 to use '#' instead of '/' to support the Web SDK
     REQUIRE("com.mongodb.realm-sync#" == sync::get_pbs_websocket_protocol_prefix());
     REQUIRE("com.mongodb.realm-query-sync#" == sync::get_flx_websocket_protocol_prefix());
@@ -33,8 +33,10 @@
 
 #include <realm.hpp>
 
+#include <atomic>
 #include <iostream>
 #include <random>
+#include <thread>
 
 using namespace realm;
 
@@ -1923,6 +1925,86 @@ TEST_CASE("DeepChangeChecker singular links", "[notifications]") {
         REQUIRE_FALSE(_impl::DeepChangeChecker(info, *table, related_tables, key_path_mixed_link, true)(9));
     }
 
+    SECTION("results are shared by checkers using the same change info") {
+        r->begin_transaction();
+        objects[0].set(cols[1], objects[1].get_key());
+        objects[1].set(cols[1], objects[2].get_key());
+        objects[2].set(cols[1], objects[4].get_key());
+        r->commit_transaction();
+        relation_updater();
+
+        auto info = track_changes([&] {
+            objects[4].set(cols[0], 10);
+        });
+        auto& cache = *info.deep_change_cache;
+
+        REQUIRE(_impl::DeepChangeChecker(info, *table, related_tables, key_path_array_empty, false)(0));
+        REQUIRE_FALSE(_impl::DeepChangeChecker(info, *table, related_tables, key_path_array_empty, false)(3));
+        REQUIRE(cache.find_modified(table->get_key(), objects[0].get_key(), 3) == true);
+        REQUIRE(cache.find_modified(table->get_key(), objects[1].get_key(), 2) == true);
+        REQUIRE(cache.find_modified(table->get_key(), objects[2].get_key(), 1) == true);
+        REQUIRE(cache.find_modified(table->get_key(), objects[3].get_key(), 3) == false);
+        // #1 is two links away from the modified object
+        REQUIRE_FALSE(cache.find_modified(table->get_key(), objects[1].get_key(), 1));
+
+        // Checkers filtering on columns neither use nor add shared results
+        REQUIRE_FALSE(_impl::DeepChangeChecker(info, *table, related_tables, key_path_array_int, true)(6));
+        REQUIRE_FALSE(cache.find_modified(table->get_key(), objects[6].get_key(), 3));
+        REQUIRE(_impl::DeepChangeChecker(info, *table, related_tables, key_path_array_empty, false)(1));
+    }
+
+    SECTION("results are shared by checkers running concurrently") {
+        r->begin_transaction();
+        for (size_t i = 0; i + 1 < objects.size(); ++i)
+            objects[i].set(cols[1], objects[i + 1].get_key());
+        r->commit_transaction();
+        relation_updater();
+
+        // Only the objects at most three links away from #9 find it
+        auto check_all = [&](_impl::TransactionChangeInfo& info, Table const& table) {
+            bool all_as_expected = true;
+            for (size_t i = 0; i < objects.size(); ++i) {
+                bool modified =
+                    _impl::DeepChangeChecker(info, table, related_tables, key_path_array_empty, false)(i);
+                all_as_expected &= (modified == (i >= 6));
+            }
+            return all_as_expected;
+        };
+
+        // Each thread reads from its own frozen Realm, as notifiers on the
+        // worker pool do
+        auto info = track_changes([&] {
+            objects[9].set(cols[0], 10);
+        });
+        info.deep_change_cache->enable_concurrent_access();
+        std::vector<std::shared_ptr<Realm>> frozen_realms;
+        for (int i = 0; i < 4; ++i)
+            frozen_realms.push_back(r->freeze());
+        std::atomic<int> num_as_expected{0};
+        std::vector<std::thread> threads;
+        for (auto& frozen : frozen_realms) {
+            threads.emplace_back([&, frozen] {
+                for (int j = 0; j < 10; ++j) {
+                    if (check_all(info, *frozen->read_group().get_table("class_table")))
+                        ++num_as_expected;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        REQUIRE(num_as_expected == 40);
+        REQUIRE(info.deep_change_cache->find_modified(table->get_key(), objects[6].get_key(), 3) == true);
+
+        // Without concurrent access, the checkers run on one thread
+        auto serial_info = track_changes([&] {
+            objects[9].set(cols[0], 11);
+        });
+        REQUIRE_FALSE(serial_info.deep_change_cache->concurrent_access_enabled());
+        REQUIRE(check_all(serial_info, *table));
+        REQUIRE(check_all(serial_info, *table));
+        REQUIRE(serial_info.deep_change_cache->find_modified(table->get_key(), objects[6].get_key(), 3) == true);
+    }
+
     SECTION("changes over links are tracked") {
         bool did_run_section = false;
 
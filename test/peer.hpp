@@ -224,6 +224,8 @@ public:
         m_current_time += amount;
     }
 
+    size_t get_num_skipped_merges() const noexcept;
+
     std::map<TableKey, std::unordered_map<GlobalKey, ObjKey>> m_optimistic_object_id_collisions;
 
     ShortCircuitHistory(file_ident_type local_file_ident, TestDirNameGenerator* changeset_dump_dir_gen);
@@ -419,8 +421,8 @@ private:
         m_protocol.make_download_message(sync::get_current_protocol_version(), m_download_message_buffer,
                                          file_ident_type(0), version_type(0), version_type(0), version_type(0), 0,
                                          version_type(0), version_type(0), 0, m_history_entry_count,
-                                         m_history_entries_buffer.data(), m_history_entries_buffer.size(), 0, false,
-                                         logger); // Throws
+                                         m_history_entries_buffer.data(), m_history_entries_buffer.size(), 0,
+                                         _impl::BodyCompression::none, logger); // Throws
 
         m_history_entries_buffer.reset();
         m_history_entry_count = 0;
@@ -438,6 +440,11 @@ private:
     OutputBuffer m_download_message_buffer;
 };
 
+inline size_t ShortCircuitHistory::get_num_skipped_merges() const noexcept
+{
+    return m_transformer->get_num_skipped_merges();
+}
+
 inline ShortCircuitHistory::ShortCircuitHistory(file_ident_type local_file_ident,
                                                 TestDirNameGenerator* changeset_dump_dir_gen)
     : m_write_history(std::make_unique<History>(*this)) // Throws
@@ -425,8 +425,21 @@ public:
 
         long server_max_open_files = 64;
 
+        int server_num_worker_threads = 1;
+
+        int server_num_file_open_threads = 0;
+
+        long server_num_prefetched_files = 0;
+
+        long server_history_compaction_interval = 0;
+
+        long server_history_ttl = 0;
+
         bool enable_server_ssl = false;
 
+        // Passed to the WebSockets of both the servers and the clients.
+        websocket::Options websocket_options;
+
         std::string server_ssl_certificate_path = get_test_resource_path() + "test_sync_ca.pem";
         std::string server_ssl_certificate_key_path = get_test_resource_path() + "test_sync_key.pem";
 
@@ -516,6 +529,11 @@ public:
                 public_key = PKey::load_public(config.server_public_key_path);
             Server::Config config_2;
             config_2.max_open_files = config.server_max_open_files;
+            config_2.num_worker_threads = config.server_num_worker_threads;
+            config_2.num_file_open_threads = config.server_num_file_open_threads;
+            config_2.num_prefetched_files = config.server_num_prefetched_files;
+            config_2.history_compaction_interval = config.server_history_compaction_interval;
+            config_2.history_ttl = config.server_history_ttl;
             config_2.logger = m_server_loggers[i];
             config_2.token_expiration_clock = &m_fake_token_expiration_clock;
             config_2.ssl = m_enable_server_ssl;
@@ -525,6 +543,8 @@ public:
             config_2.connection_reaper_interval = config.server_connection_reaper_interval;
             config_2.max_download_size = config.max_download_size;
             config_2.tcp_no_delay = true;
+            config_2.websocket_permessage_deflate = config.websocket_options.permessage_deflate;
+            config_2.websocket_deflate_context_takeover = config.websocket_options.deflate_context_takeover;
             config_2.authorization_header_name = config.authorization_header_name;
             config_2.encryption_key = config.server_encryption_key;
             config_2.max_protocol_version = config.server_max_protocol_version;
@@ -541,7 +561,7 @@ public:
 
             m_client_socket_providers.push_back(std::make_shared<websocket::DefaultSocketProvider>(
                 m_client_loggers[i], "", config.socket_provider_observer,
-                websocket::DefaultSocketProvider::AutoStart{false}));
+                websocket::DefaultSocketProvider::AutoStart{false}, config.websocket_options));
             config_2.socket_provider = m_client_socket_providers.back();
             config_2.logger = m_client_loggers[i];
             config_2.reconnect_mode = ReconnectMode::testing;
@@ -1014,6 +1014,89 @@ TEST(Array_find_sse)
 }
 
 
+// Exercise the AVX2 search (see find_avx2()) for all conditions and element widths it
+// covers, with search ranges that start and end inside an aligned 32-byte chunk
+TEST(Array_find_avx2)
+{
+    Array a(Allocator::get_default());
+    a.create(Array::type_Normal);
+
+    auto check_all = [&](auto cond, int64_t value, size_t start, size_t end) {
+        size_t expected = start;
+        while (expected < end && !cond(a.get(expected), value))
+            ++expected;
+        size_t found = a.find_first<decltype(cond)>(value, start, end);
+        CHECK_EQUAL(expected == end ? not_found : expected, found);
+        return found;
+    };
+
+    for (int64_t magnitude : {100LL, 30000LL, 2000000000LL, 8000000000LL}) {
+        a.clear();
+        for (int64_t i = 0; i < 300; ++i)
+            a.add((i * 7919) % (2 * magnitude) - magnitude);
+
+        for (size_t start : {0, 1, 13, 33}) {
+            for (int64_t value : {-magnitude, int64_t(0), magnitude / 2, magnitude}) {
+                size_t pos = start;
+                while ((pos = check_all(Equal(), value, pos, 290)) != not_found)
+                    ++pos;
+                pos = start;
+                while ((pos = check_all(NotEqual(), value, pos, 290)) != not_found)
+                    ++pos;
+                pos = start;
+                while ((pos = check_all(Greater(), value, pos, 290)) != not_found)
+                    ++pos;
+                pos = start;
+                while ((pos = check_all(Less(), value, pos, 290)) != not_found)
+                    ++pos;
+            }
+        }
+    }
+    a.destroy();
+}
+
+
+TEST(Array_reduce_width)
+{
+    Array a(Allocator::get_default());
+    a.create(Array::type_Normal);
+
+    for (int64_t i = 0; i < 100; ++i)
+        a.add(i % 7);
+    CHECK_EQUAL(a.get_width(), 4);
+    CHECK_NOT(a.reduce_width());
+
+    a.set(50, 0x123456789);
+    CHECK_EQUAL(a.get_width(), 64);
+    CHECK_NOT(a.reduce_width());
+
+    a.set(50, -3);
+    CHECK_EQUAL(a.get_width(), 64);
+    CHECK(a.reduce_width());
+    CHECK_EQUAL(a.get_width(), 8);
+    CHECK_EQUAL(a.size(), 100);
+    for (int64_t i = 0; i < 100; ++i)
+        CHECK_EQUAL(a.get(size_t(i)), i == 50 ? -3 : i % 7);
+
+    a.erase(50);
+    CHECK(a.reduce_width());
+    CHECK_EQUAL(a.get_width(), 4);
+    for (int64_t i = 0; i < 99; ++i)
+        CHECK_EQUAL(a.get(size_t(i)), (i < 50 ? i : i + 1) % 7);
+
+    a.clear();
+    CHECK_NOT(a.reduce_width());
+    a.add(0);
+    a.set(0, 1000);
+    a.set(0, 0);
+    CHECK(a.reduce_width());
+    CHECK_EQUAL(a.get_width(), 0);
+    CHECK_EQUAL(a.get(0), 0);
+
+    a.destroy();
+}
+
+
 TEST(Array_Greater)
 {
     Array a(Allocator::get_default());
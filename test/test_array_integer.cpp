@@ -222,6 +222,62 @@ TEST(ArrayIntNull_Find)
     a.destroy();
 }
 
+TEST(ArrayInteger_FindFirstInRange)
+{
+    constexpr int64_t min = std::numeric_limits<int64_t>::min();
+    constexpr int64_t max = std::numeric_limits<int64_t>::max();
+    // Values requiring each of the possible widths
+    const int64_t limits[] = {0, 1, 3, 15, 127, 32767, 2147483647, max};
+
+    ArrayInteger a(Allocator::get_default());
+    ArrayIntNull n(Allocator::get_default());
+    a.create();
+    n.create();
+
+    auto check = [&](int64_t from, int64_t to, size_t begin, size_t end) {
+        size_t expected = not_found;
+        size_t expected_nullable = not_found;
+        for (size_t i = begin; i < end && expected == not_found; ++i) {
+            if (from <= a.get(i) && a.get(i) <= to)
+                expected = i;
+        }
+        for (size_t i = begin; i < end && expected_nullable == not_found; ++i) {
+            auto val = n.get(i);
+            if (val && from <= *val && *val <= to)
+                expected_nullable = i;
+        }
+        CHECK_EQUAL(a.find_first_in_range(from, to, begin, end), expected);
+        CHECK_EQUAL(n.find_first_in_range(from, to, begin, end), expected_nullable);
+    };
+
+    for (int64_t limit : limits) {
+        for (bool negative : {false, true}) {
+            a.clear();
+            n.clear();
+            for (size_t i = 0; i < 100; ++i) {
+                int64_t val = int64_t(i * 7919) % (limit + 1);
+                if (negative && i % 3 == 0)
+                    val = -val - 1;
+                a.add(val);
+                if (i % 5 == 0)
+                    n.add(null());
+                else
+                    n.add(val);
+            }
+            for (int64_t from : {min, -limit - 1, int64_t(-1), int64_t(0), limit / 2, limit}) {
+                for (int64_t to : {min, int64_t(0), limit / 3, limit, max}) {
+                    check(from, to, 0, 100);
+                    check(from, to, 17, 83);
+                    check(from, to, 40, 40);
+                }
+            }
+        }
+    }
+
+    a.destroy();
+    n.destroy();
+}
+
 TEST(ArrayRef_Basic)
 {
     ArrayRef a(Allocator::get_default());
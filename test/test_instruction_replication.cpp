@@ -49,6 +49,21 @@ struct Fixture {
         wt.commit();
     }
 
+    // Returns the size of the string buffer of the changeset after applying it.
+    size_t replay_transactions_while_parsing()
+    {
+        Changeset log;
+        const auto& buffer = history_1->get_instruction_encoder().buffer();
+        util::SimpleInputStream stream{buffer};
+
+        WriteTransaction wt{sg_2};
+        InstructionApplier applier{wt};
+        applier.parse_and_apply(stream, log);
+        wt.commit();
+        CHECK(log.empty());
+        return log.string_buffer().size();
+    }
+
     void check_equal()
     {
         ReadTransaction rt_1{sg_1};
@@ -679,3 +694,37 @@ TEST(InstructionReplication_Dictionary)
         CHECK_EQUAL(dict.get("d"), true);
     }
 }
+
+TEST(InstructionReplication_ApplyWhileParsing)
+{
+    Fixture fixture{test_context};
+    std::string payload(4000, 'x');
+    {
+        WriteTransaction wt{fixture.sg_1};
+        TableRef foo = wt.get_group().add_table_with_primary_key("class_foo", type_String, "id");
+        ColKey col_str = foo->add_column(type_String, "str");
+        ColKey col_bin = foo->add_column(type_Binary, "bin", true);
+        ColKey col_list = foo->add_column_list(type_String, "list");
+        for (int i = 0; i < 100; ++i) {
+            Obj obj = foo->create_object_with_primary_key(util::format("obj_%1", i));
+            obj.set(col_str, StringData(payload));
+            obj.set(col_bin, BinaryData(payload.data(), i));
+            obj.get_list<String>(col_list).add(util::format("elem_%1", i));
+        }
+        wt.commit();
+    }
+    size_t string_buffer_size = fixture.replay_transactions_while_parsing();
+    fixture.check_equal();
+
+    // The payloads are not retained once their instruction has been applied
+    CHECK_LESS(string_buffer_size, payload.size());
+    {
+        ReadTransaction rt{fixture.sg_2};
+        auto foo = rt.get_table("class_foo");
+        CHECK_EQUAL(foo->size(), 100);
+        Obj obj = foo->get_object_with_primary_key("obj_42");
+        CHECK_EQUAL(obj.get<String>("str"), payload);
+        CHECK_EQUAL(obj.get<Binary>("bin").size(), 42);
+        CHECK_EQUAL(obj.get_list<String>("list").get(0), "elem_42");
+    }
+}
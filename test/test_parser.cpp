@@ -6075,6 +6075,72 @@ TEST_TYPES(Parser_Arithmetic, Prop<int64_t>, Prop<float>, Prop<double>, Prop<Dec
     verify_query_sub(test_context, person, "age * $0 == $1", args, 1);
 }
 
+TEST(Parser_ArithmeticBatch)
+{
+    // Enough rows for several batches per cluster, with nulls, NaNs and integers which don't convert to
+    // double exactly, so that both the typed loops and the per-row fallback are exercised
+    Group g;
+    TableRef table = g.add_table("table");
+    ColKey col_int = table->add_column(type_Int, "int");
+    ColKey col_int_null = table->add_column(type_Int, "int_null", true);
+    ColKey col_float = table->add_column(type_Float, "float", true);
+    ColKey col_double = table->add_column(type_Double, "double");
+
+    constexpr int64_t big = (int64_t(1) << 60) + 1;
+    for (int64_t i = 0; i < 1000; ++i) {
+        Obj obj = table->create_object();
+        obj.set(col_int, i % 50 == 0 ? big : i - 300);
+        if (i % 3)
+            obj.set(col_int_null, i % 17);
+        if (i % 5)
+            obj.set(col_float, float(i) / 4);
+        obj.set(col_double, i % 7 == 0 ? std::numeric_limits<double>::quiet_NaN() : double(i) * 1.5);
+    }
+
+    auto count = [&](auto pred) {
+        size_t n = 0;
+        for (auto& obj : *table) {
+            if (pred(obj.template get<Int>(col_int), obj.template get<util::Optional<Int>>(col_int_null),
+                     obj.template get<util::Optional<float>>(col_float), obj.template get<double>(col_double)))
+                ++n;
+        }
+        return n;
+    };
+
+    verify_query(test_context, table, "int * 2 > 100", count([](Int i, auto, auto, auto) {
+                     return i * 2 > 100;
+                 }));
+    verify_query(test_context, table, "int + int_null == 10", count([](Int i, auto in, auto, auto) {
+                     return in && i + *in == 10;
+                 }));
+    verify_query(test_context, table, "int_null * 2 != 4", count([](Int, auto in, auto, auto) {
+                     return !in || *in * 2 != 4;
+                 }));
+    verify_query(test_context, table, "int / int_null > 10", count([](Int i, auto in, auto, auto) {
+                     if (!in)
+                         return false;
+                     if (*in == 0)
+                         return i >= 0;
+                     return i / *in > 10;
+                 }));
+    verify_query(test_context, table, "float * 2 >= 100", count([](Int, auto, auto f, auto) {
+                     return f && *f * 2 >= 100;
+                 }));
+    verify_query(test_context, table, "float + int <= 0", count([](Int i, auto, auto f, auto) {
+                     return f && *f + float(i) <= 0;
+                 }));
+    // NaN sorts before all other numbers
+    verify_query(test_context, table, "double - int < 0", count([](Int i, auto, auto, double d) {
+                     double r = d - double(i);
+                     return std::isnan(r) || r < 0;
+                 }));
+    verify_query(test_context, table, "int + 0 > double", count([](Int i, auto, auto, double d) {
+                     return std::isnan(d) || i == big || double(i) > d;
+                 }));
+    // Passed as an argument, as the literal would not survive the round trip through the query description
+    CHECK_EQUAL(table->query("int * 1 == $0", std::vector<Mixed>{big}, {}).count(), 20);
+}
+
 TEST(Parser_Between)
 {
     Group g;
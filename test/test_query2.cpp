@@ -4225,6 +4225,28 @@ TEST(Query_SyncViewIfNeeded)
     }
 }
 
+TEST(Query_HasLinkDependencies)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    TableRef target = g.add_table("target");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_self = table->add_column(*table, "self");
+    auto col_target = table->add_column(*target, "target");
+    auto col_target_int = target->add_column(type_Int, "int");
+
+    CHECK_NOT(table->where().has_link_dependencies());
+    CHECK_NOT(table->where().equal(col_int, 5).has_link_dependencies());
+    CHECK_NOT((table->column<Int>(col_int) > 5).has_link_dependencies());
+
+    // Links within the table of the query count as well
+    CHECK((table->link(col_self).column<Int>(col_int) > 5).has_link_dependencies());
+    CHECK((table->backlink(*table, col_self).column<Int>(col_int) > 5).has_link_dependencies());
+    CHECK((table->link(col_target).column<Int>(col_target_int) > 5).has_link_dependencies());
+    Query q = table->where().equal(col_int, 1) || table->link(col_self).column<Int>(col_int) > 5;
+    CHECK(q.has_link_dependencies());
+}
+
 // Ensure that two queries can be combined via Query::and_query, &&, and || even if one of them has no conditions.
 TEST(Query_CombineWithEmptyQueryDoesntCrash)
 {
@@ -6375,4 +6397,229 @@ TEST(Query_FullTextPrefix)
     CHECK_EQUAL(q.count(), 1);
 }
 
+TEST(Query_Parallel)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(make_in_realm_history(), path);
+    ColKey col_int, col_double, col_str;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_int = table->add_column(type_Int, "int", true);
+        col_double = table->add_column(type_Double, "double");
+        col_str = table->add_column(type_String, "str");
+        for (int64_t i = 0; i < 20000; ++i) {
+            auto obj = table->create_object();
+            if (i % 7)
+                obj.set(col_int, i % 1000);
+            obj.set(col_double, double(i % 113) / 3);
+            obj.set(col_str, (i % 3) ? "foo" : "bar");
+        }
+        wt->commit();
+    }
+
+    auto frozen = db->start_frozen();
+    auto table = frozen->get_table("table");
+    auto q = table->where().greater(col_int, 100).equal(col_str, "foo");
+    auto parallel = Query(q).set_num_threads(4);
+    CHECK_EQUAL(parallel.get_num_threads(), 4);
+    CHECK_EQUAL(q.get_num_workers(), 1);
+
+    // The table must have enough leaves for all the threads to be used
+    std::vector<ObjKey> last_key_in_leaf;
+    table->traverse_clusters([&](const Cluster* cluster) {
+        last_key_in_leaf.push_back(cluster->get_real_key(cluster->node_size() - 1));
+        return IteratorControl::AdvanceToNext;
+    });
+    CHECK_GREATER_EQUAL(last_key_in_leaf.size(), 16);
+    CHECK_EQUAL(parallel.get_num_workers(), 4);
+    CHECK_EQUAL(Query(parallel).set_num_threads(3).get_num_workers(), 3);
+
+    CHECK_EQUAL(parallel.count(), q.count());
+    CHECK_EQUAL(Query(parallel).set_num_threads(3).count(), q.count());
+
+    auto tv = q.find_all();
+    auto parallel_tv = parallel.find_all();
+    CHECK_EQUAL(parallel_tv.size(), tv.size());
+    for (size_t i = 0; i < tv.size() && i < parallel_tv.size(); ++i)
+        CHECK_EQUAL(parallel_tv.get_key(i), tv.get_key(i));
+
+    auto limited_tv = parallel.find_all(100);
+    CHECK_EQUAL(limited_tv.size(), 100);
+    CHECK_EQUAL(limited_tv.get_key(99), tv.get_key(99));
+    DescriptorOrdering ordering;
+    ordering.append_limit(LimitDescriptor(100));
+    CHECK_EQUAL(parallel.count(ordering), 100);
+
+    // Limits ending right at, and right after, the end of the leaves scanned by the first thread
+    ObjKey last_key_of_first_worker = last_key_in_leaf[last_key_in_leaf.size() / 4 - 1];
+    size_t first_worker_matches = 0;
+    while (first_worker_matches < tv.size() && tv.get_key(first_worker_matches) <= last_key_of_first_worker)
+        ++first_worker_matches;
+    CHECK_GREATER(first_worker_matches, 0);
+    for (size_t limit : {first_worker_matches, first_worker_matches + 1}) {
+        auto tv_1 = parallel.find_all(limit);
+        CHECK_EQUAL(tv_1.size(), limit);
+        for (size_t i = 0; i < tv_1.size(); ++i)
+            CHECK_EQUAL(tv_1.get_key(i), tv.get_key(i));
+        DescriptorOrdering limit_ordering;
+        limit_ordering.append_limit(LimitDescriptor(limit));
+        CHECK_EQUAL(parallel.count(limit_ordering), limit);
+    }
+
+    CHECK_EQUAL(*parallel.sum(col_int), *q.sum(col_int));
+    // Partial sums of doubles are added in a different order
+    CHECK_APPROXIMATELY_EQUAL(parallel.sum(col_double)->get_double(), q.sum(col_double)->get_double(), 1e-9);
+    size_t cnt = 0, parallel_cnt = 0;
+    CHECK_APPROXIMATELY_EQUAL(parallel.avg(col_double, &parallel_cnt)->get_double(),
+                              q.avg(col_double, &cnt)->get_double(), 1e-9);
+    CHECK_EQUAL(parallel_cnt, cnt);
+    ObjKey key, parallel_key;
+    CHECK_EQUAL(*parallel.max(col_int, &parallel_key), *q.max(col_int, &key));
+    CHECK_EQUAL(parallel_key, key);
+    CHECK_EQUAL(*parallel.min(col_double, &parallel_key), *q.min(col_double, &key));
+    CHECK_EQUAL(parallel_key, key);
+
+    // Queries on live tables are always evaluated on the calling thread
+    auto rt = db->start_read();
+    auto live = rt->get_table("table")->where().greater(col_int, 100).equal(col_str, "foo").set_num_threads(4);
+    CHECK_EQUAL(live.get_num_workers(), 1);
+    CHECK_EQUAL(live.count(), q.count());
+}
+
+TEST(Query_IndexSelectivity)
+{
+    // The conditions using a search index are costed by their number of matches, so the order in
+    // which they are given must not matter, and neither must a low selectivity index losing to a scan
+    SHARED_GROUP_TEST_PATH(path);
+    std::stringstream logs;
+    DBOptions options;
+    options.logger = std::make_shared<util::StreamLogger>(logs);
+    options.logger->set_level_threshold(util::Logger::Level::debug);
+    auto db = DB::create(make_in_realm_history(), path, options);
+    auto wt = db->start_write();
+    Table& table = *wt->add_table("table");
+    auto col_flag = table.add_column(type_Int, "flag");
+    auto col_id = table.add_column(type_Int, "id");
+    auto col_str = table.add_column(type_String, "str");
+    auto col_val = table.add_column(type_Int, "val");
+    table.add_search_index(col_flag);
+    table.add_search_index(col_id);
+    table.add_search_index(col_str);
+    for (int64_t i = 0; i < 5000; ++i) {
+        table.create_object().set(col_flag, i % 2).set(col_id, i % 500).set(col_str, i % 3 ? "foo" : "bar").set(
+            col_val, i);
+    }
+
+    // The index driving the query is logged, and must be the same for both orders
+    auto driving_index = [&](const Query& q) {
+        logs.str("");
+        q.find_all();
+        std::string log = logs.str();
+        auto begin = log.find("Query uses search index: '");
+        if (begin == std::string::npos)
+            return std::string();
+        begin += 26;
+        return log.substr(begin, log.find('\'', begin) - begin);
+    };
+    auto check = [&](Query q1, Query q2, size_t expected, std::string index) {
+        CHECK_EQUAL(q1.count(), expected);
+        CHECK_EQUAL(q2.count(), expected);
+        auto tv1 = q1.find_all();
+        auto tv2 = q2.find_all();
+        CHECK_EQUAL(tv1.size(), expected);
+        CHECK_EQUAL(tv2.size(), expected);
+        tv1.sort(col_val);
+        tv2.sort(col_val);
+        for (size_t i = 0; i < tv1.size() && i < tv2.size(); ++i)
+            CHECK_EQUAL(tv1.get_key(i), tv2.get_key(i));
+        CHECK_EQUAL(*q1.sum(col_val), *q2.sum(col_val));
+        CHECK_EQUAL(driving_index(q1), index);
+        CHECK_EQUAL(driving_index(q2), index);
+    };
+
+    // i % 500 == 7 implies i is odd
+    check(table.where().equal(col_flag, 1).equal(col_id, 7), table.where().equal(col_id, 7).equal(col_flag, 1), 10,
+          "id == 7");
+    check(table.where().equal(col_flag, 0).equal(col_id, 7), table.where().equal(col_id, 7).equal(col_flag, 0), 0,
+          "id == 7");
+    // i % 500 == 9 and i % 3 == 0 for i = 9, 1509, 3009, 4509
+    check(table.where().equal(col_str, "bar").equal(col_flag, 1).equal(col_id, 9),
+          table.where().equal(col_id, 9).equal(col_flag, 1).equal(col_str, "bar"), 4, "id == 9");
+    // An index matching half of the table loses to scanning the other condition
+    check(table.where().equal(col_flag, 1).less(col_val, 100), table.where().less(col_val, 100).equal(col_flag, 1),
+          50, "");
+    check(table.where().equal(col_str, "foo").equal(col_id, 12).greater(col_val, 2500),
+          table.where().greater(col_val, 2500).equal(col_id, 12).equal(col_str, "foo"), 3, "id == 12");
+}
+
+TEST(Query_IndexIntersection)
+{
+    Table table;
+    auto col_owner = table.add_column(type_Int, "owner");
+    auto col_status = table.add_column(type_String, "status");
+    auto col_day = table.add_column(type_Int, "day", true);
+    auto col_val = table.add_column(type_Int, "val");
+    table.add_search_index(col_owner);
+    table.add_search_index(col_status);
+    table.add_search_index(col_day);
+    const char* statuses[] = {"open", "closed", "pending"};
+    for (int64_t i = 0; i < 3000; ++i) {
+        auto obj = table.create_object().set(col_owner, i % 40).set(col_status, statuses[i % 3]).set(col_val, i);
+        if (i % 11)
+            obj.set(col_day, i % 7);
+    }
+    // Erase some objects so that the keys are not contiguous
+    std::vector<ObjKey> to_remove;
+    for (auto& obj : table) {
+        if (obj.get<Int>(col_val) % 13 == 0)
+            to_remove.push_back(obj.get_key());
+    }
+    for (auto key : to_remove)
+        table.remove_object(key);
+
+    auto expected = [&](util::FunctionRef<bool(const Obj&)> pred) {
+        std::vector<ObjKey> keys;
+        for (auto& obj : table) {
+            if (pred(obj))
+                keys.push_back(obj.get_key());
+        }
+        return keys;
+    };
+    auto check = [&](Query q, const std::vector<ObjKey>& keys) {
+        CHECK_EQUAL(q.count(), keys.size());
+        auto tv = q.find_all();
+        tv.sort(col_val);
+        CHECK_EQUAL(tv.size(), keys.size());
+        for (size_t i = 0; i < tv.size() && i < keys.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), keys[i]);
+        int64_t sum = 0;
+        for (auto key : keys)
+            sum += table.get_object(key).get<Int>(col_val);
+        CHECK_EQUAL(q.sum(col_val)->get_int(), sum);
+        if (keys.size() > 2)
+            CHECK_EQUAL(q.find_all(2).size(), 2);
+    };
+
+    check(table.where().equal(col_owner, 7).equal(col_status, "closed"), expected([&](const Obj& obj) {
+              return obj.get<Int>(col_owner) == 7 && obj.get<String>(col_status) == "closed";
+          }));
+    check(table.where().equal(col_status, "pending").equal(col_day, 3).equal(col_owner, 17),
+          expected([&](const Obj& obj) {
+              return obj.get<String>(col_status) == "pending" && obj.get<util::Optional<Int>>(col_day) == 3 &&
+                     obj.get<Int>(col_owner) == 17;
+          }));
+    check(table.where().equal(col_day, null()).equal(col_owner, 5).greater(col_val, 1000),
+          expected([&](const Obj& obj) {
+              return !obj.get<util::Optional<Int>>(col_day) && obj.get<Int>(col_owner) == 5 &&
+                     obj.get<Int>(col_val) > 1000;
+          }));
+    check(table.where().equal(col_owner, 0).equal(col_day, 0).equal(col_status, "open"),
+          expected([&](const Obj& obj) {
+              return obj.get<Int>(col_owner) == 0 && obj.get<util::Optional<Int>>(col_day) == 0 &&
+                     obj.get<String>(col_status) == "open";
+          }));
+    check(table.where().equal(col_status, "open").equal(col_owner, 41), {});
+}
+
 #endif // TEST_QUERY
@@ -1584,6 +1584,74 @@ TEST(Shared_WriterThreads)
 }
 
 
+TEST(Shared_WriterThreadsWithGroupCommit)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    const int thread_count = 10;
+    {
+        DBOptions options(crypt_key());
+        options.enable_group_commit = true;
+        DBRef sg = DB::create(path, options);
+
+        {
+            WriteTransaction wt(sg);
+            auto t1 = wt.add_table("test");
+            test_table_add_columns(t1);
+            for (int i = 0; i < thread_count; ++i)
+                t1->create_object(ObjKey(i)).set_all(0, 2, false, "test");
+            wt.commit();
+        }
+
+        // Another DB on the same file commits without group commit
+        DBRef sg_2 = DB::create(path, DBOptions(crypt_key()));
+        std::thread threads[thread_count];
+        for (int i = 0; i < thread_count; ++i)
+            threads[i] = std::thread(writer_threads_thread, std::ref(test_context), i % 2 ? sg : sg_2, ObjKey(i));
+        for (int i = 0; i < thread_count; ++i)
+            threads[i].join();
+    }
+
+    // Everything committed must be there after reopening the file
+    DBRef sg = DB::create(path, DBOptions(crypt_key()));
+    ReadTransaction rt(sg);
+    rt.get_group().verify();
+    auto t = rt.get_table("test");
+    auto col = t->get_column_keys()[0];
+    for (int i = 0; i < thread_count; ++i) {
+        CHECK_EQUAL(100, t->get_object(ObjKey(i)).get<Int>(col));
+    }
+}
+
+#if !defined(_WIN32) && !REALM_PLATFORM_APPLE
+TEST_IF(Shared_GroupCommitSyncFailure, _impl::SimulatedFailure::is_enabled())
+{
+    SHARED_GROUP_TEST_PATH(path);
+    {
+        DBOptions options(crypt_key());
+        options.enable_group_commit = true;
+        DBRef sg = DB::create(path, options);
+        auto tr = sg->start_write();
+        tr->add_table("test")->create_object();
+        {
+            using sf = _impl::SimulatedFailure;
+            sf::OneShotPrimeGuard pg(sf::group_writer__commit);
+            CHECK_THROW(tr->commit(), sf);
+        }
+        // Only making the new version durable failed, so it must be visible,
+        // and the transaction must have ended like after a successful commit
+        CHECK_NOT_EQUAL(tr->get_transact_stage(), DB::transact_Writing);
+        CHECK_EQUAL(sg->start_read()->get_table("test")->size(), 1);
+
+        // The next commit makes both versions durable
+        tr = sg->start_write();
+        tr->get_table("test")->create_object();
+        tr->commit();
+    }
+    DBRef sg = DB::create(path, DBOptions(crypt_key()));
+    CHECK_EQUAL(sg->start_read()->get_table("test")->size(), 2);
+}
+#endif
+
 #if !REALM_ENABLE_ENCRYPTION && defined(ENABLE_ROBUST_AGAINST_DEATH_DURING_WRITE)
 // this unittest has issues that has not been fully understood, but could be
 // related to interaction between posix robust mutexes and the fork() system call.
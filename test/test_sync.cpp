@@ -7,6 +7,7 @@
 #include <cstring>
 #include <memory>
 #include <mutex>
+#include <regex>
 #include <set>
 #include <sstream>
 #include <string>
@@ -703,6 +704,94 @@ TEST(Sync_Replication)
 }
 
 
+TEST(Sync_ReplicationWithSeveralWorkerThreads)
+{
+    // Replicate changes in several files at once, with the files spread over
+    // the worker threads of the server.
+
+    const int num_files = 8;
+    TEST_DIR(dir);
+    ClientServerFixture::Config config;
+    config.server_num_worker_threads = 4;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    TEST_DIR(dir_2);
+    std::vector<DBRef> dbs_1, dbs_2;
+    std::vector<Session> sessions_1, sessions_2;
+    for (int i = 0; i < num_files; ++i) {
+        std::string server_path = "/test_" + std::to_string(i);
+        std::string path_1 = util::File::resolve(std::to_string(i) + "_1.realm", dir_2);
+        std::string path_2 = util::File::resolve(std::to_string(i) + "_2.realm", dir_2);
+        dbs_1.push_back(DB::create(make_client_replication(), path_1));
+        dbs_2.push_back(DB::create(make_client_replication(), path_2));
+        sessions_1.push_back(fixture.make_session(dbs_1.back(), server_path));
+        sessions_2.push_back(fixture.make_session(dbs_2.back(), server_path));
+    }
+
+    for (int i = 0; i < num_files; ++i) {
+        write_transaction(dbs_1[i], [](WriteTransaction& wt) {
+            TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+            table->add_column(type_Int, "i");
+        });
+    }
+    for (int j = 0; j < 20; ++j) {
+        for (int i = 0; i < num_files; ++i) {
+            WriteTransaction wt(dbs_1[i]);
+            wt.get_table("class_foo")->create_object_with_primary_key(j).set("i", i);
+            wt.commit();
+        }
+    }
+
+    for (int i = 0; i < num_files; ++i) {
+        sessions_1[i].wait_for_upload_complete_or_client_stopped();
+        sessions_2[i].wait_for_download_complete_or_client_stopped();
+    }
+
+    for (int i = 0; i < num_files; ++i) {
+        ReadTransaction rt_1(dbs_1[i]);
+        ReadTransaction rt_2(dbs_2[i]);
+        CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+        ConstTableRef table = rt_2.get_group().get_table("class_foo");
+        CHECK_EQUAL(20, table->size());
+    }
+}
+
+TEST(Sync_DownloadManyLargeChangesets)
+{
+    // A download large enough to be parsed on several threads
+
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+
+    TEST_DIR(dir);
+    ClientServerFixture fixture(dir, test_context);
+    fixture.start();
+
+    {
+        Session session_1 = fixture.make_bound_session(db_1);
+        write_transaction(db_1, [](WriteTransaction& wt) {
+            TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+            table->add_column(type_String, "s");
+        });
+        for (int i = 0; i < 40; ++i) {
+            WriteTransaction wt(db_1);
+            std::string str(64 * 1024, char('a' + i % 26));
+            wt.get_table("class_foo")->create_object_with_primary_key(i).set("s", StringData(str));
+            wt.commit();
+        }
+        session_1.wait_for_upload_complete_or_client_stopped();
+    }
+
+    Session session_2 = fixture.make_bound_session(db_2);
+    session_2.wait_for_download_complete_or_client_stopped();
+
+    ReadTransaction rt_1(db_1);
+    ReadTransaction rt_2(db_2);
+    CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+    CHECK_EQUAL(40, rt_2.get_group().get_table("class_foo")->size());
+}
+
 TEST(Sync_Merge)
 {
 
@@ -4877,6 +4966,248 @@ TEST(Sync_VerifyServerHistoryAfterLargeUpload)
 }
 
 
+TEST(Sync_ServerHistoryCompaction)
+{
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db);
+
+    ClientServerFixture fixture{server_dir, test_context};
+    std::string server_path = fixture.map_virtual_to_real_path("/test");
+    TestServerHistoryContext context;
+    _impl::ServerHistory history{context};
+    DBRef server_db = DB::create(history, server_path);
+
+    {
+        WriteTransaction wt{server_db};
+        auto target = wt.get_group().add_table_with_primary_key("class_target", type_Int, "id");
+        auto table = wt.get_group().add_table_with_primary_key("class_table", type_Int, "id");
+        table->add_column(type_Int, "value");
+        table->add_column(*target, "link");
+        target->create_object_with_primary_key(1);
+        wt.commit();
+    }
+    // Repeatedly overwritten field
+    for (int i = 0; i < 10; ++i) {
+        WriteTransaction wt{server_db};
+        wt.get_table("class_table")->create_object_with_primary_key(1).set("value", i);
+        wt.commit();
+    }
+    // Object created and erased again
+    {
+        WriteTransaction wt{server_db};
+        wt.get_table("class_table")->create_object_with_primary_key(2).set("value", 7);
+        wt.commit();
+    }
+    {
+        WriteTransaction wt{server_db};
+        wt.get_table("class_table")->get_object_with_primary_key(2).remove();
+        wt.commit();
+    }
+    // Link target created and erased again must survive
+    {
+        WriteTransaction wt{server_db};
+        auto target = wt.get_table("class_target")->create_object_with_primary_key(2);
+        wt.get_table("class_table")->get_object_with_primary_key(1).set("link", target.get_key());
+        wt.commit();
+    }
+    {
+        WriteTransaction wt{server_db};
+        wt.get_table("class_target")->get_object_with_primary_key(2).remove();
+        wt.commit();
+    }
+
+    _impl::ServerHistory::CompactionResult result;
+    sync::VersionInfo version_info;
+    CHECK(history.compact_history(0, 0, {}, result, version_info, *test_context.logger));
+    CHECK_EQUAL(result.compacted_until_version, version_info.sync_version.version);
+    // Nine overwritten values, the creation and update of the erased object
+    // in `class_table`, and the link that was nullified by the erasure of its
+    // target
+    CHECK_EQUAL(result.num_discarded_instructions, 12);
+    CHECK_EQUAL(result.num_emptied_changesets, 9);
+    CHECK_GREATER(result.num_bytes_reclaimed, 0);
+    {
+        ReadTransaction rt{server_db};
+        rt.get_group().verify();
+    }
+
+    // The erased link target keeps its creation, the plain object does not
+    {
+        auto count_instructions = [&](StringData table_name, bool erase) {
+            std::size_t n = 0;
+            for (const sync::Changeset& changeset : history.get_parsed_changesets(1, -1)) {
+                for (const sync::Instruction* instr : changeset) {
+                    if (!instr)
+                        continue;
+                    bool matches_type = erase ? bool(instr->get_if<sync::Instruction::EraseObject>())
+                                              : bool(instr->get_if<sync::Instruction::CreateObject>());
+                    auto obj_instr = instr->get_if<sync::Instruction::ObjectInstruction>();
+                    if (matches_type && changeset.get_string(obj_instr->table) == table_name &&
+                        changeset.get_key(obj_instr->object) == sync::PrimaryKey{int64_t(2)})
+                        ++n;
+                }
+            }
+            return n;
+        };
+        CHECK_EQUAL(count_instructions("target", false), 1);
+        CHECK_EQUAL(count_instructions("target", true), 1);
+        CHECK_EQUAL(count_instructions("table", false), 0);
+        CHECK_EQUAL(count_instructions("table", true), 1);
+    }
+
+    // Nothing new to compact
+    CHECK_NOT(history.compact_history(0, 0, {}, result, version_info, *test_context.logger));
+    {
+        WriteTransaction wt{server_db};
+        wt.get_table("class_table")->get_object_with_primary_key(1).set("value", 10);
+        wt.commit();
+    }
+    CHECK_NOT(history.compact_history(3600, 0, {}, result, version_info, *test_context.logger));
+
+    // A new client bootstrapped from the compacted history ends up with the
+    // same state
+    fixture.start();
+    Session session = fixture.make_bound_session(db, "/test");
+    session.wait_for_download_complete_or_client_stopped();
+    ReadTransaction rt_1{db};
+    ReadTransaction rt_2{server_db};
+    CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+    CHECK_EQUAL(rt_1.get_table("class_table")->get_object_with_primary_key(1).get<Int>("value"), 10);
+}
+
+
+TEST(Sync_ServerHistoryCompaction_IdleClient)
+{
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db);
+
+    ClientServerFixture fixture{server_dir, test_context};
+    fixture.start();
+    {
+        // Register a client file that then never uploads anything
+        Session session = fixture.make_bound_session(db, "/test");
+        session.wait_for_download_complete_or_client_stopped();
+    }
+    fixture.stop();
+
+    std::string server_path = fixture.map_virtual_to_real_path("/test");
+    TestServerHistoryContext context;
+    _impl::ServerHistory history{context};
+    DBRef server_db = DB::create(history, server_path);
+    auto overwrite_field = [&](int n) {
+        for (int i = 0; i < n; ++i) {
+            WriteTransaction wt{server_db};
+            TableRef table = wt.get_table("class_table");
+            if (!table) {
+                table = wt.get_group().add_table_with_primary_key("class_table", type_Int, "id");
+                table->add_column(type_Int, "value");
+            }
+            table->create_object_with_primary_key(1).set("value", i);
+            wt.commit();
+        }
+    };
+    overwrite_field(10);
+
+    // The idle client holds back the compaction unless clients expire
+    {
+        _impl::ServerHistory::CompactionResult result;
+        sync::VersionInfo version_info;
+        CHECK_NOT(history.compact_history(0, 0, {}, result, version_info, *test_context.logger));
+        CHECK_NOT(history.compact_history(0, 3600, {}, result, version_info, *test_context.logger));
+        CHECK_EQUAL(result.num_expired_client_files, 0);
+    }
+
+    // A client that was seen recently by a session does not expire, even if
+    // it does not upload anything
+    std::this_thread::sleep_for(std::chrono::milliseconds{1100});
+    {
+        version_type current_version;
+        SaltedFileIdent file_ident;
+        SyncProgress progress;
+        get_history(db).get_status(current_version, file_ident, progress);
+        std::vector<_impl::ServerHistory::ClientAccess> client_accesses = {{file_ident.ident, std::time(nullptr)}};
+        _impl::ServerHistory::CompactionResult result;
+        sync::VersionInfo version_info;
+        // Only the last seen timestamp is committed
+        CHECK(history.compact_history(0, 1, client_accesses, result, version_info, *test_context.logger));
+        CHECK_EQUAL(result.num_expired_client_files, 0);
+        CHECK_EQUAL(result.num_discarded_instructions, 0);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{2100});
+    {
+        _impl::ServerHistory::CompactionResult result;
+        sync::VersionInfo version_info;
+        CHECK(history.compact_history(0, 1, {}, result, version_info, *test_context.logger));
+        CHECK_EQUAL(result.num_expired_client_files, 1);
+        CHECK_EQUAL(result.compacted_until_version, version_info.sync_version.version);
+        CHECK_GREATER_EQUAL(result.num_discarded_instructions, 9);
+        ReadTransaction rt{server_db};
+        rt.get_group().verify();
+    }
+
+    // The expired client no longer holds back the compaction
+    overwrite_field(2);
+    {
+        _impl::ServerHistory::CompactionResult result;
+        sync::VersionInfo version_info;
+        CHECK(history.compact_history(0, 0, {}, result, version_info, *test_context.logger));
+        CHECK_EQUAL(result.num_expired_client_files, 0);
+        CHECK_EQUAL(result.compacted_until_version, version_info.sync_version.version);
+    }
+}
+
+
+TEST(Sync_ServerHistoryCompaction_DownloadOnlyClient)
+{
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+
+    ClientServerFixture::Config config;
+    config.server_history_compaction_interval = 1;
+    config.server_history_ttl = 2;
+    ClientServerFixture fixture{server_dir, test_context, std::move(config)};
+    fixture.start();
+
+    std::atomic<bool> got_error{false};
+    Session::Config session_config;
+    session_config.connection_state_change_listener = [&](ConnectionState, util::Optional<ErrorInfo> error_info) {
+        if (error_info)
+            got_error = true;
+    };
+    Session session_1 = fixture.make_bound_session(db_1, "/test");
+    Session session_2 = fixture.make_bound_session(db_2, "/test", std::move(session_config));
+
+    // Client 1 keeps uploading for longer than the TTL while client 2 only
+    // downloads, so its upload progress never advances
+    auto overwrite_field = [&](int value) {
+        WriteTransaction wt{db_1};
+        TableRef table = wt.get_table("class_table");
+        if (!table) {
+            table = wt.get_group().add_table_with_primary_key("class_table", type_Int, "id");
+            table->add_column(type_Int, "value");
+        }
+        table->create_object_with_primary_key(1).set("value", value);
+        session_1.nonsync_transact_notify(wt.commit());
+    };
+    for (int i = 0; i < 10; ++i) {
+        overwrite_field(i);
+        session_1.wait_for_upload_complete_or_client_stopped();
+        session_2.wait_for_download_complete_or_client_stopped();
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+    }
+
+    session_1.wait_for_download_complete_or_client_stopped();
+    session_2.wait_for_download_complete_or_client_stopped();
+    CHECK_NOT(got_error);
+    ReadTransaction rt_1{db_1};
+    ReadTransaction rt_2{db_2};
+    CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+    CHECK_EQUAL(rt_2.get_table("class_table")->get_object_with_primary_key(1).get<Int>("value"), 9);
+}
+
+
 TEST(Sync_ServerSideModify_Randomize)
 {
     int num_server_side_transacts = 1200;
@@ -5398,6 +5729,197 @@ TEST(Sync_ServerSideEncryption)
     CHECK(group.has_table("class_Test"));
 }
 
+TEST(Sync_ServerAsyncFileOpen)
+{
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+
+    {
+        WriteTransaction wt(db_1);
+        wt.get_group().add_table_with_primary_key("class_Test", type_Int, "id")->create_object_with_primary_key(1);
+        wt.commit();
+    }
+
+    {
+        ClientServerFixture::Config config;
+        config.server_num_file_open_threads = 2;
+        ClientServerFixture fixture(server_dir, test_context, std::move(config));
+        fixture.start();
+
+        // Both sessions bind while the file is opened in the background
+        Session session_1 = fixture.make_bound_session(db_1, "/test");
+        Session session_2 = fixture.make_bound_session(db_2, "/test");
+        session_1.wait_for_upload_complete_or_client_stopped();
+        session_2.wait_for_download_complete_or_client_stopped();
+
+        Server::FileAccessMetrics metrics = fixture.get_server().get_file_access_metrics();
+        CHECK_EQUAL(metrics.num_async_opens, 1);
+        CHECK_EQUAL(metrics.num_misses, 1);
+        CHECK_GREATER(metrics.num_hits, 0);
+        CHECK_GREATER(metrics.max_open_time.count(), 0);
+        CHECK_GREATER_EQUAL(metrics.total_open_time.count(), metrics.max_open_time.count());
+    }
+
+    // After a restart, the file is opened before any client binds to it
+    {
+        ClientServerFixture::Config config;
+        config.server_num_file_open_threads = 1;
+        config.server_num_prefetched_files = 1;
+        ClientServerFixture fixture(server_dir, test_context, std::move(config));
+        fixture.start();
+
+        Session session = fixture.make_bound_session(db_3, "/test");
+        session.wait_for_download_complete_or_client_stopped();
+
+        Server::FileAccessMetrics metrics = fixture.get_server().get_file_access_metrics();
+        CHECK_EQUAL(metrics.num_async_opens, 1);
+        CHECK_EQUAL(metrics.num_misses, 1);
+    }
+
+    ReadTransaction rt_1(db_1);
+    ReadTransaction rt_2(db_2);
+    ReadTransaction rt_3(db_3);
+    CHECK(compare_groups(rt_1, rt_2));
+    CHECK(compare_groups(rt_1, rt_3));
+}
+
+TEST(Sync_ServerAsyncFileOpen_Failure)
+{
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+    TEST_CLIENT_DB(db_3);
+
+    ClientServerFixture::Config config;
+    config.server_num_file_open_threads = 1;
+    ClientServerFixture fixture(server_dir, test_context, std::move(config));
+    std::string real_path = fixture.map_virtual_to_real_path("/broken");
+    {
+        util::File file{real_path, util::File::mode_Write};
+        file.write(0, std::string(4096, 'x'));
+    }
+    fixture.start();
+
+    // The session bound to the file that cannot be opened fails, without
+    // affecting the server
+    BowlOfStonesSemaphore bowl;
+    Session::Config session_config;
+    session_config.connection_state_change_listener = [&](ConnectionState state,
+                                                          std::optional<SessionErrorInfo> error) {
+        if (state != ConnectionState::disconnected)
+            return;
+        if (CHECK(error))
+            CHECK_EQUAL(error->status, ErrorCodes::RuntimeError);
+        bowl.add_stone();
+    };
+    Session session_1 = fixture.make_bound_session(db_1, "/broken", std::move(session_config));
+    bowl.get_stone();
+
+    Session session_2 = fixture.make_bound_session(db_2, "/test");
+    session_2.wait_for_download_complete_or_client_stopped();
+
+    // The failed file is not kept, so a later session opens it again
+    util::File::remove(real_path);
+    Session session_3 = fixture.make_bound_session(db_3, "/broken");
+    session_3.wait_for_download_complete_or_client_stopped();
+
+    Server::FileAccessMetrics metrics = fixture.get_server().get_file_access_metrics();
+    CHECK_EQUAL(metrics.num_async_opens, 2);
+}
+
+TEST(Sync_WebSocketPerMessageDeflate)
+{
+    for (bool context_takeover : {true, false}) {
+        TEST_DIR(server_dir);
+        TEST_CLIENT_DB(db_1);
+        TEST_CLIENT_DB(db_2);
+
+        ClientServerFixture::Config config;
+        config.websocket_options.permessage_deflate = true;
+        config.websocket_options.deflate_context_takeover = context_takeover;
+        config.websocket_options.coalesce_writes = true;
+        ClientServerFixture fixture(server_dir, test_context, std::move(config));
+        fixture.start();
+
+        Session session_1 = fixture.make_bound_session(db_1, "/test");
+        Session session_2 = fixture.make_bound_session(db_2, "/test");
+
+        write_transaction(db_1, [](WriteTransaction& wt) {
+            TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+            table->add_column(type_String, "s");
+        });
+        for (int i = 0; i < 100; ++i) {
+            WriteTransaction wt(db_1);
+            TableRef table = wt.get_table("class_foo");
+            table->create_object_with_primary_key(i).set("s", std::string(i * 10, 'a' + i % 26));
+            wt.commit();
+        }
+        session_1.wait_for_upload_complete_or_client_stopped();
+        session_2.wait_for_download_complete_or_client_stopped();
+
+        ReadTransaction rt_1(db_1);
+        ReadTransaction rt_2(db_2);
+        CHECK(compare_groups(rt_1, rt_2));
+    }
+}
+
+TEST(Sync_MessageBodyCompression)
+{
+    // Large UPLOAD and DOWNLOAD bodies are compressed with zstd when both
+    // peers support it, and with zlib when the server only offers a protocol
+    // version from before zstd was introduced.
+    const int zstd_version = get_zstd_body_compression_protocol_version();
+    for (int server_max_protocol_version : {0, zstd_version - 1}) {
+        TEST_DIR(server_dir);
+        TEST_CLIENT_DB(db_1);
+        TEST_CLIENT_DB(db_2);
+
+        std::ostringstream logs;
+        auto logger = std::make_shared<util::ThreadSafeLogger>(std::make_shared<util::StreamLogger>(logs));
+        logger->set_level_threshold(util::Logger::Level::debug);
+        {
+            ClientServerFixture::Config config;
+            config.logger = logger;
+            config.server_max_protocol_version = server_max_protocol_version;
+            ClientServerFixture fixture(server_dir, test_context, std::move(config));
+            fixture.start();
+
+            Session session_1 = fixture.make_bound_session(db_1, "/test");
+            write_transaction(db_1, [](WriteTransaction& wt) {
+                TableRef table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+                table->add_column(type_String, "s");
+            });
+            for (int i = 0; i < 20; ++i) {
+                WriteTransaction wt(db_1);
+                TableRef table = wt.get_table("class_foo");
+                table->create_object_with_primary_key(i).set("s", std::string(4000 + i, 'a' + i % 26));
+                wt.commit();
+            }
+            session_1.wait_for_upload_complete_or_client_stopped();
+
+            Session session_2 = fixture.make_bound_session(db_2, "/test");
+            session_2.wait_for_download_complete_or_client_stopped();
+
+            ReadTransaction rt_1(db_1);
+            ReadTransaction rt_2(db_2);
+            CHECK(compare_groups(rt_1, rt_2));
+        }
+
+        bool expect_zstd = (server_max_protocol_version == 0 && util::compression::zstd_is_available());
+        int expected = int(expect_zstd ? _impl::BodyCompression::zstd : _impl::BodyCompression::deflate);
+        int unexpected = int(expect_zstd ? _impl::BodyCompression::deflate : _impl::BodyCompression::zstd);
+        std::string log_text = logs.str();
+        CHECK(std::regex_search(log_text,
+                                std::regex(util::format("Upload message compression: body_compression=%1,", expected))));
+        CHECK(std::regex_search(
+            log_text, std::regex(util::format(
+                          "Download message compression: session_ident=[0-9]+, body_compression=%1,", expected))));
+        CHECK_EQUAL(log_text.find(util::format("body_compression=%1,", unexpected)), std::string::npos);
+    }
+}
+
 TEST(Sync_LogCompaction_EraseObject_LinkList)
 {
     TEST_DIR(dir);
@@ -7297,6 +7819,80 @@ TEST(Sync_GetEmptyReciprocalChangesetFromArray)
     CHECK(reciprocal_changeset.empty());
 }
 
+TEST(Sync_BootstrapAppliedWhileParsingUnlessLocalChangesToMerge)
+{
+    TEST_CLIENT_DB(db);
+
+    auto& history = get_history(db);
+    history.set_client_file_ident(SaltedFileIdent{1, 0x1234567812345678}, false);
+    timestamp_type timestamp{1};
+    history.set_local_origin_timestamp_source([&] {
+        return ++timestamp;
+    });
+
+    auto latest_local_version = [&] {
+        auto tr = db->start_write();
+        tr->add_table_with_primary_key("class_table", type_Int, "_id")->add_column(type_Int, "value");
+        tr->get_table("class_table")->create_object_with_primary_key(42);
+        return tr->commit();
+    }();
+
+    std::ostringstream logs;
+    util::StreamLogger logger{logs};
+    logger.set_level_threshold(util::Logger::Level::debug);
+    const std::string streaming_message = "No local changes to merge";
+    version_type server_version = 0;
+
+    auto integrate_bootstrap = [&](int64_t value, version_type last_integrated_local_version) {
+        Changeset changeset;
+        instr::Update instr;
+        instr.table = changeset.intern_string("table");
+        instr.object = instr::PrimaryKey{42};
+        instr.field = changeset.intern_string("value");
+        instr.value = instr::Payload{value};
+        changeset.push_back(instr);
+        changeset.version = ++server_version;
+        changeset.last_integrated_remote_version = last_integrated_local_version;
+        changeset.origin_timestamp = ++timestamp;
+        changeset.origin_file_ident = 2;
+
+        ChangesetEncoder::Buffer encoded;
+        encode_changeset(changeset, encoded);
+        RemoteChangeset server_changeset(changeset.version, changeset.last_integrated_remote_version,
+                                         BinaryData(encoded.data(), encoded.size()), changeset.origin_timestamp,
+                                         changeset.origin_file_ident);
+
+        SyncProgress progress = {};
+        progress.download.server_version = changeset.version;
+        progress.download.last_integrated_client_version = last_integrated_local_version;
+        progress.latest_server_version.version = changeset.version;
+        progress.latest_server_version.salt = 0x7876543217654321;
+
+        logs.str("");
+        VersionInfo version_info;
+        auto transact = db->start_write();
+        history.integrate_server_changesets(progress, 0, util::Span(&server_changeset, 1), version_info,
+                                            DownloadBatchState::LastInBatch, logger, transact);
+        CHECK_EQUAL(transact->get_transact_stage(), DB::transact_Reading);
+        return transact->get_table("class_table")->get_object_with_primary_key(42).get<Int>("value");
+    };
+
+    // The server has integrated every local change, so there is nothing for
+    // the transformer to merge and the changeset is applied as it is parsed.
+    CHECK_EQUAL(integrate_bootstrap(5, latest_local_version), 5);
+    CHECK(StringData(logs.str()).contains(streaming_message));
+
+    // A local change the server has not seen yet must be merged with the
+    // download, so integration falls back to the transformer.
+    {
+        auto tr = db->start_write();
+        tr->get_table("class_table")->get_object_with_primary_key(42).set("value", 6);
+        tr->commit();
+    }
+    CHECK_EQUAL(integrate_bootstrap(7, latest_local_version), 7);
+    CHECK_NOT(StringData(logs.str()).contains(streaming_message));
+}
+
 TEST(Sync_InvalidChangesetFromServer)
 {
     TEST_CLIENT_DB(db);
@@ -194,6 +194,90 @@ TEST(Protocol_Codec_Upload)
     }
 }
 
+TEST(Protocol_Codec_Upload_BodyCompression)
+{
+    // Builds with zstd compress large bodies with it once the negotiated
+    // protocol version allows it, and fall back to zlib before that.
+    const int zstd_version = sync::get_zstd_body_compression_protocol_version();
+    bool have_zstd = util::compression::zstd_is_available();
+    std::string data = std::string(2048, 'A') + std::string(2048, 'B');
+    std::string body = util::format("4 2 259609999999 123999 %1 ", data.size()) + data;
+
+    struct Case {
+        int protocol_version;
+        _impl::BodyCompression expected;
+    };
+    Case cases[] = {
+        {zstd_version - 1, _impl::BodyCompression::deflate},
+        {zstd_version, have_zstd ? _impl::BodyCompression::zstd : _impl::BodyCompression::deflate},
+    };
+    for (auto& c : cases) {
+        auto protocol = _impl::ClientProtocol();
+        auto out = _impl::ClientProtocol::OutputBuffer();
+        auto upload_message_builder = protocol.make_upload_message_builder(); // Throws
+        upload_message_builder.add_changeset(4, 2, 259609999999, 123999, BinaryData(data.data(), data.size()));
+        upload_message_builder.make_upload_message(c.protocol_version, out, 888123, 4, 2, 0);
+
+        _impl::HeaderLineParser msg(std::string_view(out.data(), out.size()));
+        CHECK_EQUAL(msg.read_next<std::string_view>(), "upload");
+        CHECK_EQUAL(msg.read_next<int>(), 888123);
+        auto method = msg.read_next<int>();
+        CHECK_EQUAL(method, int(c.expected));
+        CHECK_EQUAL(msg.read_next<size_t>(), body.size());
+        auto compressed_size = msg.read_next<size_t>();
+        CHECK_LESS(compressed_size, body.size());
+        CHECK_EQUAL(msg.read_next<int>(), 4);
+        CHECK_EQUAL(msg.read_next<int>(), 2);
+        CHECK_EQUAL(msg.read_next<int>('\n'), 0);
+        CHECK_EQUAL(msg.bytes_remaining(), compressed_size);
+
+        Buffer<char> decompressed(body.size());
+        CHECK_NOT(_impl::decompress_message_body(_impl::BodyCompression(method),
+                                                 {msg.remaining().data(), compressed_size}, decompressed));
+        compare_out_string(body, decompressed, test_context);
+    }
+
+    // Small bodies are never compressed
+    {
+        util::compression::CompressMemoryArena arena;
+        std::vector<char> compressed;
+        CHECK(_impl::compress_message_body(zstd_version, arena, Span<const char>("abc", 3), compressed) ==
+              _impl::BodyCompression::none);
+    }
+
+    CHECK(_impl::is_valid_body_compression(0));
+    CHECK(_impl::is_valid_body_compression(2));
+    CHECK_NOT(_impl::is_valid_body_compression(3));
+    CHECK_NOT(_impl::is_valid_body_compression(-1));
+}
+
+TEST(Protocol_Codec_UploadCompressedChangeset)
+{
+    auto protocol = _impl::ClientProtocol();
+    auto out = _impl::ClientProtocol::OutputBuffer();
+    std::string data1 = "AABBCCDDEEFFGGHHIIJJKKLLMMNNOOPP";
+    std::string data2 = "EEFFGGHHIIJJKKLLMMNNOOPPQQRRSSTT";
+    auto compressed1 = util::compression::allocate_and_compress_nonportable({data1.data(), data1.size()});
+    auto compressed2 = util::compression::allocate_and_compress_nonportable({data2.data(), data2.size()});
+
+    auto upload_message_builder = protocol.make_upload_message_builder(); // Throws
+    CHECK_NOT(upload_message_builder.add_compressed_changeset(
+        29, 18, 259604001718, 888123, BinaryData(compressed1.data(), compressed1.size())));
+
+    // A truncated changeset is rejected without leaving anything in the body
+    CHECK(upload_message_builder.add_compressed_changeset(30, 19, 259604001850, 888234,
+                                                          BinaryData(compressed2.data(), compressed2.size() - 4)));
+
+    CHECK_NOT(upload_message_builder.add_compressed_changeset(
+        30, 19, 259604001850, 888234, BinaryData(compressed2.data(), compressed2.size())));
+    upload_message_builder.make_upload_message(7, out, 999123, 30, 17, 10);
+
+    std::string expected_out_string =
+        "upload 999123 0 122 0 30 17 10\n29 18 259604001718 888123 32 AABBCCDDEEFFGGHHIIJJKKLLMMNNOOPP30 19 "
+        "259604001850 888234 32 EEFFGGHHIIJJKKLLMMNNOOPPQQRRSSTT";
+    compare_out_string(expected_out_string, out, test_context);
+}
+
 TEST(Protocol_Codec_Unbind)
 {
     auto protocol = _impl::ClientProtocol();
@@ -35,6 +35,7 @@ using namespace std::chrono;
 #include <realm/util/to_string.hpp>
 #include <realm/util/base64.hpp>
 #include <realm/array_bool.hpp>
+#include <realm/array_integer.hpp>
 #include <realm/array_string.hpp>
 #include <realm/array_timestamp.hpp>
 #include <realm/index_string.hpp>
@@ -3385,6 +3386,92 @@ NONCONCURRENT_TEST(Table_object_random)
     CALLGRIND_STOP_INSTRUMENTATION;
 }
 
+TEST(Table_ReduceIntLeafWidthOnCommit)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef sg = DB::create(*hist, path, DBOptions(crypt_key()));
+    constexpr int num_objects = 1000;
+    ColKey c0;
+    ColKey c1;
+
+    auto expected_value = [](int i) {
+        return int64_t(i % 7) - 3;
+    };
+    auto max_leaf_width = [&](const Table& table) {
+        size_t width = 0;
+        table.traverse_clusters([&](const Cluster* cluster) {
+            ArrayInteger leaf(cluster->get_alloc());
+            cluster->init_leaf(c0, &leaf);
+            width = std::max(width, leaf.get_width());
+            return IteratorControl::AdvanceToNext;
+        });
+        return width;
+    };
+    auto check_table = [&](int64_t value_500) {
+        ReadTransaction rt(sg);
+        rt.get_group().verify();
+        ConstTableRef table = rt.get_table("test");
+        CHECK_EQUAL(table->size(), num_objects);
+        for (int i = 0; i < num_objects; ++i) {
+            Obj obj = table->get_object(ObjKey(i));
+            CHECK_EQUAL(obj.get<Int>(c0), i == 500 ? value_500 : expected_value(i));
+            if (i % 3 == 0)
+                CHECK(obj.is_null(c1));
+            else
+                CHECK_EQUAL(*obj.get<util::Optional<Int>>(c1), -i);
+        }
+        return max_leaf_width(*table);
+    };
+
+    {
+        WriteTransaction wt(sg);
+        auto table = wt.add_table("test");
+        c0 = table->add_column(type_Int, "int");
+        c1 = table->add_column(type_Int, "int_null", true);
+        for (int i = 0; i < num_objects; ++i) {
+            Obj obj = table->create_object(ObjKey(i)).set(c0, expected_value(i));
+            if (i % 3 != 0)
+                obj.set(c1, int64_t(-i));
+        }
+        table->get_object(ObjKey(500)).set(c0, int64_t(0x123456789));
+        wt.commit();
+    }
+    CHECK_EQUAL(check_table(0x123456789), 64);
+
+    // Overwriting the outlier narrows its leaf on commit
+    {
+        WriteTransaction wt(sg);
+        wt.get_table("test")->get_object(ObjKey(500)).set(c0, expected_value(500));
+        wt.commit();
+    }
+    CHECK_EQUAL(check_table(expected_value(500)), 8);
+
+    // The narrowed leaves survive reopening and compaction
+    sg.reset();
+    sg = DB::create(*hist, path, DBOptions(crypt_key()));
+    CHECK_EQUAL(check_table(expected_value(500)), 8);
+    CHECK(sg->compact());
+    CHECK_EQUAL(check_table(expected_value(500)), 8);
+
+    // Also when the outlier goes away with its object
+    {
+        WriteTransaction wt(sg);
+        auto table = wt.get_table("test");
+        table->get_object(ObjKey(500)).set(c0, int64_t(-0x123456789));
+        wt.commit();
+    }
+    {
+        WriteTransaction wt(sg);
+        auto table = wt.get_table("test");
+        table->get_object(ObjKey(500)).remove();
+        table->create_object(ObjKey(500)).set(c0, expected_value(500)).set(c1, int64_t(-500));
+        wt.commit();
+    }
+    CHECK_EQUAL(check_table(expected_value(500)), 8);
+}
+
+
 TEST(Table_CollisionMapping)
 {
 
@@ -2271,6 +2271,86 @@ TEST(TableView_UpdateQuery)
     CHECK_EQUAL(3, v[1].get<Int>(col));
 }
 
+TEST(TableView_SyncChangedObjects)
+{
+    Table table;
+    auto col = table.add_column(type_Int, "first");
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(table.create_object().set(col, i % 10).get_key());
+
+    Query q = table.where().less(col, 5);
+    TableView previous = q.find_all();
+    std::vector<ObjKey> previous_keys;
+    for (size_t i = 0; i < previous.size(); ++i)
+        previous_keys.push_back(previous.get_key(i));
+
+    // Objects starting and stopping to match, removed and created
+    table.get_object(keys[7]).set(col, 1);
+    table.get_object(keys[12]).set(col, 8);
+    table.get_object(keys[13]).set(col, 2);
+    table.remove_object(keys[0]);
+    table.remove_object(keys[99]);
+    ObjKey created = table.create_object().set(col, 3).get_key();
+    ObjKey not_matching = table.create_object().set(col, 9).get_key();
+    std::vector<ObjKey> changed = {keys[13], created, keys[7], keys[99], not_matching, keys[12], keys[0], keys[7]};
+
+    TableView tv(q, size_t(-1));
+    tv.sync_changed_objects(previous_keys, changed);
+    CHECK(tv.is_in_sync());
+
+    TableView expected = q.find_all();
+    CHECK_EQUAL(tv.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+        CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+    CHECK_EQUAL(tv.get_key(tv.size() - 1), created);
+}
+
+TEST(TableView_FindMore)
+{
+    Table table;
+    auto col = table.add_column(type_Int, "first");
+    auto col_indexed = table.add_column(type_Int, "second");
+    table.add_search_index(col_indexed);
+    // Enough objects to span several leaves
+    for (int i = 0; i < 3000; ++i)
+        table.create_object().set(col, i % 7).set(col_indexed, i % 2);
+
+    auto check_parts = [&](Query q, size_t count) {
+        TableView expected = q.find_all();
+        TableView tv(q, size_t(-1));
+        ObjKey next = tv.find_more(ObjKey(0), count);
+        while (next) {
+            size_t size = tv.size();
+            next = tv.find_more(next, count);
+            CHECK(tv.size() > size || !next);
+        }
+        CHECK(tv.is_in_sync());
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+    };
+    check_parts(table.where(), 1);
+    check_parts(table.where(), 1000);
+    check_parts(table.where().equal(col, 3), 10);
+    check_parts(table.where().equal(col, 3), 5000);
+    check_parts(table.where().equal(col, 8), 10);
+    // Index based queries find all matches at once
+    check_parts(table.where().equal(col_indexed, 1), 10);
+
+    TableView tv(table.where().equal(col, 3), size_t(-1));
+    ObjKey next = tv.find_more(ObjKey(0), 10);
+    CHECK_EQUAL(tv.size(), 10);
+    CHECK_EQUAL(next, ObjKey(67));
+
+    // A change to the table makes the rest of the objects be found at once
+    table.get_object(ObjKey(0)).set(col, 3);
+    CHECK_NOT(tv.find_more(next, 10));
+    CHECK(tv.is_in_sync());
+    CHECK_EQUAL(tv.size(), 430);
+    CHECK_EQUAL(tv.get_key(0), ObjKey(0));
+}
+
 class TestTableView : public TableView {
 public:
     using TableView::TableView;
@@ -2339,6 +2419,39 @@ TEST(TableView_SortFollowedByLimit)
     }
 }
 
+TEST(TableView_SortFollowedByLimitWithTies)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_str = table.add_column(type_String, "str");
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+    std::shuffle(values.begin(), values.end(), std::mt19937(unit_test_random_seed));
+
+    for (auto i : values) {
+        std::string str = std::to_string(i % 7);
+        table.create_object().set(col_int, i % 10).set(col_str, StringData(str));
+    }
+
+    for (size_t limit : {0, 1, 9, 10, 11, 62, 63, 500, 999, 1000, 2000}) {
+        DescriptorOrdering sorted;
+        sorted.append_sort(SortDescriptor({{col_int}, {col_str}}, {false, true}));
+        auto expected = table.where().find_all();
+        expected.apply_descriptor_ordering(sorted);
+
+        DescriptorOrdering ordering;
+        ordering.append_sort(SortDescriptor({{col_int}, {col_str}}, {false, true}));
+        ordering.append_limit(limit);
+        auto tv = table.where().find_all();
+        tv.apply_descriptor_ordering(ordering);
+
+        // Objects comparing equal must keep the order they have without the limit
+        CHECK_EQUAL(tv.size(), std::min(limit, expected.size()));
+        for (size_t i = 0; i < tv.size() && i < expected.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+    }
+}
+
 TEST(TableView_Filter)
 {
     Table table;
@@ -839,6 +839,68 @@ TEST(Transform_AddInteger)
     }
 }
 
+TEST(Transform_SkipMergeOfDisjointChangesets)
+{
+    auto changeset_dump_dir_gen = get_changeset_dump_dir_generator(test_context);
+    auto server = Peer::create_server(test_context, changeset_dump_dir_gen.get());
+    auto client_1 = Peer::create_client(test_context, 2, changeset_dump_dir_gen.get());
+    auto client_2 = Peer::create_client(test_context, 3, changeset_dump_dir_gen.get());
+
+    auto schema = [](WriteTransaction& tr) {
+        TableRef t1 = tr.get_group().add_table_with_primary_key("class_t", type_Int, "id");
+        t1->add_column(type_Int, "i");
+    };
+
+    client_1->create_schema(schema);
+    client_2->create_schema(schema);
+    synchronize(server.get(), {client_1.get(), client_2.get()});
+
+    client_1->transaction([](Peer& client_1) {
+        client_1.table("class_t")->create_object_with_primary_key(1);
+    });
+    client_2->transaction([](Peer& client_2) {
+        client_2.table("class_t")->create_object_with_primary_key(2);
+    });
+    synchronize(server.get(), {client_1.get(), client_2.get()});
+
+    // The changesets touch different objects, so the server has nothing to
+    // transform when integrating the second one.
+    size_t num_skipped = server->history.get_num_skipped_merges();
+    CHECK_GREATER(num_skipped, 0);
+
+    client_1->transaction([](Peer& client_1) {
+        client_1.table("class_t")->get_object_with_primary_key(1).set("i", 1);
+    });
+    client_2->transaction([](Peer& client_2) {
+        client_2.table("class_t")->get_object_with_primary_key(2).set("i", 2);
+    });
+    synchronize(server.get(), {client_1.get(), client_2.get()});
+    CHECK_GREATER(server->history.get_num_skipped_merges(), num_skipped);
+    num_skipped = server->history.get_num_skipped_merges();
+
+    // Conflicting changesets must still be merged.
+    client_1->history.advance_time(10);
+    client_1->transaction([](Peer& client_1) {
+        client_1.table("class_t")->get_object_with_primary_key(2).set("i", 3);
+    });
+    client_2->history.advance_time(20);
+    client_2->transaction([](Peer& client_2) {
+        client_2.table("class_t")->get_object_with_primary_key(2).set("i", 4);
+    });
+    synchronize(server.get(), {client_1.get(), client_2.get()});
+    CHECK_EQUAL(server->history.get_num_skipped_merges(), num_skipped);
+
+    ReadTransaction read_server(server->shared_group);
+    ReadTransaction read_client_1(client_1->shared_group);
+    ReadTransaction read_client_2(client_2->shared_group);
+    ConstTableRef t = read_server.get_table("class_t");
+    CHECK_EQUAL(t->size(), 2);
+    CHECK_EQUAL(t->get_object_with_primary_key(1).get<Int>("i"), 1);
+    CHECK_EQUAL(t->get_object_with_primary_key(2).get<Int>("i"), 4);
+    CHECK(compare_groups(read_server, read_client_1));
+    CHECK(compare_groups(read_server, read_client_2, *test_context.logger));
+}
+
 TEST(Transform_AddIntegerSetNull)
 {
 
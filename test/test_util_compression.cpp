@@ -500,4 +500,168 @@ TEST_IF(Compression_DecompressInputStream_NonCompressible_Large, false)
     test_decompress_stream(test_context, uncompressed, compressed);
 }
 
+namespace {
+// Generate small records which share most of their content, like changesets
+// for the same schema.
+std::vector<std::string> generate_similar_records(size_t count, size_t first_id)
+{
+    std::vector<std::string> records;
+    for (size_t i = 0; i < count; ++i) {
+        size_t id = first_id + i;
+        records.push_back(util::format("{\"table\":\"class_Person\",\"_id\":%1,\"name\":\"Person %2\","
+                                       "\"email\":\"person%3@example.com\",\"age\":%4,\"city\":\"Copenhagen\","
+                                       "\"tags\":[\"customer\",\"newsletter\"]}",
+                                       id, id * 7, id * 13, id % 90));
+    }
+    return records;
+}
+} // anonymous namespace
+
+TEST(Compression_MessageDeflater)
+{
+    auto messages = generate_similar_records(50, 0);
+    messages.push_back("");
+    auto large = generate_non_compressible_data(300 * 1024);
+    messages.push_back(std::string(large.data(), large.size()));
+    auto compressible = generate_compressible_data(300 * 1024);
+    messages.push_back(std::string(compressible.data(), compressible.size()));
+
+    for (bool context_takeover : {true, false}) {
+        compression::MessageDeflater deflater;
+        compression::MessageInflater inflater;
+        size_t total_compressed_size = 0;
+        for (auto& message : messages) {
+            AppendBuffer<char> compressed, decompressed;
+            CHECK_NOT(deflater.compress(message, compressed));
+            total_compressed_size += compressed.size();
+            CHECK_NOT(inflater.decompress(compressed, decompressed));
+            compare(test_context, message, decompressed);
+            if (!context_takeover)
+                deflater.reset();
+        }
+        if (context_takeover) {
+            // Referring back to earlier messages must pay off for similar ones
+            compression::MessageDeflater independent;
+            size_t independent_size = 0;
+            for (auto& message : messages) {
+                AppendBuffer<char> compressed;
+                CHECK_NOT(independent.compress(message, compressed));
+                independent_size += compressed.size();
+                independent.reset();
+            }
+            CHECK_LESS(total_compressed_size, independent_size);
+        }
+    }
+
+    // The examples from RFC 7692 section 7.2.3
+    {
+        compression::MessageInflater inflater;
+        AppendBuffer<char> message;
+        CHECK_NOT(inflater.decompress(Span<const char>("\xf2\x48\xcd\xc9\xc9\x07\x00", 7), message));
+        CHECK_EQUAL(std::string_view(message.data(), message.size()), "Hello");
+        message.clear();
+        // Refers back to the first message
+        CHECK_NOT(inflater.decompress(Span<const char>("\xf2\x00\x11\x00\x00", 5), message));
+        CHECK_EQUAL(std::string_view(message.data(), message.size()), "Hello");
+        message.clear();
+        // Ends with a final block
+        CHECK_NOT(inflater.decompress(Span<const char>("\xf3\x48\xcd\xc9\xc9\x07\x00", 7), message));
+        CHECK_EQUAL(std::string_view(message.data(), message.size()), "Hello");
+    }
+
+    {
+        compression::MessageInflater inflater;
+        AppendBuffer<char> message;
+        CHECK_EQUAL(inflater.decompress(Span<const char>("\xff\xff\xff\xff", 4), message),
+                    compression::error::corrupt_input);
+    }
+
+    // A message may decompress to at most max_size bytes
+    {
+        std::string zeros(1024 * 1024, '\0');
+        compression::MessageDeflater deflater;
+        AppendBuffer<char> compressed;
+        CHECK_NOT(deflater.compress(zeros, compressed));
+        CHECK_LESS(compressed.size(), zeros.size() / 100);
+
+        compression::MessageInflater inflater;
+        AppendBuffer<char> message;
+        CHECK_NOT(inflater.decompress(compressed, message, zeros.size()));
+        CHECK_EQUAL(message.size(), zeros.size());
+
+        CHECK_EQUAL(inflater.decompress(compressed, message, zeros.size() - 1),
+                    compression::error::decompressed_size_too_large);
+        CHECK_EQUAL(message.size(), zeros.size());
+
+        // Without allocating much more than the limit
+        compression::MessageInflater limited;
+        AppendBuffer<char> limited_message;
+        CHECK_EQUAL(limited.decompress(compressed, limited_message, 64 * 1024),
+                    compression::error::decompressed_size_too_large);
+        CHECK_EQUAL(limited_message.size(), 0);
+        CHECK_LESS(limited_message.capacity(), 128 * 1024);
+    }
+}
+
+TEST(Compression_Zstd)
+{
+    if (!compression::zstd_is_available()) {
+        std::vector<char> compressed;
+        CHECK_EQUAL(compression::allocate_and_compress_zstd(Span<const char>("abc", 3), compressed),
+                    compression::error::compress_unsupported);
+        Buffer<char> decompressed(3);
+        CHECK_EQUAL(compression::decompress_zstd(Span<const char>("abc", 3), decompressed),
+                    compression::error::decompress_unsupported);
+        return;
+    }
+
+    // Round trip of empty, compressible and non-compressible data
+    auto records = generate_similar_records(200, 0);
+    std::string joined;
+    for (auto& record : records)
+        joined += record;
+    auto compressible = generate_compressible_data(1 << 20);
+    auto non_compressible = generate_non_compressible_data(1 << 16);
+    std::vector<Span<const char>> inputs = {Span<const char>(), joined, compressible, non_compressible};
+    for (auto& input : inputs) {
+        std::vector<char> compressed;
+        CHECK_NOT(compression::allocate_and_compress_zstd(input, compressed));
+        Buffer<char> decompressed(input.size());
+        CHECK_NOT(compression::decompress_zstd(compressed, decompressed));
+        compare(test_context, input, decompressed);
+    }
+
+    // zstd must be competitive with zlib on typical sync payloads
+    {
+        std::vector<char> zstd_compressed, zlib_compressed;
+        CHECK_NOT(compression::allocate_and_compress_zstd(joined, zstd_compressed));
+        compression::CompressMemoryArena arena;
+        CHECK_NOT(compression::allocate_and_compress(arena, joined, zlib_compressed));
+        CHECK_LESS(zstd_compressed.size(), joined.size() / 4);
+        CHECK_LESS_EQUAL(zstd_compressed.size(), zlib_compressed.size() * 11 / 10);
+    }
+
+    std::vector<char> compressed;
+    CHECK_NOT(compression::allocate_and_compress_zstd(Span<const char>(compressible), compressed));
+
+    // The decompressed size must match the size of the target buffer exactly
+    {
+        Buffer<char> decompressed(compressible.size() - 1);
+        CHECK_EQUAL(compression::decompress_zstd(compressed, decompressed),
+                    compression::error::incorrect_decompressed_size);
+        Buffer<char> larger(compressible.size() + 1);
+        CHECK_EQUAL(compression::decompress_zstd(compressed, larger),
+                    compression::error::incorrect_decompressed_size);
+    }
+
+    // Truncated and corrupt input is rejected
+    {
+        Buffer<char> decompressed(compressible.size());
+        CHECK_EQUAL(compression::decompress_zstd(Span(compressed.data(), compressed.size() - 10), decompressed),
+                    compression::error::corrupt_input);
+        CHECK_EQUAL(compression::decompress_zstd(Span<const char>("\xff\xff\xff\xff\xff\xff", 6), decompressed),
+                    compression::error::corrupt_input);
+    }
+}
+
 } // anonymous namespace
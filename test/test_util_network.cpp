@@ -563,6 +563,55 @@ TEST(Network_AsyncReadWriteLargeAmount)
 }
 
 
+TEST(Network_AsyncReadUntilAroundLargeRead)
+{
+    // Large reads bypass the read-ahead buffer, which must not lose or
+    // reorder data buffered by the surrounding delimited reads.
+    network::Service service_1;
+    network::Acceptor acceptor{service_1};
+    network::Endpoint listening_endpoint = bind_acceptor(acceptor);
+
+    size_t payload_size = 300000;
+    std::string message = "header\n";
+    for (size_t i = 0; i < payload_size; ++i)
+        message += char('a' + i % 26);
+    message += "trailer\n";
+
+    auto reader = [&] {
+        network::Socket socket_1{service_1};
+        acceptor.accept(socket_1);
+        network::ReadAheadBuffer rab;
+        char line[16];
+        std::unique_ptr<char[]> payload(new char[payload_size]);
+        socket_1.async_read_until(line, sizeof line, '\n', rab, [&](std::error_code ec, size_t n) {
+            if (!CHECK_NOT(ec))
+                return;
+            CHECK_EQUAL("header\n", std::string(line, n));
+            socket_1.async_read(payload.get(), payload_size, rab, [&](std::error_code ec, size_t n) {
+                if (!CHECK_NOT(ec))
+                    return;
+                CHECK_EQUAL(payload_size, n);
+                CHECK(message.compare(7, payload_size, payload.get(), n) == 0);
+                socket_1.async_read_until(line, sizeof line, '\n', rab, [&](std::error_code ec, size_t n) {
+                    if (CHECK_NOT(ec))
+                        CHECK_EQUAL("trailer\n", std::string(line, n));
+                });
+            });
+        });
+        service_1.run();
+    };
+    ThreadWrapper thread;
+    thread.start(reader);
+
+    network::Service service_2;
+    network::Socket socket_2{service_2};
+    socket_2.connect(listening_endpoint);
+    socket_2.write(message.data(), message.size());
+    socket_2.close();
+
+    CHECK_NOT(thread.join());
+}
+
 TEST(Network_SocketAndAcceptorOpen)
 {
     network::Service service_1;
@@ -21,14 +21,45 @@ public:
 
     Pipe(const Pipe&) = delete;
 
+    // The number of calls to async_write() and the number of bytes written.
+    size_t num_writes = 0;
+    size_t num_bytes_written = 0;
+
+    // If set, async_write() does not complete until complete_write() is
+    // called.
+    bool defer_writes = false;
+
     void async_write(const char* data, size_t size, WriteCompletionHandler handler)
     {
         m_logger_ptr->trace(util::LogCategory::network, "async_write, size = %1", size);
+        ++num_writes;
+        num_bytes_written += size;
+        if (defer_writes) {
+            REALM_ASSERT(!m_write_handler);
+            m_write_data.assign(data, data + size);
+            m_write_handler = std::move(handler);
+            return;
+        }
         m_buffer.insert(m_buffer.end(), data, data + size);
         do_read();
         handler(std::error_code{}, size);
     }
 
+    bool write_in_progress() const noexcept
+    {
+        return bool(m_write_handler);
+    }
+
+    void complete_write()
+    {
+        REALM_ASSERT(m_write_handler);
+        auto handler = std::move(m_write_handler);
+        m_write_handler = nullptr;
+        m_buffer.insert(m_buffer.end(), m_write_data.begin(), m_write_data.end());
+        do_read();
+        handler(std::error_code{}, m_write_data.size());
+    }
+
     void async_read(char* buffer, size_t size, ReadCompletionHandler handler)
     {
         m_logger_ptr->trace(util::LogCategory::network, "async_read, size = %1", size);
@@ -59,6 +90,9 @@ private:
     const std::shared_ptr<util::Logger> m_logger_ptr;
     std::vector<char> m_buffer;
 
+    std::vector<char> m_write_data;
+    WriteCompletionHandler m_write_handler;
+
     bool m_reader_waiting = false;
 
     // discriminates between the two async_read_* functions.
@@ -278,7 +312,8 @@ public:
     WSConfig config_1, config_2;
     websocket::Socket socket_1, socket_2;
 
-    Fixture(const std::shared_ptr<util::Logger>& logger)
+    Fixture(const std::shared_ptr<util::Logger>& logger, const websocket::Options& options_1 = {},
+            const websocket::Options& options_2 = {})
         : m_prefix_logger_1{std::make_shared<util::PrefixLogger>("Socket_1: ", logger)}
         , m_prefix_logger_2{std::make_shared<util::PrefixLogger>("Socket_2: ", logger)}
         , m_prefix_logger_3{std::make_shared<util::PrefixLogger>("Pipe_1: ", logger)}
@@ -287,8 +322,8 @@ public:
         , pipe_2(m_prefix_logger_4)
         , config_1(pipe_1, pipe_2, m_prefix_logger_1)
         , config_2(pipe_2, pipe_1, m_prefix_logger_2)
-        , socket_1(config_1)
-        , socket_2(config_2)
+        , socket_1(config_1, options_1)
+        , socket_2(config_2, options_2)
     {
     }
 };
@@ -476,3 +511,225 @@ TEST(WebSocket_Interleaved_Fragmented_Messages)
     CHECK_EQUAL(config_2.binary_messages.size(), 1);
     CHECK_EQUAL(config_2.binary_messages[0], "abcd");
 }
+
+
+TEST(WebSocket_PerMessageDeflate)
+{
+    websocket::Options options;
+    options.permessage_deflate = true;
+
+    auto handler_no_op = [=](std::error_code, size_t) {};
+    std::string text = "Some text which is repeated in every message. ";
+    for (int i = 0; i < 5; ++i)
+        text += text;
+
+    for (bool context_takeover : {true, false}) {
+        options.deflate_context_takeover = context_takeover;
+        Fixture fixt{test_context.logger, options, options};
+        fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+        fixt.socket_2.initiate_server_handshake();
+        CHECK_EQUAL(fixt.config_1.n_handshake_completed, 1);
+        CHECK_EQUAL(fixt.config_2.n_handshake_completed, 1);
+
+        // Compressed in both directions, and much smaller on the wire
+        size_t bytes_before = fixt.pipe_2.num_bytes_written;
+        for (int i = 0; i < 3; ++i) {
+            fixt.socket_1.async_write_binary(text.data(), text.size(), handler_no_op);
+            fixt.socket_1.async_write_text(text.data(), text.size(), handler_no_op);
+        }
+        size_t bytes_written = fixt.pipe_2.num_bytes_written - bytes_before;
+        CHECK_LESS(bytes_written, text.size());
+        bytes_before = fixt.pipe_1.num_bytes_written;
+        fixt.socket_2.async_write_binary(text.data(), text.size(), handler_no_op);
+        CHECK_LESS(fixt.pipe_1.num_bytes_written - bytes_before, text.size() / 4);
+
+        CHECK_EQUAL(fixt.config_2.binary_messages.size(), 3);
+        CHECK_EQUAL(fixt.config_2.text_messages.size(), 3);
+        for (int i = 0; i < 3; ++i) {
+            CHECK_EQUAL(fixt.config_2.binary_messages[i], text);
+            CHECK_EQUAL(fixt.config_2.text_messages[i], text);
+        }
+        CHECK_EQUAL(fixt.config_1.binary_messages.size(), 1);
+        CHECK_EQUAL(fixt.config_1.binary_messages[0], text);
+
+        // Small messages, control frames and fragmented messages are sent
+        // uncompressed
+        fixt.socket_1.async_write_binary("small", 5, handler_no_op);
+        fixt.socket_1.async_write_binary("", 0, handler_no_op);
+        fixt.socket_1.async_write_ping("ping", 4, handler_no_op);
+        fixt.socket_1.async_write_frame(false, websocket::Opcode::binary, text.data(), 10, handler_no_op);
+        fixt.socket_1.async_write_frame(true, websocket::Opcode::continuation, text.data() + 10, text.size() - 10,
+                                        handler_no_op);
+        CHECK_EQUAL(fixt.config_2.binary_messages.size(), 6);
+        CHECK_EQUAL(fixt.config_2.binary_messages[3], "small");
+        CHECK_EQUAL(fixt.config_2.binary_messages[4], "");
+        CHECK_EQUAL(fixt.config_2.binary_messages[5], text);
+        CHECK_EQUAL(fixt.config_2.ping_messages.size(), 1);
+
+        // Compression picks up after an uncompressed message
+        fixt.socket_1.async_write_binary(text.data(), text.size(), handler_no_op);
+        CHECK_EQUAL(fixt.config_2.binary_messages.size(), 7);
+        CHECK_EQUAL(fixt.config_2.binary_messages[6], text);
+
+        CHECK_EQUAL(fixt.config_1.n_protocol_errors, 0);
+        CHECK_EQUAL(fixt.config_2.n_protocol_errors, 0);
+    }
+
+    // Not used unless both endpoints enable it
+    for (int i = 0; i < 2; ++i) {
+        Fixture fixt{test_context.logger, i == 0 ? options : websocket::Options{},
+                     i == 1 ? options : websocket::Options{}};
+        fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+        fixt.socket_2.initiate_server_handshake();
+        size_t bytes_before = fixt.pipe_2.num_bytes_written;
+        fixt.socket_1.async_write_binary(text.data(), text.size(), handler_no_op);
+        CHECK_GREATER(fixt.pipe_2.num_bytes_written - bytes_before, text.size());
+        CHECK_EQUAL(fixt.config_2.binary_messages.size(), 1);
+        CHECK_EQUAL(fixt.config_2.binary_messages[0], text);
+    }
+}
+
+TEST(WebSocket_PerMessageDeflate_MaxInflatedMessageSize)
+{
+    websocket::Options options;
+    options.permessage_deflate = true;
+    websocket::Options limited_options = options;
+    limited_options.max_inflated_message_size = 64 * 1024;
+
+    auto handler_no_op = [=](std::error_code, size_t) {};
+    Fixture fixt{test_context.logger, options, limited_options};
+    fixt.socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    fixt.socket_2.initiate_server_handshake();
+    CHECK_EQUAL(fixt.config_2.n_handshake_completed, 1);
+
+    std::string message(64 * 1024, 'x');
+    fixt.socket_1.async_write_binary(message.data(), message.size(), handler_no_op);
+    CHECK_EQUAL(fixt.config_2.binary_messages.size(), 1);
+    CHECK_EQUAL(fixt.config_2.n_protocol_errors, 0);
+
+    // A small frame which inflates beyond the limit is a protocol error
+    std::string oversized(16 * 1024 * 1024, 'x');
+    size_t bytes_before = fixt.pipe_2.num_bytes_written;
+    fixt.socket_1.async_write_binary(oversized.data(), oversized.size(), handler_no_op);
+    CHECK_LESS(fixt.pipe_2.num_bytes_written - bytes_before, oversized.size() / 100);
+    CHECK_EQUAL(fixt.config_2.binary_messages.size(), 1);
+    CHECK_EQUAL(fixt.config_2.n_protocol_errors, 1);
+}
+
+TEST(WebSocket_PerMessageDeflate_Negotiation)
+{
+    websocket::Options options;
+    options.permessage_deflate = true;
+
+    auto negotiate = [&](const char* offer) -> std::string {
+        HTTPRequest request;
+        request.headers["Upgrade"] = "websocket";
+        request.headers["Connection"] = "Upgrade";
+        request.headers["Sec-WebSocket-Version"] = "13";
+        request.headers["Sec-WebSocket-Key"] = "dGhlIHNhbXBsZSBub25jZQ==";
+        if (offer)
+            request.headers["Sec-WebSocket-Extensions"] = offer;
+        std::error_code ec;
+        util::Optional<HTTPResponse> response = websocket::make_http_response(request, "protocol", options, ec);
+        CHECK(response);
+        CHECK_NOT(ec);
+        auto i = response->headers.find("Sec-WebSocket-Extensions");
+        return i == response->headers.end() ? "none" : i->second;
+    };
+
+    CHECK_EQUAL(negotiate(nullptr), "none");
+    CHECK_EQUAL(negotiate("x-webkit-deflate-frame"), "none");
+    CHECK_EQUAL(negotiate("permessage-deflate"), "permessage-deflate");
+    CHECK_EQUAL(negotiate("permessage-deflate; client_max_window_bits"), "permessage-deflate");
+    CHECK_EQUAL(negotiate("permessage-deflate; client_max_window_bits=10"), "permessage-deflate");
+    CHECK_EQUAL(negotiate("permessage-deflate;server_no_context_takeover ; server_max_window_bits=\"10\""),
+                "permessage-deflate; server_no_context_takeover; server_max_window_bits=10");
+    CHECK_EQUAL(negotiate("permessage-deflate; client_no_context_takeover"),
+                "permessage-deflate; client_no_context_takeover");
+
+    // Offers which cannot be accepted are skipped
+    CHECK_EQUAL(negotiate("permessage-deflate; server_max_window_bits=8, permessage-deflate"),
+                "permessage-deflate");
+    CHECK_EQUAL(negotiate("permessage-deflate; server_max_window_bits=16"), "none");
+    CHECK_EQUAL(negotiate("permessage-deflate; server_no_context_takeover; server_no_context_takeover"), "none");
+    CHECK_EQUAL(negotiate("permessage-deflate; unknown_parameter"), "none");
+    CHECK_EQUAL(negotiate("permessage-deflate; client_no_context_takeover=1"), "none");
+
+    options.deflate_context_takeover = false;
+    CHECK_EQUAL(negotiate("permessage-deflate"),
+                "permessage-deflate; client_no_context_takeover; server_no_context_takeover");
+
+    options.permessage_deflate = false;
+    CHECK_EQUAL(negotiate("permessage-deflate"), "none");
+}
+
+TEST(WebSocket_CoalescedWrites)
+{
+    websocket::Options options;
+    options.coalesce_writes = true;
+    options.max_coalesced_write_size = 1000;
+    Fixture fixt{test_context.logger, options};
+    WSConfig& config_2 = fixt.config_2;
+    websocket::Socket& socket_1 = fixt.socket_1;
+
+    socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    fixt.socket_2.initiate_server_handshake();
+    CHECK_EQUAL(fixt.config_1.n_handshake_completed, 1);
+    CHECK_EQUAL(config_2.n_handshake_completed, 1);
+
+    Pipe& pipe = fixt.pipe_2;
+    pipe.defer_writes = true;
+    size_t writes_before = pipe.num_writes;
+
+    // A sender which waits for each frame to complete before sending the next
+    // one has its handlers called before the frames are written, as long as
+    // the queue is small, and the frames are then written together.
+    int num_completed = 0;
+    std::function<void(int)> send = [&](int i) {
+        std::string message = "message " + std::to_string(i);
+        socket_1.async_write_binary(message.data(), message.size(), [&, i](std::error_code ec, size_t) {
+            CHECK_NOT(ec);
+            ++num_completed;
+            if (i < 5)
+                send(i + 1);
+        });
+    };
+    send(0);
+    CHECK_EQUAL(pipe.num_writes, writes_before + 1);
+    CHECK_EQUAL(num_completed, 0);
+    pipe.complete_write();
+    CHECK_EQUAL(config_2.binary_messages.size(), 1);
+    CHECK_EQUAL(num_completed, 6);
+    CHECK_EQUAL(pipe.num_writes, writes_before + 2);
+    pipe.complete_write();
+    CHECK_EQUAL(config_2.binary_messages.size(), 6);
+    for (int i = 0; i < 6; ++i)
+        CHECK_EQUAL(config_2.binary_messages[i], "message " + std::to_string(i));
+    CHECK_NOT(pipe.write_in_progress());
+
+    // Frames sent while a write is in progress are written together, but their
+    // handlers are not called before that once the queue exceeds the limit.
+    auto handler_no_op = [=](std::error_code, size_t) {};
+    writes_before = pipe.num_writes;
+    std::string large(600, 'x');
+    socket_1.async_write_ping("ping", 4, handler_no_op);
+    int num_large_completed = 0;
+    auto send_large = [&] {
+        socket_1.async_write_binary(large.data(), large.size(), [&](std::error_code, size_t) {
+            ++num_large_completed;
+        });
+    };
+    send_large();
+    send_large();
+    socket_1.async_write_pong("pong", 4, handler_no_op);
+    CHECK_EQUAL(pipe.num_writes, writes_before + 1);
+    pipe.complete_write();
+    CHECK_EQUAL(config_2.ping_messages.size(), 1);
+    CHECK_EQUAL(pipe.num_writes, writes_before + 2);
+    CHECK_EQUAL(num_large_completed, 0);
+    pipe.complete_write();
+    CHECK_EQUAL(num_large_completed, 2);
+    CHECK_EQUAL(config_2.binary_messages.size(), 8);
+    CHECK_EQUAL(config_2.pong_messages.size(), 1);
+    CHECK_NOT(pipe.write_in_progress());
+}
@@ -0,0 +1,91 @@
+#[=======================================================================[.rst:
+FindZstd
+--------
+
+Find the Zstandard (zstd) compression library.
+
+Imported Targets
+^^^^^^^^^^^^^^^^
+
+An :ref:`imported target <Imported targets>` named
+``Zstd::Zstd`` is provided if zstd has been found.
+
+Result Variables
+^^^^^^^^^^^^^^^^
+
+This module defines the following variables:
+
+``Zstd_FOUND``
+  True if zstd was found, false otherwise.
+``Zstd_INCLUDE_DIRS``
+  Include directories needed to include zstd headers.
+``Zstd_LIBRARIES``
+  Libraries needed to link to zstd.
+``Zstd_VERSION``
+  The version of zstd found.
+
+Cache Variables
+^^^^^^^^^^^^^^^
+
+This module uses the following cache variables:
+
+``Zstd_LIBRARY``
+  The location of the zstd library file.
+``Zstd_INCLUDE_DIR``
+  The location of the zstd include directory containing ``zstd.h``.
+
+The cache variables should not be used by project code.
+They may be set by end users to point at zstd components.
+#]=======================================================================]
+
+#-----------------------------------------------------------------------------
+find_library(Zstd_LIBRARY
+  NAMES zstd zstd_static libzstd
+  )
+mark_as_advanced(Zstd_LIBRARY)
+
+find_path(Zstd_INCLUDE_DIR
+  NAMES zstd.h
+  )
+mark_as_advanced(Zstd_INCLUDE_DIR)
+
+#-----------------------------------------------------------------------------
+# Extract version number if possible.
+set(Zstd_VERSION "")
+if(Zstd_INCLUDE_DIR AND EXISTS "${Zstd_INCLUDE_DIR}/zstd.h")
+  file(STRINGS "${Zstd_INCLUDE_DIR}/zstd.h" _Zstd_H REGEX "#[ \t]*define[ \t]+ZSTD_VERSION_(MAJOR|MINOR|RELEASE)[ \t]+[0-9]+")
+  foreach(c MAJOR MINOR RELEASE)
+    if(_Zstd_H MATCHES "#[ \t]*define[ \t]+ZSTD_VERSION_${c}[ \t]+([0-9]+)")
+      set(_Zstd_VERSION_${c} "${CMAKE_MATCH_1}")
+    endif()
+  endforeach()
+  if(DEFINED _Zstd_VERSION_MAJOR AND DEFINED _Zstd_VERSION_MINOR AND DEFINED _Zstd_VERSION_RELEASE)
+    set(Zstd_VERSION "${_Zstd_VERSION_MAJOR}.${_Zstd_VERSION_MINOR}.${_Zstd_VERSION_RELEASE}")
+  endif()
+  unset(_Zstd_VERSION_MAJOR)
+  unset(_Zstd_VERSION_MINOR)
+  unset(_Zstd_VERSION_RELEASE)
+  unset(_Zstd_H)
+endif()
+
+#-----------------------------------------------------------------------------
+include(FindPackageHandleStandardArgs)
+FIND_PACKAGE_HANDLE_STANDARD_ARGS(Zstd
+  FOUND_VAR Zstd_FOUND
+  REQUIRED_VARS Zstd_LIBRARY Zstd_INCLUDE_DIR
+  VERSION_VAR Zstd_VERSION
+  )
+
+#-----------------------------------------------------------------------------
+# Provide documented result variables and targets.
+if(Zstd_FOUND)
+  set(Zstd_INCLUDE_DIRS ${Zstd_INCLUDE_DIR})
+  set(Zstd_LIBRARIES ${Zstd_LIBRARY})
+  if(NOT TARGET Zstd::Zstd)
+    add_library(Zstd::Zstd UNKNOWN IMPORTED)
+    set_target_properties(Zstd::Zstd PROPERTIES
+      IMPORTED_LOCATION "${Zstd_LIBRARY}"
+      INTERFACE_INCLUDE_DIRECTORIES "${Zstd_INCLUDE_DIRS}"
+      )
+  endif()
+endif()